@@ -8,6 +8,7 @@
 
 #include "network/EventServer.h"
 #include "network/Network.h"
+#include "threads/LockProfiler.h"
 #include "threads/SystemClock.h"
 #include "Application.h"
 #include "AppInboundProtocol.h"
@@ -15,6 +16,7 @@
 #include "events/EventLog.h"
 #include "events/NotificationEvent.h"
 #include "interfaces/builtins/Builtins.h"
+#include "utils/BootTimeline.h"
 #include "utils/JobManager.h"
 #include "utils/Variant.h"
 #include "LangInfo.h"
@@ -353,6 +355,8 @@ bool CApplication::Create(const CAppParamParser &params)
   // Grab a handle to our thread to be used later in identifying the render thread.
   m_threadID = CThread::GetCurrentThreadId();
 
+  CBootTimeline::GetInstance().AddMilestone("start");
+
   // Announement service
   m_pAnnouncementManager = std::make_shared<ANNOUNCEMENT::CAnnouncementManager>();
   m_pAnnouncementManager->Start();
@@ -360,9 +364,12 @@ bool CApplication::Create(const CAppParamParser &params)
 
   m_ServiceManager.reset(new CServiceManager());
 
-  if (!m_ServiceManager->InitStageOne())
   {
-    return false;
+    CBootTimeline::CScope scope("InitStageOne");
+    if (!m_ServiceManager->InitStageOne())
+    {
+      return false;
+    }
   }
 
   Preflight();
@@ -421,8 +428,11 @@ bool CApplication::Create(const CAppParamParser &params)
   // Init our DllLoaders emu env
   init_emu_environ();
 
-  if (!m_ServiceManager->InitStageOnePointFive())
-    return false;
+  {
+    CBootTimeline::CScope scope("InitStageOnePointFive");
+    if (!m_ServiceManager->InitStageOnePointFive())
+      return false;
+  }
 
   CSpecialProtocol::RegisterProfileManager(m_ServiceManager->GetProfileManager());
 
@@ -523,16 +533,19 @@ bool CApplication::Create(const CAppParamParser &params)
 
   // Initialize default Settings - don't move
   CLog::Log(LOGNOTICE, "load settings...");
-  if (!m_ServiceManager->GetSettings().Initialize())
-    return false;
-
-  // load the actual values
-  if (!m_ServiceManager->GetSettings().Load())
   {
-    CLog::Log(LOGFATAL, "unable to load settings");
-    return false;
+    CBootTimeline::CScope scope("settings");
+    if (!m_ServiceManager->GetSettings().Initialize())
+      return false;
+
+    // load the actual values
+    if (!m_ServiceManager->GetSettings().Load())
+    {
+      CLog::Log(LOGFATAL, "unable to load settings");
+      return false;
+    }
+    m_ServiceManager->GetSettings().SetLoaded();
   }
-  m_ServiceManager->GetSettings().SetLoaded();
 
   CLog::Log(LOGINFO, "creating subdirectories");
   CLog::Log(LOGINFO, "userdata folder: %s", CURL::GetRedacted(m_ServiceManager->GetProfileManager().GetProfileUserDataFolder()).c_str());
@@ -556,14 +569,20 @@ bool CApplication::Create(const CAppParamParser &params)
   m_pWinSystem = CWinSystemBase::CreateWinSystem();
   CServiceBroker::RegisterWinSystem(m_pWinSystem.get());
 
-  if (!m_ServiceManager->InitStageTwo(params))
   {
-    return false;
+    CBootTimeline::CScope scope("InitStageTwo");
+    if (!m_ServiceManager->InitStageTwo(params))
+    {
+      return false;
+    }
   }
 
-  m_pActiveAE.reset(new ActiveAE::CActiveAE());
-  m_pActiveAE->Start();
-  CServiceBroker::RegisterAE(m_pActiveAE.get());
+  {
+    CBootTimeline::CScope scope("audioengine");
+    m_pActiveAE.reset(new ActiveAE::CActiveAE());
+    m_pActiveAE->Start();
+    CServiceBroker::RegisterAE(m_pActiveAE.get());
+  }
 
   // restore AE's previous volume state
   SetHardwareVolume(m_volumeLevel);
@@ -983,8 +1002,11 @@ bool CApplication::Initialize()
   }
 
   // load the language and its translated strings
-  if (!LoadLanguage(false))
-    return false;
+  {
+    CBootTimeline::CScope scope("language");
+    if (!LoadLanguage(false))
+      return false;
+  }
 
   m_ServiceManager->GetEventLog().Add(EventPtr(new CNotificationEvent(
     StringUtils::Format(g_localizeStrings.Get(177).c_str(), g_sysinfo.GetAppName().c_str()),
@@ -998,6 +1020,7 @@ bool CApplication::Initialize()
 
   CEvent event(true);
   CJobManager::GetInstance().Submit([&databaseManager, &event]() {
+    CBootTimeline::CScope scope("databases");
     databaseManager.Initialize();
     event.Set();
   });
@@ -1057,6 +1080,7 @@ bool CApplication::Initialize()
     m_confirmSkinChange = true;
 
     std::string defaultSkin = std::static_pointer_cast<const CSettingString>(m_ServiceManager->GetSettings().GetSetting(CSettings::SETTING_LOOKANDFEEL_SKIN))->GetDefault();
+    CBootTimeline::GetInstance().AddMilestone("loading skin");
     if (!LoadSkin(m_ServiceManager->GetSettings().GetString(CSettings::SETTING_LOOKANDFEEL_SKIN)))
     {
       CLog::Log(LOGERROR, "Failed to load skin '%s'", m_ServiceManager->GetSettings().GetString(CSettings::SETTING_LOOKANDFEEL_SKIN).c_str());
@@ -1066,6 +1090,7 @@ bool CApplication::Initialize()
         return false;
       }
     }
+    CBootTimeline::GetInstance().AddMilestone("skin loaded");
 
     // initialize splash window after splash screen disappears
     // because we need a real window in the background which gets
@@ -1106,9 +1131,12 @@ bool CApplication::Initialize()
 
   CJSONRPC::Initialize();
 
-  if (!m_ServiceManager->InitStageThree())
   {
-    CLog::Log(LOGERROR, "Application - Init3 failed");
+    CBootTimeline::CScope scope("InitStageThree");
+    if (!m_ServiceManager->InitStageThree())
+    {
+      CLog::Log(LOGERROR, "Application - Init3 failed");
+    }
   }
 
   g_sysinfo.Refresh();
@@ -1133,6 +1161,7 @@ bool CApplication::Initialize()
     CServiceBroker::GetServiceAddons().Start();
 
   CLog::Log(LOGNOTICE, "initialize done");
+  CBootTimeline::GetInstance().AddMilestone("initialize done");
 
   // reset our screensaver (starts timers etc.)
   ResetScreenSaver();
@@ -1827,6 +1856,12 @@ void CApplication::Render()
 
   CServiceBroker::GetWinSystem()->GetGfxContext().Flip(hasRendered, m_appPlayer.IsRenderingVideoLayer());
 
+  if (hasRendered && !CBootTimeline::GetInstance().IsFinished())
+  {
+    CBootTimeline::GetInstance().AddMilestone("first frame");
+    CBootTimeline::GetInstance().Finish();
+  }
+
   CTimeUtils::UpdateFrameTime(hasRendered);
 }
 
@@ -2878,6 +2913,9 @@ void CApplication::Stop(int exitCode)
     m_pActiveAE->Shutdown();
     m_pActiveAE.reset();
 
+    if (CLockProfiler::IsEnabled())
+      CLockProfiler::GetInstance().LogStatistics(20);
+
     CLog::Log(LOGNOTICE, "stopped");
   }
   catch (...)
@@ -7,15 +7,20 @@
  */
 
 #include "DatabaseManager.h"
+#include "ServiceBroker.h"
 #include "utils/log.h"
 #include "addons/AddonDatabase.h"
 #include "view/ViewDatabase.h"
+#include "pictures/PictureDatabase.h"
 #include "TextureDatabase.h"
 #include "music/MusicDatabase.h"
 #include "video/VideoDatabase.h"
 #include "pvr/PVRDatabase.h"
 #include "pvr/epg/EpgDatabase.h"
+#include "playlists/SmartPlaylistCache.h"
 #include "settings/AdvancedSettings.h"
+#include "dbwrappers/DatabaseStatementStats.h"
+#include "dbwrappers/sqlitedataset.h"
 
 using namespace PVR;
 
@@ -27,7 +32,11 @@ CDatabaseManager::CDatabaseManager() :
   UpdateDatabase(db);
 }
 
-CDatabaseManager::~CDatabaseManager() = default;
+CDatabaseManager::~CDatabaseManager()
+{
+  CDatabaseStatementStats::GetInstance().LogSummary(20);
+  dbiplus::SqliteDatabase::closePooledConnections();
+}
 
 void CDatabaseManager::Initialize()
 {
@@ -35,12 +44,21 @@ void CDatabaseManager::Initialize()
 
   m_dbStatus.clear();
 
+  // connections may belong to a different profile
+  dbiplus::SqliteDatabase::closePooledConnections();
+  CDatabaseStatementStats::GetInstance().SetSlowThreshold(g_advancedSettings.m_databaseSlowQueryMs);
+
+  // as may the cached smart playlists
+  if (CServiceBroker::IsServiceManagerUp())
+    CServiceBroker::GetSmartPlaylistCache().Clear();
+
   CLog::Log(LOGDEBUG, "%s, updating databases...", __FUNCTION__);
 
   // NOTE: Order here is important. In particular, CTextureDatabase has to be updated
   //       before CVideoDatabase.
   { CAddonDatabase db; UpdateDatabase(db); }
   { CViewDatabase db; UpdateDatabase(db); }
+  { CPictureDatabase db; UpdateDatabase(db); }
   { CTextureDatabase db; UpdateDatabase(db); }
   { CMusicDatabase db; UpdateDatabase(db, &g_advancedSettings.m_databaseMusic); }
   { CVideoDatabase db; UpdateDatabase(db, &g_advancedSettings.m_databaseVideo); }
@@ -2141,7 +2141,8 @@ const infomap player_process[] =
   { "audiodecoder", PLAYER_PROCESS_AUDIODECODER },
   { "audiochannels", PLAYER_PROCESS_AUDIOCHANNELS },
   { "audiosamplerate", PLAYER_PROCESS_AUDIOSAMPLERATE },
-  { "audiobitspersample", PLAYER_PROCESS_AUDIOBITSPERSAMPLE }
+  { "audiobitspersample", PLAYER_PROCESS_AUDIOBITSPERSAMPLE },
+  { "audiopreparetime", PLAYER_PROCESS_AUDIOPREPARETIME }
 };
 
 /// \page modules__General__List_of_gui_access
@@ -6861,6 +6862,36 @@ int CGUIInfoManager::AddMultiInfo(const CGUIInfo &info)
   return id;
 }
 
+bool CGUIInfoManager::IsListItemStatic(int condition) const
+{
+  condition = std::abs(condition);
+  if (condition < MULTI_INFO_START || condition > MULTI_INFO_END)
+    return false;
+
+  const CGUIInfo &info = m_multiInfo[condition - MULTI_INFO_START];
+  switch (info.m_info)
+  {
+    // flags, labels, art and properties are only changed through the item, which invalidates it
+    case LISTITEM_ISSELECTED:
+    case LISTITEM_IS_FOLDER:
+    case LISTITEM_IS_PARENTFOLDER:
+    case LISTITEM_LABEL:
+    case LISTITEM_LABEL2:
+    case LISTITEM_ICON:
+    case LISTITEM_ACTUAL_ICON:
+    case LISTITEM_THUMB:
+    case LISTITEM_ART:
+    case LISTITEM_PROPERTY:
+      return true;
+    case STRING_IS_EMPTY:
+      return IsListItemStatic(info.GetData1());
+    case STRING_IS_EQUAL:
+      return IsListItemStatic(info.GetData1()) && (info.GetData2() >= 0 || IsListItemStatic(-info.GetData2()));
+    default:
+      return false;
+  }
+}
+
 bool CGUIInfoManager::IsListItemInfo(int info) const
 {
   int iResolvedInfo = info;
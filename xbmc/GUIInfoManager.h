@@ -92,6 +92,13 @@ public:
   int TranslateString(const std::string &strCondition);
   int TranslateSingleString(const std::string &strCondition, bool &listItemDependent);
 
+  /*! \brief Check whether a translated condition only depends on the listitem's own data
+   The value of such a condition only changes when the listitem is invalidated.
+   \param condition the translated condition
+   \return true if the value of the condition may be cached on the listitem
+   */
+  bool IsListItemStatic(int condition) const;
+
   std::string GetLabel(int info, int contextWindow = 0, std::string *fallback = nullptr) const;
   std::string GetImage(int info, int contextWindow, std::string *fallback = nullptr);
   bool GetInt(int &value, int info, int contextWindow = 0, const CGUIListItem *item = nullptr) const;
@@ -174,6 +174,11 @@ CWeatherManager& CServiceBroker::GetWeatherManager()
   return g_application.m_ServiceManager->GetWeatherManager();
 }
 
+CSmartPlaylistCache& CServiceBroker::GetSmartPlaylistCache()
+{
+  return g_application.m_ServiceManager->GetSmartPlaylistCache();
+}
+
 CPlayerCoreFactory& CServiceBroker::GetPlayerCoreFactory()
 {
   return g_application.m_ServiceManager->GetPlayerCoreFactory();
@@ -47,6 +47,7 @@ class CWinSystemBase;
 class CRenderSystemBase;
 class CPowerManager;
 class CWeatherManager;
+class CSmartPlaylistCache;
 class CPlayerCoreFactory;
 class CDatabaseManager;
 class CProfilesManager;
@@ -104,6 +105,7 @@ public:
   static CNetworkBase& GetNetwork();
   static CPowerManager& GetPowerManager();
   static CWeatherManager& GetWeatherManager();
+  static CSmartPlaylistCache& GetSmartPlaylistCache();
   static CPlayerCoreFactory &GetPlayerCoreFactory();
   static CDatabaseManager &GetDatabaseManager();
   static CProfilesManager &GetProfileManager();
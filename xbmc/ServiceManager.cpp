@@ -27,15 +27,29 @@
 #include "interfaces/python/XBPython.h"
 #include "pvr/PVRManager.h"
 #include "network/Network.h"
+#include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
+#include "utils/BootTimeline.h"
 #include "utils/FileExtensionProvider.h"
+#include "utils/TaskGraph.h"
 #include "windowing/WinSystem.h"
 #include "powermanagement/PowerManager.h"
 #include "weather/WeatherManager.h"
+#include "playlists/SmartPlaylistCache.h"
 #include "DatabaseManager.h"
 
 using namespace KODI;
 
+namespace
+{
+// records the time spent in a startup task in the boot timeline
+bool RunTimedTask(const std::string &name, const CTaskGraph::Task &task)
+{
+  CBootTimeline::CScope scope(name);
+  return task();
+}
+}
+
 CServiceManager::CServiceManager()
 {
 }
@@ -122,61 +136,144 @@ bool CServiceManager::InitStageOnePointFive()
 
 bool CServiceManager::InitStageTwo(const CAppParamParser &params)
 {
-  // Initialize the addon database (must be before the addon manager is init'd)
-  m_databaseManager.reset(new CDatabaseManager);
+  // services are initialized concurrently as far as their dependencies allow. Tasks
+  // marked with true run on the main thread, which includes all tasks registering
+  // setting callbacks, announcers or addon event handlers. Settings and the profile
+  // manager are set up by the earlier stages and can be used by any task.
+  CTaskGraph graph("InitStageTwo", RunTimedTask);
+
+  if (!graph.Add("databasemanager", {}, [this]() {
+    // Initialize the addon database (must be before the addon manager is init'd)
+    m_databaseManager.reset(new CDatabaseManager);
+    return true;
+  }))
+    return false;
 
-  m_Platform.reset(CPlatform::CreateInstance());
-  m_Platform->Init();
+  if (!graph.Add("platform", {}, [this]() {
+    m_Platform.reset(CPlatform::CreateInstance());
+    m_Platform->Init();
+    return true;
+  }, true))
+    return false;
 
-  m_binaryAddonManager.reset(new ADDON::CBinaryAddonManager()); /* Need to constructed before, GetRunningInstance() of binary CAddonDll need to call them */
-  m_addonMgr.reset(new ADDON::CAddonMgr());
-  if (!m_addonMgr->Init())
-  {
-    CLog::Log(LOGFATAL, "CServiceManager::%s: Unable to start CAddonMgr", __FUNCTION__);
+  if (!graph.Add("addonmanager", {"databasemanager"}, [this]() {
+    m_binaryAddonManager.reset(new ADDON::CBinaryAddonManager()); /* Need to constructed before, GetRunningInstance() of binary CAddonDll need to call them */
+    m_addonMgr.reset(new ADDON::CAddonMgr());
+    if (!m_addonMgr->Init())
+    {
+      CLog::Log(LOGFATAL, "CServiceManager::InitStageTwo: Unable to start CAddonMgr");
+      return false;
+    }
+
+    if (!m_binaryAddonManager->Init())
+    {
+      CLog::Log(LOGFATAL, "CServiceManager::InitStageTwo: Unable to initialize CBinaryAddonManager");
+      return false;
+    }
+    return true;
+  }))
     return false;
-  }
 
-  if (!m_binaryAddonManager->Init())
-  {
-    CLog::Log(LOGFATAL, "CServiceManager::%s: Unable to initialize CBinaryAddonManager", __FUNCTION__);
+  if (!graph.Add("repositoryupdater", {"addonmanager"}, [this]() {
+    m_repositoryUpdater.reset(new ADDON::CRepositoryUpdater(*m_addonMgr));
+    return true;
+  }, true))
     return false;
-  }
 
-  m_repositoryUpdater.reset(new ADDON::CRepositoryUpdater(*m_addonMgr));
+  if (!graph.Add("vfsaddoncache", {"addonmanager"}, [this]() {
+    m_vfsAddonCache.reset(new ADDON::CVFSAddonCache());
+    m_vfsAddonCache->Init();
+    return true;
+  }, true))
+    return false;
 
-  m_vfsAddonCache.reset(new ADDON::CVFSAddonCache());
-  m_vfsAddonCache->Init();
+  if (!graph.Add("pvrmanager", {"addonmanager"}, [this]() {
+    m_PVRManager.reset(new PVR::CPVRManager());
+    return true;
+  }, true))
+    return false;
 
-  m_PVRManager.reset(new PVR::CPVRManager());
+  if (!graph.Add("datacachecore", {}, [this]() {
+    m_dataCacheCore.reset(new CDataCacheCore());
+    return true;
+  }))
+    return false;
 
-  m_dataCacheCore.reset(new CDataCacheCore());
+  if (!graph.Add("binaryaddoncache", {"addonmanager"}, [this]() {
+    m_binaryAddonCache.reset( new ADDON::CBinaryAddonCache());
+    m_binaryAddonCache->Init();
+    return true;
+  }, true))
+    return false;
 
-  m_binaryAddonCache.reset( new ADDON::CBinaryAddonCache());
-  m_binaryAddonCache->Init();
+  if (!graph.Add("favouritesservice", {}, [this]() {
+    m_favouritesService.reset(new CFavouritesService(m_profileManager->GetProfileUserDataFolder()));
+    return true;
+  }))
+    return false;
 
-  m_favouritesService.reset(new CFavouritesService(m_profileManager->GetProfileUserDataFolder()));
+  if (!graph.Add("serviceaddons", {"addonmanager"}, [this]() {
+    m_serviceAddons.reset(new ADDON::CServiceAddonManager(*m_addonMgr));
+    return true;
+  }, true))
+    return false;
 
-  m_serviceAddons.reset(new ADDON::CServiceAddonManager(*m_addonMgr));
+  if (!graph.Add("contextmenumanager", {"addonmanager"}, [this]() {
+    m_contextMenuManager.reset(new CContextMenuManager(*m_addonMgr.get()));
+    return true;
+  }, true))
+    return false;
 
-  m_contextMenuManager.reset(new CContextMenuManager(*m_addonMgr.get()));
+  if (!graph.Add("inputmanager", {}, [this, &params]() {
+    m_gameControllerManager.reset(new GAME::CControllerManager);
+    m_inputManager.reset(new CInputManager(params));
+    m_inputManager->InitializeInputs();
+    return true;
+  }, true))
+    return false;
 
-  m_gameControllerManager.reset(new GAME::CControllerManager);
-  m_inputManager.reset(new CInputManager(params));
-  m_inputManager->InitializeInputs();
+  if (!graph.Add("peripherals", {"inputmanager"}, [this]() {
+    m_peripherals.reset(new PERIPHERALS::CPeripherals(*m_inputManager,
+                                                      *m_gameControllerManager));
+    return true;
+  }, true))
+    return false;
 
-  m_peripherals.reset(new PERIPHERALS::CPeripherals(*m_inputManager,
-                                                    *m_gameControllerManager));
+  if (!graph.Add("gamerendermanager", {}, [this]() {
+    m_gameRenderManager.reset(new RETRO::CGUIGameRenderManager);
+    return true;
+  }))
+    return false;
 
-  m_gameRenderManager.reset(new RETRO::CGUIGameRenderManager);
+  if (!graph.Add("fileextensionprovider", {"addonmanager"}, [this]() {
+    m_fileExtensionProvider.reset(new CFileExtensionProvider(*m_addonMgr,
+                                                             *m_binaryAddonManager));
+    return true;
+  }, true))
+    return false;
 
-  m_fileExtensionProvider.reset(new CFileExtensionProvider(*m_addonMgr,
-                                                           *m_binaryAddonManager));
+  if (!graph.Add("powermanager", {}, [this]() {
+    m_powerManager.reset(new CPowerManager(*m_settings));
+    m_powerManager->Initialize();
+    m_powerManager->SetDefaults();
+    return true;
+  }, true))
+    return false;
+
+  if (!graph.Add("weathermanager", {"addonmanager"}, [this]() {
+    m_weatherManager.reset(new CWeatherManager());
+    return true;
+  }, true))
+    return false;
 
-  m_powerManager.reset(new CPowerManager(*m_settings));
-  m_powerManager->Initialize();
-  m_powerManager->SetDefaults();
+  if (!graph.Add("smartplaylistcache", {}, [this]() {
+    m_smartPlaylistCache.reset(new CSmartPlaylistCache());
+    return true;
+  }, true))
+    return false;
 
-  m_weatherManager.reset(new CWeatherManager());
+  if (!graph.Run(g_advancedSettings.m_startupThreads))
+    return false;
 
   init_level = 2;
   return true;
@@ -185,20 +282,46 @@ bool CServiceManager::InitStageTwo(const CAppParamParser &params)
 // stage 3 is called after successful initialization of WindowManager
 bool CServiceManager::InitStageThree()
 {
+  CTaskGraph graph("InitStageThree", RunTimedTask);
+
   // Peripherals depends on strings being loaded before stage 3
-  m_peripherals->Initialise();
+  if (!graph.Add("peripherals", {}, [this]() {
+    m_peripherals->Initialise();
+    return true;
+  }, true))
+    return false;
+
+  if (!graph.Add("gameservices", {"peripherals"}, [this]() {
+    m_gameServices.reset(new GAME::CGameServices(*m_gameControllerManager,
+      *m_gameRenderManager,
+      *m_settings,
+      *m_peripherals,
+      *m_profileManager));
+    return true;
+  }, true))
+    return false;
 
-  m_gameServices.reset(new GAME::CGameServices(*m_gameControllerManager,
-    *m_gameRenderManager,
-    *m_settings,
-    *m_peripherals,
-    *m_profileManager));
+  if (!graph.Add("contextmenumanager", {}, [this]() {
+    m_contextMenuManager->Init();
+    return true;
+  }, true))
+    return false;
 
-  m_contextMenuManager->Init();
-  m_PVRManager->Init();
+  if (!graph.Add("pvrmanager", {}, [this]() {
+    m_PVRManager->Init();
+    return true;
+  }, true))
+    return false;
 
-  m_playerCoreFactory.reset(new CPlayerCoreFactory(*m_settings,
-                                                   *m_profileManager));
+  if (!graph.Add("playercorefactory", {}, [this]() {
+    m_playerCoreFactory.reset(new CPlayerCoreFactory(*m_settings,
+                                                     *m_profileManager));
+    return true;
+  }, true))
+    return false;
+
+  if (!graph.Run(g_advancedSettings.m_startupThreads))
+    return false;
 
   init_level = 3;
   return true;
@@ -219,6 +342,7 @@ void CServiceManager::DeinitStageTwo()
 {
   init_level = 1;
 
+  m_smartPlaylistCache.reset();
   m_weatherManager.reset();
   m_powerManager.reset();
   m_fileExtensionProvider.reset();
@@ -391,6 +515,11 @@ CWeatherManager& CServiceManager::GetWeatherManager()
   return *m_weatherManager;
 }
 
+CSmartPlaylistCache& CServiceManager::GetSmartPlaylistCache()
+{
+  return *m_smartPlaylistCache;
+}
+
 CPlayerCoreFactory &CServiceManager::GetPlayerCoreFactory()
 {
   return *m_playerCoreFactory;
@@ -43,6 +43,7 @@ class CNetworkBase;
 class CWinSystemBase;
 class CPowerManager;
 class CWeatherManager;
+class CSmartPlaylistCache;
 
 namespace KODI
 {
@@ -119,6 +120,8 @@ public:
 
   CWeatherManager &GetWeatherManager();
 
+  CSmartPlaylistCache &GetSmartPlaylistCache();
+
   CPlayerCoreFactory &GetPlayerCoreFactory();
 
   CDatabaseManager &GetDatabaseManager();
@@ -168,6 +171,7 @@ protected:
   std::unique_ptr<CNetworkBase> m_network;
   std::unique_ptr<CPowerManager> m_powerManager;
   std::unique_ptr<CWeatherManager> m_weatherManager;
+  std::unique_ptr<CSmartPlaylistCache> m_smartPlaylistCache;
   std::unique_ptr<CPlayerCoreFactory> m_playerCoreFactory;
   std::unique_ptr<CDatabaseManager> m_databaseManager;
   std::unique_ptr<CProfilesManager> m_profileManager;
@@ -18,6 +18,7 @@
 #include "utils/StringUtils.h"
 #include "URL.h"
 #include "ServiceBroker.h"
+#include "rendering/RenderSystem.h"
 
 using namespace XFILE;
 
@@ -98,13 +99,24 @@ bool CTextureCache::CanCacheImageURL(const CURL &url)
           StringUtils::StartsWith(url.GetUserName(), "video_");
 }
 
-std::string CTextureCache::CheckCachedImage(const std::string &url, bool &needsRecaching)
+std::string CTextureCache::CheckCachedImage(const std::string &url, bool &needsRecaching, bool returnDDS /* = false */)
 {
   CTextureDetails details;
   std::string path(GetCachedImage(url, details, true));
   needsRecaching = !details.hash.empty();
   if (!path.empty())
+  {
+    // only images in the texture cache get a .dds version
+    if (returnDDS && !details.file.empty() && g_advancedSettings.m_useDDSTextures &&
+        CServiceBroker::GetRenderSystem()->SupportsDXT())
+    {
+      std::string ddsPath = URIUtils::ReplaceExtension(path, ".dds");
+      if (CFile::Exists(ddsPath))
+        return ddsPath;
+      AddJob(new CTextureDDSJob(path));
+    }
     return path;
+  }
   return "";
 }
 
@@ -52,10 +52,12 @@ public:
 
    \param image url of the image to check
    \param needsRecaching [out] whether the image needs recaching.
+   \param returnDDS whether to return the compressed .dds version. It is created in the background
+   if it doesn't exist yet and the render system supports DXT textures.
    \return cached url of this image
    \sa GetCachedImage
    */
-  std::string CheckCachedImage(const std::string &image, bool &needsRecaching);
+  std::string CheckCachedImage(const std::string &image, bool &needsRecaching, bool returnDDS = false);
 
   /*! \brief Cache image (if required) using a background job
 
@@ -135,6 +137,20 @@ public:
    */
   bool AddCachedTexture(const std::string &image, const CTextureDetails &details);
 
+  /*! \brief Get an image from the database
+   Thread-safe wrapper of CTextureDatabase::GetCachedTexture
+   \param image url of the original image
+   \param details [out] texture details from the database (if available)
+   \return true if we have a cached version of this image, false otherwise.
+   */
+  bool GetCachedTexture(const std::string &url, CTextureDetails &details);
+
+  /*! \brief Increment the use count of a texture
+   Stores locally before calling CTextureDatabase::IncrementUseCount via a CUseCountJob
+   \sa CUseCountJob, CTextureDatabase::IncrementUseCount
+   */
+  void IncrementUseCount(const CTextureDetails &details);
+
   /*! \brief Export a (possibly) cached image to a file
    \param image url of the original image
    \param destination url of the destination image, excluding extension.
@@ -165,14 +181,6 @@ private:
    */
   std::string GetCachedImage(const std::string &image, CTextureDetails &details, bool trackUsage = false);
 
-  /*! \brief Get an image from the database
-   Thread-safe wrapper of CTextureDatabase::GetCachedTexture
-   \param image url of the original image
-   \param details [out] texture details from the database (if available)
-   \return true if we have a cached version of this image, false otherwise.
-   */
-  bool GetCachedTexture(const std::string &url, CTextureDetails &details);
-
   /*! \brief Clear an image from the database
    Thread-safe wrapper of CTextureDatabase::ClearCachedTexture
    \param image url of the original image
@@ -182,12 +190,6 @@ private:
   bool ClearCachedTexture(const std::string &url, std::string &cacheFile);
   bool ClearCachedTexture(int textureID, std::string &cacheFile);
 
-  /*! \brief Increment the use count of a texture
-   Stores locally before calling CTextureDatabase::IncrementUseCount via a CUseCountJob
-   \sa CUseCountJob, CTextureDatabase::IncrementUseCount
-   */
-  void IncrementUseCount(const CTextureDetails &details);
-
   /*! \brief Set a previously cached texture as valid in the database
    Thread-safe wrapper of CTextureDatabase::SetCachedTextureValid
    \param image url of the original image
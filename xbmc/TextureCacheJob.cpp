@@ -8,6 +8,7 @@
 
 #include "TextureCacheJob.h"
 #include "TextureCache.h"
+#include "guilib/DDSImage.h"
 #include "guilib/Texture.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
@@ -105,6 +106,12 @@ bool CTextureCacheJob::CacheTexture(CBaseTexture **out_texture)
     {
       m_details.width = width;
       m_details.height = height;
+      if (!m_oldHash.empty())
+      { // the .dds version of the previous image is recreated when the image is next loaded
+        std::string ddsPath = URIUtils::ReplaceExtension(CTextureCache::GetCachedPath(m_details.file), ".dds");
+        if (XFILE::CFile::Exists(ddsPath))
+          XFILE::CFile::Delete(ddsPath);
+      }
       if (out_texture) // caller wants the texture
         *out_texture = texture;
       else
@@ -254,6 +261,47 @@ CTextureUseCountJob::CTextureUseCountJob(const std::vector<CTextureDetails> &tex
 {
 }
 
+CTextureDDSJob::CTextureDDSJob(const std::string &original):
+  m_original(original)
+{
+}
+
+bool CTextureDDSJob::operator==(const CJob* job) const
+{
+  if (strcmp(job->GetType(),GetType()) == 0)
+  {
+    const CTextureDDSJob* ddsJob = dynamic_cast<const CTextureDDSJob*>(job);
+    if (ddsJob && ddsJob->m_original == m_original)
+      return true;
+  }
+  return false;
+}
+
+bool CTextureDDSJob::DoWork()
+{
+  if (URIUtils::HasExtension(m_original, ".dds"))
+    return false;
+
+  CBaseTexture *texture = CBaseTexture::LoadFromFile(m_original, 0, 0, true);
+  if (!texture)
+    return false;
+
+  // write to a temporary file first so the image loader never reads a partial file
+  std::string ddsPath = URIUtils::ReplaceExtension(m_original, ".dds");
+  std::string tempPath = ddsPath + ".tmp";
+  CDDSImage dds;
+  bool success = dds.Create(tempPath, texture->GetWidth(), texture->GetHeight(), texture->GetPitch(), texture->GetPixels(), texture->HasAlpha());
+  delete texture;
+
+  if (success)
+    success = XFILE::CFile::Rename(tempPath, ddsPath);
+  else if (XFILE::CFile::Exists(tempPath))
+    XFILE::CFile::Delete(tempPath);
+
+  CLog::Log(LOGDEBUG, "%s creating compressed version of '%s'", success ? "Succeeded" : "Failed", m_original.c_str());
+  return success;
+}
+
 bool CTextureUseCountJob::operator==(const CJob* job) const
 {
   if (strcmp(job->GetType(),GetType()) == 0)
@@ -230,6 +230,20 @@ int CDataCacheCore::GetAudioBitsPerSample()
   return m_playerAudioInfo.bitsPerSample;
 }
 
+void CDataCacheCore::SetAudioPrepareTime(int ms)
+{
+  CSingleLock lock(m_audioPlayerSection);
+
+  m_playerAudioInfo.prepareTime = ms;
+}
+
+int CDataCacheCore::GetAudioPrepareTime()
+{
+  CSingleLock lock(m_audioPlayerSection);
+
+  return m_playerAudioInfo.prepareTime;
+}
+
 void CDataCacheCore::SetRenderClockSync(bool enable)
 {
   CSingleLock lock(m_renderSection);
@@ -50,6 +50,8 @@ public:
   int GetAudioSampleRate();
   void SetAudioBitsPerSample(int bitsPerSample);
   int GetAudioBitsPerSample();
+  void SetAudioPrepareTime(int ms);
+  int GetAudioPrepareTime();
 
   // render info
   void SetRenderClockSync(bool enabled);
@@ -136,6 +138,7 @@ protected:
     std::string channels;
     int sampleRate;
     int bitsPerSample;
+    int prepareTime;
   } m_playerAudioInfo;
 
   CCriticalSection m_renderSection;
@@ -396,6 +396,16 @@ bool CDVDVideoCodecFFmpeg::Open(CDVDStreamInfo &hints, CDVDCodecOptions &options
     m_pCodecContext->skip_loop_filter = (AVDiscard)g_advancedSettings.m_iSkipLoopFilter;
   }
 
+  // thumbnails only need a single picture, which doesn't have to be perfect
+  if (hints.codecOptions & CODEC_THUMBNAIL)
+  {
+    m_pCodecContext->skip_frame = AVDISCARD_NONKEY;
+    m_pCodecContext->skip_loop_filter = AVDISCARD_ALL;
+    m_pCodecContext->flags2 |= AV_CODEC_FLAG2_FAST;
+    if (pCodec->max_lowres > 0 && hints.width >= 2 * static_cast<int>(g_advancedSettings.m_imageRes))
+      m_pCodecContext->lowres = 1;
+  }
+
   // set any special options
   for(std::vector<CDVDCodecOption>::iterator it = options.m_keys.begin(); it != options.m_keys.end(); ++it)
   {
@@ -193,7 +193,7 @@ bool CDVDFileInfo::ExtractThumb(const CFileItem& fileItem,
     pProcessInfo->SetPixFormats(pixFmts);
 
     CDVDStreamInfo hint(*pDemuxer->GetStream(demuxerId, nVideoStream), true);
-    hint.codecOptions = CODEC_FORCE_SOFTWARE;
+    hint.codecOptions = CODEC_FORCE_SOFTWARE | CODEC_THUMBNAIL;
 
     pVideoCodec = CDVDFactoryCodec::CreateVideoCodec(hint, *pProcessInfo);
 
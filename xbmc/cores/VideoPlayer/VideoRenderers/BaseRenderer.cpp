@@ -25,6 +25,9 @@
 
 CBaseRenderer::CBaseRenderer()
 {
+  m_errorInAspect = CServiceBroker::GetSettings().GetIntHandle(CSettings::SETTING_VIDEOPLAYER_ERRORINASPECT);
+  m_stretch43 = CServiceBroker::GetSettings().GetIntHandle(CSettings::SETTING_VIDEOPLAYER_STRETCH43);
+
   for (int i=0; i < 4; i++)
   {
     m_rotatedDestCoords[i].x = 0;
@@ -34,7 +37,29 @@ CBaseRenderer::CBaseRenderer()
   }
 }
 
-CBaseRenderer::~CBaseRenderer() = default;
+CBaseRenderer::~CBaseRenderer()
+{
+  if (m_renderAreaRequests > 0)
+    CLog::Log(LOGDEBUG, "CBaseRenderer: render area calculated %u times for %u updates",
+              m_renderAreaCalculations, m_renderAreaRequests);
+}
+
+bool CBaseRenderer::RenderAreaKey::operator==(const RenderAreaKey &other) const
+{
+  return viewRect == other.viewRect &&
+         sourceWidth == other.sourceWidth &&
+         sourceHeight == other.sourceHeight &&
+         sourceFrameRatio == other.sourceFrameRatio &&
+         orientation == other.orientation &&
+         stereoFlags == other.stereoFlags &&
+         stereoView == other.stereoView &&
+         pixelRatio == other.pixelRatio &&
+         zoomAmount == other.zoomAmount &&
+         verticalShift == other.verticalShift &&
+         outputPixelRatio == other.outputPixelRatio &&
+         errorInAspect == other.errorInAspect &&
+         clip == other.clip;
+}
 
 float CBaseRenderer::GetAspectRatio() const
 {
@@ -121,7 +146,7 @@ void CBaseRenderer::CalcNormalRenderRect(float offsetX, float offsetY, float wid
 
   // allow a certain error to maximize size of render area
   float fCorrection = width / height / outputFrameRatio - 1.0f;
-  float fAllowed = CServiceBroker::GetSettings().GetInt(CSettings::SETTING_VIDEOPLAYER_ERRORINASPECT) * 0.01f;
+  float fAllowed = CServiceBroker::GetSettings().GetInt(m_errorInAspect) * 0.01f;
   if (fCorrection > fAllowed)
     fCorrection = fAllowed;
   if (fCorrection < -fAllowed)
@@ -224,6 +249,7 @@ void CBaseRenderer::CalcNormalRenderRect(float offsetX, float offsetY, float wid
 //***************************************************************************************
 void CBaseRenderer::CalculateFrameAspectRatio(unsigned int desired_width, unsigned int desired_height)
 {
+  m_renderAreaValid = false;
   m_sourceFrameRatio = (float)desired_width / desired_height;
 
   // Check whether mplayer has decided that the size of the video file should be changed
@@ -281,7 +307,38 @@ void CBaseRenderer::CalculateFrameAspectRatio(unsigned int desired_width, unsign
 
 void CBaseRenderer::ManageRenderArea()
 {
-  m_viewRect = CServiceBroker::GetWinSystem()->GetGfxContext().GetViewWindow();
+  CGraphicContext &context = CServiceBroker::GetWinSystem()->GetGfxContext();
+
+  // this is called for every frame, but the result only changes with its inputs
+  RenderAreaKey key;
+  key.viewRect = context.GetViewWindow();
+  key.sourceWidth = m_sourceWidth;
+  key.sourceHeight = m_sourceHeight;
+  key.sourceFrameRatio = m_sourceFrameRatio;
+  key.orientation = m_renderOrientation;
+  key.stereoFlags = m_iFlags;
+  key.stereoView = context.GetStereoView();
+  key.pixelRatio = CDisplaySettings::GetInstance().GetPixelRatio();
+  key.zoomAmount = CDisplaySettings::GetInstance().GetZoomAmount();
+  key.verticalShift = CDisplaySettings::GetInstance().GetVerticalShift();
+  key.outputPixelRatio = context.GetResInfo().fPixelRatio;
+  key.errorInAspect = CServiceBroker::GetSettings().GetInt(m_errorInAspect);
+  key.clip = !(context.IsFullScreenVideo() || context.IsCalibrating());
+
+  m_renderAreaRequests++;
+  m_viewRect = key.viewRect;
+  if (m_renderAreaValid && key == m_renderAreaKey)
+  {
+    m_sourceRect = m_renderAreaSourceRect;
+    m_destRect = m_renderAreaDestRect;
+    for (int i = 0; i < 4; i++)
+      m_rotatedDestCoords[i] = m_renderAreaRotatedDestCoords[i];
+    return;
+  }
+
+  m_renderAreaKey = key;
+  m_renderAreaValid = true;
+  m_renderAreaCalculations++;
 
   m_sourceRect.x1 = 0.0f;
   m_sourceRect.y1 = 0.0f;
@@ -289,7 +346,7 @@ void CBaseRenderer::ManageRenderArea()
   m_sourceRect.y2 = (float)m_sourceHeight;
 
   unsigned int stereo_mode  = CONF_FLAGS_STEREO_MODE_MASK(m_iFlags);
-  int          stereo_view  = CServiceBroker::GetWinSystem()->GetGfxContext().GetStereoView();
+  int          stereo_view  = key.stereoView;
 
   if(CONF_FLAGS_STEREO_CADENCE(m_iFlags) == CONF_FLAGS_STEREO_CADANCE_RIGHT_LEFT)
   {
@@ -318,9 +375,12 @@ void CBaseRenderer::ManageRenderArea()
   }
 
   CalcNormalRenderRect(m_viewRect.x1, m_viewRect.y1, m_viewRect.Width(), m_viewRect.Height(),
-                       GetAspectRatio() * CDisplaySettings::GetInstance().GetPixelRatio(),
-                       CDisplaySettings::GetInstance().GetZoomAmount(),
-                       CDisplaySettings::GetInstance().GetVerticalShift());
+                       GetAspectRatio() * key.pixelRatio, key.zoomAmount, key.verticalShift);
+
+  m_renderAreaSourceRect = m_sourceRect;
+  m_renderAreaDestRect = m_destRect;
+  for (int i = 0; i < 4; i++)
+    m_renderAreaRotatedDestCoords[i] = m_rotatedDestCoords[i];
 }
 
 EShaderFormat CBaseRenderer::GetShaderFormat()
@@ -357,6 +417,7 @@ void CBaseRenderer::SetViewMode(int viewMode)
     viewMode = ViewModeNormal;
 
   m_videoSettings.m_ViewMode = viewMode;
+  m_renderAreaValid = false;
 
   // get our calibrated full screen resolution
   RESOLUTION_INFO info = CServiceBroker::GetWinSystem()->GetGfxContext().GetResInfo();
@@ -380,7 +441,7 @@ void CBaseRenderer::SetViewMode(int viewMode)
   CDisplaySettings::GetInstance().SetNonLinearStretched(false);
 
   if (m_videoSettings.m_ViewMode == ViewModeZoom ||
-       (is43 && CServiceBroker::GetSettings().GetInt(CSettings::SETTING_VIDEOPLAYER_STRETCH43) == ViewModeZoom))
+       (is43 && CServiceBroker::GetSettings().GetInt(m_stretch43) == ViewModeZoom))
   { // zoom image so no black bars
     CDisplaySettings::GetInstance().SetPixelRatio(1.0);
     // calculate the desired output ratio
@@ -404,7 +465,7 @@ void CBaseRenderer::SetViewMode(int viewMode)
     CDisplaySettings::GetInstance().SetPixelRatio((4.0f / 3.0f) / sourceFrameRatio);
   }
   else if (m_videoSettings.m_ViewMode == ViewModeWideZoom ||
-           (is43 && CServiceBroker::GetSettings().GetInt(CSettings::SETTING_VIDEOPLAYER_STRETCH43) == ViewModeWideZoom))
+           (is43 && CServiceBroker::GetSettings().GetInt(m_stretch43) == ViewModeWideZoom))
   { // super zoom
     float stretchAmount = (screenWidth / screenHeight) * info.fPixelRatio / sourceFrameRatio;
     CDisplaySettings::GetInstance().SetPixelRatio(pow(stretchAmount, float(2.0/3.0)));
@@ -413,14 +474,14 @@ void CBaseRenderer::SetViewMode(int viewMode)
   }
   else if (m_videoSettings.m_ViewMode == ViewModeStretch16x9 ||
             m_videoSettings.m_ViewMode == ViewModeStretch16x9Nonlin ||
-           (is43 && (CServiceBroker::GetSettings().GetInt(CSettings::SETTING_VIDEOPLAYER_STRETCH43) == ViewModeStretch16x9 ||
-                     CServiceBroker::GetSettings().GetInt(CSettings::SETTING_VIDEOPLAYER_STRETCH43) == ViewModeStretch16x9Nonlin)))
+           (is43 && (CServiceBroker::GetSettings().GetInt(m_stretch43) == ViewModeStretch16x9 ||
+                     CServiceBroker::GetSettings().GetInt(m_stretch43) == ViewModeStretch16x9Nonlin)))
   { // stretch image to 16:9 ratio
     CDisplaySettings::GetInstance().SetZoomAmount(1.0);
     // stretch to the limits of the 16:9 screen.
     // incorrect behaviour, but it's what the users want, so...
     CDisplaySettings::GetInstance().SetPixelRatio((screenWidth / screenHeight) * info.fPixelRatio / sourceFrameRatio);
-    bool nonlin = (is43 && CServiceBroker::GetSettings().GetInt(CSettings::SETTING_VIDEOPLAYER_STRETCH43) == ViewModeStretch16x9Nonlin) ||
+    bool nonlin = (is43 && CServiceBroker::GetSettings().GetInt(m_stretch43) == ViewModeStretch16x9Nonlin) ||
                   m_videoSettings.m_ViewMode == ViewModeStretch16x9Nonlin;
     CDisplaySettings::GetInstance().SetNonLinearStretched(nonlin);
   }
@@ -479,6 +540,7 @@ void CBaseRenderer::MarkDirty()
 void CBaseRenderer::SetVideoSettings(const CVideoSettings &settings)
 {
   m_videoSettings = settings;
+  m_renderAreaValid = false;
 }
 
 void CBaseRenderer::SettingOptionsRenderMethodsFiller(std::shared_ptr<const CSetting> setting, std::vector< std::pair<std::string, int> > &list, int &current, void *data)
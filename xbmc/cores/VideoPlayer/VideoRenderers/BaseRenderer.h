@@ -17,6 +17,7 @@
 #include "VideoShaders/ShaderFormats.h"
 #include "cores/IPlayer.h"
 #include "cores/VideoPlayer/Process/VideoBuffer.h"
+#include "settings/lib/SettingHandle.h"
 
 #define MAX_FIELDS 3
 #define NUM_BUFFERS 6
@@ -124,4 +125,37 @@ protected:
   AVPixelFormat m_format = AV_PIX_FMT_NONE;
 
   CVideoSettings m_videoSettings;
+
+  // read for every frame
+  SettingHandleInt m_errorInAspect;
+  SettingHandleInt m_stretch43;
+
+  // inputs of the last calculation in ManageRenderArea()
+  struct RenderAreaKey
+  {
+    CRect viewRect;
+    unsigned int sourceWidth = 0;
+    unsigned int sourceHeight = 0;
+    float sourceFrameRatio = 0.0f;
+    unsigned int orientation = 0;
+    unsigned int stereoFlags = 0;
+    int stereoView = 0;
+    float pixelRatio = 0.0f;
+    float zoomAmount = 0.0f;
+    float verticalShift = 0.0f;
+    float outputPixelRatio = 0.0f;
+    int errorInAspect = 0;
+    bool clip = false;
+
+    bool operator==(const RenderAreaKey &other) const;
+  };
+  RenderAreaKey m_renderAreaKey;
+  // results of the last calculation, restored when the inputs are unchanged as
+  // derived renderers may adjust them after ManageRenderArea()
+  CRect m_renderAreaSourceRect;
+  CRect m_renderAreaDestRect;
+  CPoint m_renderAreaRotatedDestCoords[4];
+  bool m_renderAreaValid = false; //!< reset to force the next ManageRenderArea() to recalculate
+  unsigned int m_renderAreaRequests = 0;
+  unsigned int m_renderAreaCalculations = 0;
 };
@@ -6,18 +6,26 @@
  *  See LICENSES/README.md for more information.
  */
 
+#include <algorithm>
 #include <math.h>
+#include <string.h>
 #include <vector>
 
 #include "ColorManager.h"
 #include "ServiceBroker.h"
 #include "cores/VideoPlayer/VideoRenderers/RenderFlags.h"
+#include "filesystem/Directory.h"
 #include "filesystem/File.h"
 #include "settings/Settings.h"
+#include "utils/CPUInfo.h"
+#include "utils/Digest.h"
 #include "utils/log.h"
+#include "utils/StringUtils.h"
+#include "utils/TaskGraph.h"
 #include "utils/TimeUtils.h"
 
 using namespace XFILE;
+using KODI::UTILITY::CDigest;
 
 CColorManager::CColorManager()
 {
@@ -172,6 +180,13 @@ bool CColorManager::GetVideo3dLut(int videoFlags, int *cmsToken, CMS_DATA_FORMAT
         m_hProfile = LoadIccDisplayProfile(CServiceBroker::GetSettings().GetString("videoscreen.displayprofile"));
         if (!m_hProfile)
           return false;
+        // the hash identifies cached 3D LUTs of the profile
+        XUTILS::auto_buffer profileData;
+        CFile profileFile;
+        if (profileFile.LoadFile(CServiceBroker::GetSettings().GetString("videoscreen.displayprofile"), profileData) > 0)
+          m_hProfileHash = CDigest::Calculate(CDigest::Type::MD5, profileData.get(), profileData.size());
+        else
+          m_hProfileHash.clear();
         // detect blackpoint
         if (cmsDetectBlackPoint(&m_blackPoint, m_hProfile, INTENT_PERCEPTUAL, 0))
         {
@@ -179,35 +194,45 @@ bool CColorManager::GetVideo3dLut(int videoFlags, int *cmsToken, CMS_DATA_FORMAT
         }
         m_curIccProfile = CServiceBroker::GetSettings().GetString("videoscreen.displayprofile");
       }
-      // create gamma curve
-      cmsToneCurve* gammaCurve;
       m_m_curIccGammaMode = (CMS_TRC_TYPE)CServiceBroker::GetSettings().GetInt("videoscreen.cmsgammamode");
       m_curIccGamma = CServiceBroker::GetSettings().GetInt("videoscreen.cmsgamma");
-      gammaCurve =
-        CreateToneCurve(m_m_curIccGammaMode, m_curIccGamma/100.0f, m_blackPoint);
-
-      // create source profile
       m_curIccWhitePoint = (CMS_WHITEPOINT)CServiceBroker::GetSettings().GetInt("videoscreen.cmswhitepoint");
       m_curIccPrimaries = (CMS_PRIMARIES)CServiceBroker::GetSettings().GetInt("videoscreen.cmsprimaries");
       CLog::Log(LOGDEBUG, "ColorManager: primaries setting: %d\n", (int)m_curIccPrimaries);
       if (m_curIccPrimaries == CMS_PRIMARIES_AUTO)
         m_curIccPrimaries = videoPrimaries;
       CLog::Log(LOGDEBUG, "ColorManager: source profile primaries: %d\n", (int)m_curIccPrimaries);
-      cmsHPROFILE sourceProfile = CreateSourceProfile(m_curIccPrimaries, gammaCurve, m_curIccWhitePoint);
-
-      // link profiles
-      // TODO: intent selection, switch output to 16 bits?
-      cmsSetAdaptationState(0.0);
-      uint32_t fmt = format == CMS_DATA_FMT_RGBA ? TYPE_RGBA_FLT : TYPE_RGB_FLT;
-      cmsHTRANSFORM deviceLink =  cmsCreateTransform(sourceProfile, fmt, m_hProfile, fmt, INTENT_ABSOLUTE_COLORIMETRIC, 0);
 
-      // sample the transformation
-      Create3dLut(deviceLink, format, clutSize, clutData);
-
-      // free gamma curve, source profile and transformation
-      cmsDeleteTransform(deviceLink);
-      cmsCloseProfile(sourceProfile);
-      cmsFreeToneCurve(gammaCurve);
+      // sampling the transformation takes a while, so reuse the result of an earlier stream
+      std::string cachedLutFile = GetCachedLutFile(m_curIccPrimaries, format, clutSize);
+      if (cachedLutFile.empty() || !LoadCachedLut(cachedLutFile, format, clutSize, clutData))
+      {
+        // create gamma curve
+        cmsToneCurve* gammaCurve;
+        gammaCurve =
+          CreateToneCurve(m_m_curIccGammaMode, m_curIccGamma/100.0f, m_blackPoint);
+
+        // create source profile
+        cmsHPROFILE sourceProfile = CreateSourceProfile(m_curIccPrimaries, gammaCurve, m_curIccWhitePoint);
+
+        // link profiles
+        // TODO: intent selection, switch output to 16 bits?
+        // the transform is shared by the threads sampling it, so it must not cache
+        cmsSetAdaptationState(0.0);
+        uint32_t fmt = format == CMS_DATA_FMT_RGBA ? TYPE_RGBA_FLT : TYPE_RGB_FLT;
+        cmsHTRANSFORM deviceLink =  cmsCreateTransform(sourceProfile, fmt, m_hProfile, fmt, INTENT_ABSOLUTE_COLORIMETRIC, cmsFLAGS_NOCACHE);
+
+        // sample the transformation
+        Create3dLut(deviceLink, format, clutSize, clutData);
+
+        // free gamma curve, source profile and transformation
+        cmsDeleteTransform(deviceLink);
+        cmsCloseProfile(sourceProfile);
+        cmsFreeToneCurve(gammaCurve);
+
+        if (!cachedLutFile.empty())
+          SaveCachedLut(cachedLutFile, format, clutSize, clutData);
+      }
     }
 
     m_curCmsMode = CMS_MODE_PROFILE;
@@ -556,35 +581,56 @@ void CColorManager::Create3dLut(cmsHTRANSFORM transform, CMS_DATA_FORMAT format,
 {
   const int lutResolution = clutSize;
   int components = format == CMS_DATA_FMT_RGBA ? 4 : 3;
-
-  cmsFloat32Number *input = new cmsFloat32Number[components*lutResolution];
-  cmsFloat32Number *output = new cmsFloat32Number[components*lutResolution];
+  int64_t start = CurrentHostCounter();
 
 #define clamp(x, l, h) ( ((x) < (l)) ? (l) : ( ((x) > (h)) ? (h) : (x) ) )
 #define videoToPC(x) ( clamp((((x)*255)-16)/219,0,1) )
 #define PCToVideo(x) ( (((x)*219)+16)/255 )
 
-  for (int bIndex=0; bIndex<lutResolution; bIndex++)
+  // the blue planes are sampled in slices by separate threads, each transforming
+  // a whole plane per call
+  auto sampleSlice = [=](int firstPlane, int lastPlane)
   {
-    for (int gIndex=0; gIndex<lutResolution; gIndex++)
+    const int planeSize = lutResolution * lutResolution * components;
+    std::vector<cmsFloat32Number> input(planeSize);
+    std::vector<cmsFloat32Number> output(planeSize);
+
+    for (int bIndex=firstPlane; bIndex<lastPlane; bIndex++)
     {
-      for (int rIndex=0; rIndex<lutResolution; rIndex++)
+      for (int gIndex=0; gIndex<lutResolution; gIndex++)
       {
-        int offset = rIndex * components;
-        input[offset + 0] = videoToPC(rIndex / (lutResolution-1.0));
-        input[offset + 1] = videoToPC(gIndex / (lutResolution-1.0));
-        input[offset + 2] = videoToPC(bIndex / (lutResolution-1.0));
-        if (format == CMS_DATA_FMT_RGBA)
-          input[offset + 3] = 0.0f;
+        for (int rIndex=0; rIndex<lutResolution; rIndex++)
+        {
+          int offset = (gIndex*lutResolution + rIndex) * components;
+          input[offset + 0] = videoToPC(rIndex / (lutResolution-1.0));
+          input[offset + 1] = videoToPC(gIndex / (lutResolution-1.0));
+          input[offset + 2] = videoToPC(bIndex / (lutResolution-1.0));
+          if (format == CMS_DATA_FMT_RGBA)
+            input[offset + 3] = 0.0f;
+        }
       }
-      int index = (bIndex*lutResolution*lutResolution + gIndex*lutResolution)*components;
-      cmsDoTransform(transform, input, output, lutResolution);
-      for (int i=0; i < lutResolution * components; i++)
+      int index = bIndex*planeSize;
+      cmsDoTransform(transform, input.data(), output.data(), lutResolution*lutResolution);
+      for (int i=0; i < planeSize; i++)
       {
         clutData[index + i] = PCToVideo(output[i]) * 65535;
       }
     }
+    return true;
+  };
+
+  int slices = std::max(1, std::min(g_cpuInfo.getCPUCount(), lutResolution));
+  CTaskGraph graph("ColorManager");
+  for (int slice=0; slice<slices; slice++)
+  {
+    int firstPlane = lutResolution * slice / slices;
+    int lastPlane = lutResolution * (slice+1) / slices;
+    graph.Add(StringUtils::Format("slice%d", slice), {}, [=]() { return sampleSlice(firstPlane, lastPlane); });
   }
+  graph.Run(slices);
+
+  CLog::Log(LOGDEBUG, "ColorManager: sampled %d^3 3D LUT in %d ms using %d threads\n",
+      lutResolution, (int)((CurrentHostCounter() - start) * 1000 / CurrentHostFrequency()), slices);
 
   for (int y=0; y<lutResolution; y+=1)
   {
@@ -595,8 +641,68 @@ void CColorManager::Create3dLut(cmsHTRANSFORM transform, CMS_DATA_FORMAT format,
         (int)round(clutData[index+1]),
         (int)round(clutData[index+2]));
   }
-  delete[] input;
-  delete[] output;
+}
+
+// cached 3D LUTs sampled from a display profile
+struct CachedLutHeader
+{
+  char signature[4];   // 'KLUT'
+  uint32_t version;
+  uint32_t clutSize;
+  uint32_t components;
+};
+
+std::string CColorManager::GetCachedLutFile(CMS_PRIMARIES primaries, CMS_DATA_FORMAT format, int clutSize) const
+{
+  if (m_hProfileHash.empty())
+    return "";
+
+  // everything the sampled transformation depends on
+  std::string key = StringUtils::Format("%s|%d|%d|%d|%d|%d|%d", m_hProfileHash.c_str(),
+      (int)m_m_curIccGammaMode, m_curIccGamma, (int)m_curIccWhitePoint, (int)primaries,
+      (int)format, clutSize);
+  return "special://temp/3dlut/" + CDigest::Calculate(CDigest::Type::MD5, key) + ".lut";
+}
+
+bool CColorManager::LoadCachedLut(const std::string &filename, CMS_DATA_FORMAT format, int clutSize, uint16_t *clutData)
+{
+  CFile lutFile;
+  if (!lutFile.Open(filename))
+    return false;
+
+  uint32_t components = format == CMS_DATA_FMT_RGBA ? 4 : 3;
+  ssize_t dataSize = sizeof(uint16_t) * clutSize * clutSize * clutSize * components;
+  CachedLutHeader header;
+  if (lutFile.Read(&header, sizeof(header)) != static_cast<ssize_t>(sizeof(header)) ||
+      memcmp(header.signature, "KLUT", 4) != 0 || header.version != 1 ||
+      header.clutSize != static_cast<uint32_t>(clutSize) || header.components != components ||
+      lutFile.Read(clutData, dataSize) != dataSize)
+  {
+    CLog::Log(LOGWARNING, "ColorManager: ignoring invalid cached 3D LUT %s", filename.c_str());
+    return false;
+  }
+
+  CLog::Log(LOGDEBUG, "ColorManager: loaded cached 3D LUT %s\n", filename.c_str());
+  return true;
+}
+
+void CColorManager::SaveCachedLut(const std::string &filename, CMS_DATA_FORMAT format, int clutSize, const uint16_t *clutData)
+{
+  CachedLutHeader header = { { 'K', 'L', 'U', 'T' }, 1, static_cast<uint32_t>(clutSize),
+                             static_cast<uint32_t>(format == CMS_DATA_FMT_RGBA ? 4 : 3) };
+  ssize_t dataSize = sizeof(uint16_t) * clutSize * clutSize * clutSize * header.components;
+
+  CFile lutFile;
+  if (!CDirectory::Exists("special://temp/3dlut/") && !CDirectory::Create("special://temp/3dlut/"))
+    return;
+  if (!lutFile.OpenForWrite(filename, true) ||
+      lutFile.Write(&header, sizeof(header)) != static_cast<ssize_t>(sizeof(header)) ||
+      lutFile.Write(clutData, dataSize) != dataSize)
+  {
+    CLog::Log(LOGWARNING, "ColorManager: unable to cache 3D LUT in %s", filename.c_str());
+    lutFile.Close();
+    CFile::Delete(filename);
+  }
 }
 
 #endif //defined(HAVE_LCMS2)
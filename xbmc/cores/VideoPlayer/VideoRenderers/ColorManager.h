@@ -155,9 +155,20 @@ private:
    */
   void Create3dLut(cmsHTRANSFORM transform, CMS_DATA_FORMAT format, int clutSize, uint16_t *clutData);
 
+  /* \brief Name of the file a 3D LUT sampled from the current display profile is cached in
+   \param primaries source primaries
+   \param format of CLUT data
+   \param clutSize CLUT resolution
+   \return path in special://temp
+   */
+  std::string GetCachedLutFile(CMS_PRIMARIES primaries, CMS_DATA_FORMAT format, int clutSize) const;
+  static bool LoadCachedLut(const std::string &filename, CMS_DATA_FORMAT format, int clutSize, uint16_t *clutData);
+  static void SaveCachedLut(const std::string &filename, CMS_DATA_FORMAT format, int clutSize, const uint16_t *clutData);
+
   // keep current display profile loaded here
   cmsHPROFILE m_hProfile;
   cmsCIEXYZ   m_blackPoint = { 0, 0, 0 };
+  std::string m_hProfileHash; // md5 of the display profile
 
   // display parameters (gamma, input/output offset, primaries, whitepoint, intent?)
   CMS_WHITEPOINT m_curIccWhitePoint;
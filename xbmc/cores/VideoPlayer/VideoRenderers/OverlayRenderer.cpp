@@ -95,6 +95,9 @@ void CRenderer::Flush()
     Release(m_buffers[i]);
 
   ReleaseCache();
+#if defined(HAS_GL) || defined(HAS_GLES)
+  m_glyphAtlas.reset();
+#endif
 
   g_fontManager.Unload(m_font);
   g_fontManager.Unload(m_fontBorder);
@@ -148,6 +151,16 @@ void CRenderer::Render(int idx)
 {
   CSingleLock lock(m_section);
 
+#if defined(HAS_GL) || defined(HAS_GLES)
+  // glyphs which didn't fit have been rendered without the atlas, start over
+  // while no overlay refers to the atlas anymore
+  if (m_glyphAtlas && m_glyphAtlas->IsFull())
+  {
+    ReleaseCache();
+    m_glyphAtlas->Reset();
+  }
+#endif
+
   std::vector<COverlay*> render;
   std::vector<SElement>& list = m_buffers[idx];
   for(std::vector<SElement>::iterator it = list.begin(); it != list.end(); ++it)
@@ -379,7 +392,9 @@ COverlay* CRenderer::Convert(CDVDOverlaySSA* o, double pts)
 
   COverlay *overlay = NULL;
 #if defined(HAS_GL) || defined(HAS_GLES)
-  overlay = new COverlayGlyphGL(images, targetWidth, targetHeight);
+  if (!m_glyphAtlas)
+    m_glyphAtlas.reset(new CGlyphAtlasGL());
+  overlay = new COverlayGlyphGL(images, targetWidth, targetHeight, m_glyphAtlas.get());
 #elif defined(HAS_DX)
   overlay = new COverlayQuadsDX(images, targetWidth, targetHeight);
 #endif
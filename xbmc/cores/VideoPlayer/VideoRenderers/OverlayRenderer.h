@@ -12,8 +12,9 @@
 #include "threads/CriticalSection.h"
 #include "BaseRenderer.h"
 
-#include <vector>
 #include <map>
+#include <memory>
+#include <vector>
 
 class CDVDOverlay;
 class CDVDOverlayImage;
@@ -22,6 +23,10 @@ class CDVDOverlaySSA;
 
 namespace OVERLAY {
 
+#if defined(HAS_GL) || defined(HAS_GLES)
+  class CGlyphAtlasGL;
+#endif
+
   struct SRenderState
   {
     float x;
@@ -103,5 +108,8 @@ namespace OVERLAY {
     static unsigned int m_textureid;
     CRect m_rv, m_rs, m_rd;
     std::string m_font, m_fontBorder;
+#if defined(HAS_GL) || defined(HAS_GLES)
+    std::unique_ptr<CGlyphAtlasGL> m_glyphAtlas;
+#endif
   };
 }
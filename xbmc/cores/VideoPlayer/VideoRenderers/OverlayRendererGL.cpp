@@ -260,7 +260,81 @@ COverlayTextureGL::COverlayTextureGL(CDVDOverlaySpu* o)
   m_pma    = !!USE_PREMULTIPLIED_ALPHA;
 }
 
-COverlayGlyphGL::COverlayGlyphGL(ASS_Image* images, int width, int height)
+// size of the glyph atlas, supported by every GL and GLES implementation
+#define GLYPH_ATLAS_SIZE 1024
+
+CGlyphAtlasGL::CGlyphAtlasGL()
+  : m_atlas(GLYPH_ATLAS_SIZE, GLYPH_ATLAS_SIZE)
+{
+}
+
+CGlyphAtlasGL::~CGlyphAtlasGL()
+{
+  const CGlyphAtlas::SStats& stats = m_atlas.GetTotalStats();
+  if (stats.hits + stats.misses > 0)
+    CLog::Log(LOGDEBUG, "CGlyphAtlasGL: %u glyph hits, %u misses, %zu bytes uploaded, %u resets",
+              stats.hits, stats.misses, stats.bytesUploaded, m_atlas.GetResets());
+
+  if (m_texture)
+    glDeleteTextures(1, &m_texture);
+}
+
+void CGlyphAtlasGL::Reset()
+{
+  m_atlas.Reset();
+}
+
+bool CGlyphAtlasGL::AddImages(ASS_Image* images, SQuads& quads)
+{
+  if (!m_atlas.AddImages(images, quads))
+    return false;
+
+  Upload();
+
+  const CGlyphAtlas::SStats& stats = m_atlas.GetLastStats();
+  CLog::Log(LOGDEBUG, LOGVIDEO, "CGlyphAtlasGL: %u glyph hits, %u misses, %zu bytes uploaded",
+            stats.hits, stats.misses, stats.bytesUploaded);
+  return true;
+}
+
+void CGlyphAtlasGL::Upload()
+{
+  int first, last;
+  if (!m_atlas.GetDirtyRows(first, last))
+    return;
+
+#ifdef HAS_GLES
+  GLenum format = GL_ALPHA;
+#else
+  GLenum format = GL_RED;
+#endif
+
+  const int width = m_atlas.GetWidth();
+  const uint8_t* data = m_atlas.GetData();
+
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  if (!m_texture)
+  {
+    glGenTextures(1, &m_texture);
+    glBindTexture(GL_TEXTURE_2D, m_texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, format
+               , width, m_atlas.GetHeight(), 0
+               , format, GL_UNSIGNED_BYTE, NULL);
+  }
+  else
+    glBindTexture(GL_TEXTURE_2D, m_texture);
+
+  // the atlas is as wide as the texture, so the dirty rows are contiguous
+  glTexSubImage2D(GL_TEXTURE_2D, 0
+                , 0, first, width, last - first
+                , format, GL_UNSIGNED_BYTE
+                , data + width * first);
+
+  glBindTexture(GL_TEXTURE_2D, 0);
+  m_atlas.MarkUploaded(static_cast<size_t>(width) * (last - first));
+}
+
+COverlayGlyphGL::COverlayGlyphGL(ASS_Image* images, int width, int height, CGlyphAtlasGL* atlas /* = nullptr */)
 {
   m_vertex = NULL;
   m_width  = 1.0;
@@ -270,22 +344,40 @@ COverlayGlyphGL::COverlayGlyphGL(ASS_Image* images, int width, int height)
   m_x      = 0.0f;
   m_y      = 0.0f;
   m_texture = 0;
+  m_ownTexture = true;
+  m_count  = 0;
 
-  SQuads quads;
-  if(!convert_quad(images, quads, width))
-    return;
-
-  glGenTextures(1, &m_texture);
-  glBindTexture(GL_TEXTURE_2D, m_texture);
+  SQuads atlasQuads;
+  SQuads ownQuads;
+  SQuads* used = nullptr;
 
-  LoadTexture(GL_TEXTURE_2D
-            , quads.size_x
-            , quads.size_y
-            , quads.size_x
-            , &m_u, &m_v
-            , true
-            , quads.data);
+  if (atlas && atlas->AddImages(images, atlasQuads))
+  {
+    m_texture = atlas->GetTexture();
+    m_ownTexture = false;
+    m_u = 1.0f;
+    m_v = 1.0f;
+    used = &atlasQuads;
+  }
+  else
+  {
+    if(!convert_quad(images, ownQuads, width))
+      return;
+
+    glGenTextures(1, &m_texture);
+    glBindTexture(GL_TEXTURE_2D, m_texture);
+
+    LoadTexture(GL_TEXTURE_2D
+              , ownQuads.size_x
+              , ownQuads.size_y
+              , ownQuads.size_x
+              , &m_u, &m_v
+              , true
+              , ownQuads.data);
+    used = &ownQuads;
+  }
 
+  const SQuads& quads = *used;
 
   float scale_u = m_u / quads.size_x;
   float scale_v = m_v / quads.size_y;
@@ -344,7 +436,8 @@ COverlayGlyphGL::COverlayGlyphGL(ASS_Image* images, int width, int height)
 
 COverlayGlyphGL::~COverlayGlyphGL()
 {
-  glDeleteTextures(1, &m_texture);
+  if (m_ownTexture)
+    glDeleteTextures(1, &m_texture);
   free(m_vertex);
 }
 
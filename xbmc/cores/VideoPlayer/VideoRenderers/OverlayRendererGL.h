@@ -11,6 +11,7 @@
 
 #include "system_gl.h"
 #include "OverlayRenderer.h"
+#include "OverlayRendererUtil.h"
 
 class CDVDOverlay;
 class CDVDOverlayImage;
@@ -35,10 +36,35 @@ namespace OVERLAY {
     bool   m_pma; /*< is alpha in texture premultiplied in the values */
   };
 
+  /*!
+   \brief Texture holding a CGlyphAtlas, shared by all glyph overlays of a renderer.
+   */
+  class CGlyphAtlasGL
+  {
+  public:
+    CGlyphAtlasGL();
+    ~CGlyphAtlasGL();
+
+    /*! \brief Place the images into the atlas and upload the bitmaps which
+        weren't in the atlas before.
+        \return false if the images have to be rendered without the atlas.
+     */
+    bool AddImages(ASS_Image* images, SQuads& quads);
+    void Reset();
+    bool IsFull() const { return m_atlas.IsFull(); }
+    GLuint GetTexture() const { return m_texture; }
+
+  private:
+    void Upload();
+
+    CGlyphAtlas m_atlas;
+    GLuint m_texture = 0;
+  };
+
   class COverlayGlyphGL : public COverlay
   {
   public:
-   COverlayGlyphGL(ASS_Image* images, int width, int height);
+   COverlayGlyphGL(ASS_Image* images, int width, int height, CGlyphAtlasGL* atlas = nullptr);
 
    ~COverlayGlyphGL() override;
 
@@ -55,6 +81,7 @@ namespace OVERLAY {
    int     m_count;
 
    GLuint m_texture;
+   bool   m_ownTexture; /*< false if the texture belongs to a glyph atlas */
    float  m_u;
    float  m_v;
   };
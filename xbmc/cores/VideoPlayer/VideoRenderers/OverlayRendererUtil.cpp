@@ -14,6 +14,9 @@
 #include "windowing/GraphicContext.h"
 #include "settings/Settings.h"
 
+#include <algorithm>
+#include <cstring>
+
 namespace OVERLAY {
 
 static uint32_t build_rgba(int a, int r, int g, int b, bool mergealpha)
@@ -283,6 +286,197 @@ bool convert_quad(ASS_Image* images, SQuads& quads, int max_x)
   return true;
 }
 
+static uint64_t hash_bitmap(ASS_Image* img)
+{
+  // FNV-1a over the dimensions and the visible part of the bitmap
+  uint64_t hash = 14695981039346656037ULL;
+  auto add = [&hash](uint8_t byte)
+  {
+    hash ^= byte;
+    hash *= 1099511628211ULL;
+  };
+
+  for (int shift = 0; shift < 32; shift += 8)
+  {
+    add((img->w >> shift) & 0xff);
+    add((img->h >> shift) & 0xff);
+  }
+
+  for (int y = 0; y < img->h; y++)
+  {
+    const uint8_t* row = img->bitmap + img->stride * y;
+    for (int x = 0; x < img->w; x++)
+      add(row[x]);
+  }
+  return hash;
+}
+
+CGlyphAtlas::CGlyphAtlas(int width, int height)
+  : m_width(width),
+    m_height(height)
+{
+  Reset();
+  m_resets = 0;
+}
+
+void CGlyphAtlas::Reset()
+{
+  m_entries.clear();
+  m_shelves.clear();
+  m_nextShelf = 0;
+  m_full = false;
+  m_resets++;
+
+  // the area around glyphs is sampled by linear filtering, so clear it and upload it once
+  m_data.assign(m_width * m_height, 0);
+  m_dirtyFirst = 0;
+  m_dirtyLast = m_height;
+}
+
+const CGlyphAtlas::SEntry* CGlyphAtlas::Find(uint64_t hash, ASS_Image* img) const
+{
+  auto it = m_entries.find(hash);
+  if (it == m_entries.end())
+    return nullptr;
+
+  const SEntry& entry = it->second;
+  if (entry.w != img->w || entry.h != img->h)
+    return nullptr;
+
+  for (int y = 0; y < img->h; y++)
+  {
+    if (memcmp(m_data.data() + m_width * (entry.v + y) + entry.u
+             , img->bitmap + img->stride * y
+             , img->w) != 0)
+      return nullptr;
+  }
+  return &entry;
+}
+
+bool CGlyphAtlas::Allocate(int w, int h, int& u, int& v)
+{
+  // keep a gap of one pixel so neighbours don't bleed in when filtering
+  w += 1;
+  h += 1;
+  if (w > m_width || h > m_height)
+    return false;
+
+  SShelf* best = nullptr;
+  for (auto& shelf : m_shelves)
+  {
+    if (shelf.height >= h && shelf.x + w <= m_width
+    && (!best || shelf.height < best->height))
+      best = &shelf;
+  }
+
+  // don't waste a tall shelf on a small glyph as long as there is room for a new one
+  if ((!best || best->height > 2 * h) && m_nextShelf + h <= m_height)
+  {
+    m_shelves.push_back({m_nextShelf, h, 0});
+    m_nextShelf += h;
+    best = &m_shelves.back();
+  }
+
+  if (!best)
+    return false;
+
+  u = best->x;
+  v = best->y;
+  best->x += w;
+  return true;
+}
+
+bool CGlyphAtlas::AddImages(ASS_Image* images, SQuads& quads)
+{
+  m_last = SStats();
+
+  ASS_Image* img;
+  int count = 0;
+  for (img = images; img; img = img->next)
+  {
+    // fully transparent or width or height is 0 -> not displayed
+    if ((img->color & 0xff) == 0xff || img->w == 0 || img->h == 0)
+      continue;
+    count++;
+  }
+
+  if (count == 0 || m_full)
+    return false;
+
+  quads.size_x = m_width;
+  quads.size_y = m_height;
+  quads.count = count;
+  quads.quad = static_cast<SQuad*>(calloc(quads.count, sizeof(SQuad)));
+
+  SQuad* q = quads.quad;
+  for (img = images; img; img = img->next)
+  {
+    if ((img->color & 0xff) == 0xff || img->w == 0 || img->h == 0)
+      continue;
+
+    uint64_t hash = hash_bitmap(img);
+    const SEntry* entry = Find(hash, img);
+    if (entry)
+    {
+      q->u = entry->u;
+      q->v = entry->v;
+      m_last.hits++;
+    }
+    else
+    {
+      if (!Allocate(img->w, img->h, q->u, q->v))
+      {
+        m_full = true;
+        m_total.hits += m_last.hits;
+        m_total.misses += m_last.misses;
+        return false;
+      }
+
+      for (int y = 0; y < img->h; y++)
+        memcpy(m_data.data() + m_width * (q->v + y) + q->u
+             , img->bitmap + img->stride * y
+             , img->w);
+
+      m_dirtyFirst = std::min(m_dirtyFirst, q->v);
+      m_dirtyLast = std::max(m_dirtyLast, q->v + img->h);
+      m_entries[hash] = {q->u, q->v, img->w, img->h};
+      m_last.misses++;
+    }
+
+    unsigned int color = img->color;
+    q->a = 255 - (color & 0xff);
+    q->r = (color >> 24) & 0xff;
+    q->g = (color >> 16) & 0xff;
+    q->b = (color >> 8 ) & 0xff;
+
+    q->x = img->dst_x;
+    q->y = img->dst_y;
+    q->w = img->w;
+    q->h = img->h;
+
+    q++;
+  }
+
+  m_total.hits += m_last.hits;
+  m_total.misses += m_last.misses;
+  return true;
+}
+
+bool CGlyphAtlas::GetDirtyRows(int& first, int& last) const
+{
+  first = m_dirtyFirst;
+  last = m_dirtyLast;
+  return first < last;
+}
+
+void CGlyphAtlas::MarkUploaded(size_t bytes)
+{
+  m_last.bytesUploaded += bytes;
+  m_total.bytesUploaded += bytes;
+  m_dirtyFirst = m_height;
+  m_dirtyLast = 0;
+}
+
 int GetStereoscopicDepth()
 {
   int depth = 0;
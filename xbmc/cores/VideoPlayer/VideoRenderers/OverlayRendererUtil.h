@@ -10,6 +10,8 @@
 
 #include <stdint.h>
 #include <stdlib.h>
+#include <unordered_map>
+#include <vector>
 
 class CDVDOverlayImage;
 class CDVDOverlaySpu;
@@ -48,6 +50,81 @@ namespace OVERLAY {
     SQuad*   quad;
   };
 
+  /*!
+   \brief Persistent alpha atlas for the bitmaps of libass images.
+
+   Bitmaps are identified by a hash of their contents, so a glyph rendered again
+   in a later frame reuses the region it already occupies. Only rows which
+   received new bitmaps have to be uploaded. Regions are allocated on shelves
+   and never freed, once the atlas is full it has to be reset as a whole.
+   */
+  class CGlyphAtlas
+  {
+  public:
+    struct SStats
+    {
+      unsigned int hits = 0;
+      unsigned int misses = 0;
+      size_t bytesUploaded = 0;
+    };
+
+    CGlyphAtlas(int width, int height);
+
+    /*! \brief Place all visible images into the atlas and fill quads with their
+        positions in atlas coordinates, quads.data is not used.
+        \return false if there are no visible images or the atlas is full.
+     */
+    bool AddImages(ASS_Image* images, SQuads& quads);
+
+    /*! \brief Rows [first, last) which changed since the last call to MarkUploaded.
+        \return false if nothing has to be uploaded.
+     */
+    bool GetDirtyRows(int& first, int& last) const;
+    void MarkUploaded(size_t bytes);
+
+    void Reset();
+    bool IsFull() const { return m_full; }
+    bool IsEmpty() const { return m_entries.empty(); }
+
+    int GetWidth() const { return m_width; }
+    int GetHeight() const { return m_height; }
+    const uint8_t* GetData() const { return m_data.data(); }
+
+    const SStats& GetLastStats() const { return m_last; }
+    const SStats& GetTotalStats() const { return m_total; }
+    unsigned int GetResets() const { return m_resets; }
+
+  private:
+    struct SEntry
+    {
+      int u, v;
+      int w, h;
+    };
+
+    struct SShelf
+    {
+      int y;
+      int height;
+      int x;
+    };
+
+    const SEntry* Find(uint64_t hash, ASS_Image* img) const;
+    bool Allocate(int w, int h, int& u, int& v);
+
+    int m_width;
+    int m_height;
+    int m_nextShelf = 0;
+    int m_dirtyFirst;
+    int m_dirtyLast = 0;
+    bool m_full = false;
+    std::vector<uint8_t> m_data;
+    std::vector<SShelf> m_shelves;
+    std::unordered_map<uint64_t, SEntry> m_entries;
+    SStats m_last;
+    SStats m_total;
+    unsigned int m_resets = 0;
+  };
+
   uint32_t* convert_rgba(CDVDOverlayImage* o, bool mergealpha);
   uint32_t* convert_rgba(CDVDOverlaySpu*   o, bool mergealpha
                        , int& min_x, int& max_x
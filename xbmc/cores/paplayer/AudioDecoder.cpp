@@ -15,6 +15,7 @@
 #include "music/tags/MusicInfoTag.h"
 #include "threads/SingleLock.h"
 #include "utils/log.h"
+#include <algorithm>
 #include <math.h>
 
 CAudioDecoder::CAudioDecoder()
@@ -54,7 +55,7 @@ void CAudioDecoder::Destroy()
   m_canPlay = false;
 }
 
-bool CAudioDecoder::Create(const CFileItem &file, int64_t seekOffset)
+bool CAudioDecoder::Create(const CFileItem &file, int64_t seekOffset, unsigned int bufferSize /* = 0 */)
 {
   Destroy();
 
@@ -90,8 +91,8 @@ bool CAudioDecoder::Create(const CFileItem &file, int64_t seekOffset)
     return false;
   }
 
-  /* allocate the pcmBuffer for 2 seconds of audio */
-  m_pcmBuffer.Create(2 * blockSize * m_codec->m_format.m_sampleRate);
+  /* allocate the pcmBuffer for at least 2 seconds of audio */
+  m_pcmBuffer.Create(std::max(2 * blockSize * m_codec->m_format.m_sampleRate, bufferSize - bufferSize % blockSize));
 
   if (file.HasMusicInfoTag())
   {
@@ -43,7 +43,11 @@ public:
   CAudioDecoder();
   ~CAudioDecoder();
 
-  bool Create(const CFileItem &file, int64_t seekOffset);
+  /*!
+   \brief Open the codec of the file.
+   \param bufferSize size in bytes of the decoded PCM buffer, at least 2 seconds of audio are buffered
+   */
+  bool Create(const CFileItem &file, int64_t seekOffset, unsigned int bufferSize = 0);
   void Destroy();
 
   int ReadSamples(int numsamples);
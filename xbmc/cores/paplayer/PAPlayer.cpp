@@ -8,12 +8,18 @@
 
 #include "PAPlayer.h"
 #include "CodecFactory.h"
+#include "PlayListPlayer.h"
 #include "ServiceBroker.h"
+#include "URL.h"
+#include "playlists/PlayList.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "music/tags/MusicInfoTag.h"
+#include "threads/SystemClock.h"
 #include "utils/log.h"
 #include "utils/JobManager.h"
+#include "utils/StringUtils.h"
+#include "utils/URIUtils.h"
 #include "video/Bookmark.h"
 
 #include "cores/AudioEngine/Interfaces/AE.h"
@@ -23,6 +29,9 @@
 #include "cores/VideoPlayer/Process/ProcessInfo.h"
 #include "Util.h"
 
+#include <algorithm>
+#include <inttypes.h>
+
 #define TIME_TO_CACHE_NEXT_FILE 5000 /* 5 seconds before end of song, start caching the next song */
 #define FAST_XFADE_TIME           80 /* 80 milliseconds */
 #define MAX_SKIP_XFADE_TIME     2000 /* max 2 seconds crossfade on track skip */
@@ -31,6 +40,22 @@
 // Supporting all open  audio codec standards.
 // First one being nullsoft's nsv audio decoder format
 
+namespace
+{
+std::string PreDecodeKey(const CFileItem &file)
+{
+  return StringUtils::Format("%s|%" PRId64, file.GetDynPath().c_str(), file.m_lStartOffset);
+}
+
+bool CanPreDecode(const CFileItem &file)
+{
+  // items resolved when they're queued, streams and cd drives aren't opened ahead of time
+  return file.IsAudio() && !file.IsVideo() &&
+         !file.IsPlugin() && !URIUtils::IsUPnP(file.GetDynPath()) &&
+         !file.IsInternetStream() && !file.IsCDDA();
+}
+}
+
 PAPlayer::PAPlayer(IPlayerCallback& callback) :
   IPlayer(callback),
   CThread("PAPlayer"),
@@ -248,6 +273,8 @@ bool PAPlayer::OpenFile(const CFileItem& file, const CPlayerOptions &options)
   if (!IsRunning())
     Create();
 
+  PreDecodeUpcomingFiles(file, 0);
+
   /* trigger playback start */
   m_isPlaying = true;
   m_startEvent.Set();
@@ -298,9 +325,218 @@ bool PAPlayer::QueueNextFile(const CFileItem &file)
     QueueNextFileEx(file, true);
   }, this, CJob::PRIORITY_NORMAL);
 
+  PreDecodeUpcomingFiles(file, 1);
+
   return true;
 }
 
+void PAPlayer::PreDecodeUpcomingFiles(const CFileItem &file, int offset)
+{
+  const unsigned int count = g_advancedSettings.m_audioPreDecodeFiles;
+
+  // only playback of the current playlist has upcoming files
+  std::vector<CFileItem> files;
+  PLAYLIST::CPlayListPlayer &playlistPlayer = CServiceBroker::GetPlaylistPlayer();
+  const PLAYLIST::CPlayList &playlist = playlistPlayer.GetPlaylist(playlistPlayer.GetCurrentPlaylist());
+  int index = playlistPlayer.GetNextSong(offset);
+  if (count && index >= 0 && index < playlist.size() && playlist[index]->GetDynPath() == file.GetDynPath())
+  {
+    std::string previousPath = file.GetDynPath();
+    for (unsigned int i = 1; i <= count; i++)
+    {
+      index = playlistPlayer.GetNextSong(offset + i);
+      if (index < 0 || index >= playlist.size())
+        break;
+
+      const CFileItem &item = *playlist[index];
+      // following tracks of a cue sheet continue on the current stream
+      if (CanPreDecode(item) && item.GetDynPath() != previousPath)
+        files.push_back(item);
+      previousPath = item.GetDynPath();
+    }
+  }
+
+  const std::string queuedKey = PreDecodeKey(file);
+
+  CSingleLock lock(m_streamsLock);
+
+  // drop what was decoded for files which are no longer upcoming
+  for (auto it = m_preDecoded.begin(); it != m_preDecoded.end();)
+  {
+    const std::string key = PreDecodeKey((*it)->m_fileItem);
+    if (key != queuedKey &&
+        std::none_of(files.begin(), files.end(), [&key](const CFileItem &item) { return PreDecodeKey(item) == key; }))
+    {
+      (*it)->m_decoder.Destroy();
+      delete *it;
+      it = m_preDecoded.erase(it);
+    }
+    else
+      ++it;
+  }
+  for (auto it = m_preDecoding.begin(); it != m_preDecoding.end();)
+  {
+    if (it->first != queuedKey &&
+        std::none_of(files.begin(), files.end(), [&it](const CFileItem &item) { return PreDecodeKey(item) == it->first; }))
+    {
+      // a running job stops and drops its decoder once it finds its entry gone
+      CancelPreDecodeJob(it->second);
+      it = m_preDecoding.erase(it);
+    }
+    else
+      ++it;
+  }
+
+  if (files.empty())
+    return;
+
+  // the buffers of the queued and the playing stream, which may have been decoded ahead
+  // too, stay allocated until they have been played, so they share the budget
+  const unsigned int bufferSize = g_advancedSettings.m_audioPreDecodeMemory / (count + 2) * 1024;
+
+  for (const auto &item : files)
+  {
+    const std::string key = PreDecodeKey(item);
+    if (m_preDecoding.find(key) != m_preDecoding.end() ||
+        std::any_of(m_preDecoded.begin(), m_preDecoded.end(), [&key](StreamInfo *si) { return PreDecodeKey(si->m_fileItem) == key; }))
+      continue;
+
+    // the job can't look at its entry before the lock is released
+    PreDecodeJob &job = m_preDecoding[key];
+    m_jobCounter++;
+    job.m_jobId = CJobManager::GetInstance().Submit([this, item, bufferSize]() {
+      PreDecodeFile(item, bufferSize);
+    }, this, CJob::PRIORITY_LOW);
+  }
+}
+
+void PAPlayer::PreDecodeFile(const CFileItem &file, unsigned int bufferSize)
+{
+  const std::string key = PreDecodeKey(file);
+  StreamInfo *si = new StreamInfo();
+  {
+    // the file may have been queued or skipped in the meantime
+    CSingleLock lock(m_streamsLock);
+    auto it = m_preDecoding.find(key);
+    if (it == m_preDecoding.end() || it->second.m_stream || m_bStop)
+    {
+      delete si;
+      return;
+    }
+    it->second.m_stream = si;
+  }
+
+  unsigned int start = XbmcThreads::SystemClockMillis();
+  si->m_fileItem = file;
+  si->m_preDecoded = true;
+  bool ready = si->m_decoder.Create(file, file.m_lStartOffset, bufferSize);
+  si->m_openTime = XbmcThreads::SystemClockMillis() - start;
+
+  /* decode until the buffer is filled or the file is queued, the decoder isn't started before that */
+  start = XbmcThreads::SystemClockMillis();
+  while (ready && !m_bStop && !si->m_preDecodeStop && si->m_decoder.GetStatus() == STATUS_QUEUING)
+  {
+    int ret = si->m_decoder.ReadSamples(PACKET_SIZE);
+    if (ret == RET_ERROR)
+      ready = false;
+    else if (ret == RET_SLEEP)
+      CThread::Sleep(1);
+  }
+  si->m_decodeTime = XbmcThreads::SystemClockMillis() - start;
+
+  CSingleLock lock(m_streamsLock);
+  auto it = m_preDecoding.find(key);
+  bool owned = it != m_preDecoding.end() && it->second.m_stream == si;
+  if (!ready || m_bStop || !owned)
+  {
+    if (!ready)
+      CLog::Log(LOGDEBUG, "PAPlayer::PreDecodeFile - Failed to decode %s ahead", CURL::GetRedacted(file.GetDynPath()).c_str());
+    si->m_decoder.Destroy();
+    delete si;
+  }
+  else
+  {
+    CLog::Log(LOGDEBUG, "PAPlayer::PreDecodeFile - Decoded %s ahead (open %u ms, decode %u ms%s)",
+              CURL::GetRedacted(file.GetDynPath()).c_str(), si->m_openTime, si->m_decodeTime,
+              si->m_preDecodeStop ? ", stopped when queued" : "");
+    m_preDecoded.push_back(si);
+  }
+  if (owned)
+    m_preDecoding.erase(it);
+}
+
+PAPlayer::StreamInfo* PAPlayer::TakePreDecodedStream(const CFileItem &file)
+{
+  const std::string key = PreDecodeKey(file);
+
+  CSingleLock lock(m_streamsLock);
+  auto it = m_preDecoding.find(key);
+  if (it != m_preDecoding.end() && !it->second.m_stream)
+  {
+    // not started yet, opening it right away is faster than waiting for a worker
+    CancelPreDecodeJob(it->second);
+    m_preDecoding.erase(it);
+  }
+  else if (it != m_preDecoding.end())
+  {
+    // take over the opened decoder with what has been decoded so far, the wait
+    // is at most for the open, which would have to be done again otherwise
+    it->second.m_stream->m_preDecodeStop = true;
+    while (m_preDecoding.find(key) != m_preDecoding.end() && !m_bStop)
+    {
+      lock.Leave();
+      m_jobEvent.WaitMSec(100);
+      lock.Enter();
+    }
+  }
+
+  for (auto si = m_preDecoded.begin(); si != m_preDecoded.end(); ++si)
+  {
+    if (PreDecodeKey((*si)->m_fileItem) == key)
+    {
+      StreamInfo *stream = *si;
+      m_preDecoded.erase(si);
+      return stream;
+    }
+  }
+  return nullptr;
+}
+
+void PAPlayer::ClosePreDecodedStreams()
+{
+  CSingleLock lock(m_streamsLock);
+  for (const auto &it : m_preDecoding)
+    CancelPreDecodeJob(it.second);
+  m_preDecoding.clear();
+  while (!m_preDecoded.empty())
+  {
+    StreamInfo* si = m_preDecoded.front();
+    m_preDecoded.pop_front();
+
+    si->m_decoder.Destroy();
+    delete si;
+  }
+}
+
+// Always called with the lock held on m_streamsLock
+void PAPlayer::CancelPreDecodeJob(const PreDecodeJob &job)
+{
+  if (job.m_stream)
+  {
+    // running, it stops reading and completes as usual
+    job.m_stream->m_preDecodeStop = true;
+    return;
+  }
+
+  // still queued, where it could wait long for a low priority worker. A job that was
+  // picked up already finds its entry gone and completes right away.
+  if (CJobManager::GetInstance().CancelQueuedJob(job.m_jobId))
+  {
+    m_jobCounter--;
+    m_jobEvent.Set();
+  }
+}
+
 bool PAPlayer::QueueNextFileEx(const CFileItem &file, bool fadeIn)
 {
   if (m_currentStream)
@@ -321,9 +557,16 @@ bool PAPlayer::QueueNextFileEx(const CFileItem &file, bool fadeIn)
     m_currentStream->m_nextFileItem.reset();
   }
 
-  StreamInfo *si = new StreamInfo();
-  si->m_fileItem = file;
-  if (!si->m_decoder.Create(file, si->m_fileItem.m_lStartOffset))
+  const unsigned int start = XbmcThreads::SystemClockMillis();
+  StreamInfo *si = TakePreDecodedStream(file);
+  if (si)
+    si->m_fileItem = file;
+  else
+  {
+    si = new StreamInfo();
+    si->m_fileItem = file;
+  }
+  if (!si->m_preDecoded && !si->m_decoder.Create(file, si->m_fileItem.m_lStartOffset))
   {
     CLog::Log(LOGWARNING, "PAPlayer::QueueNextFileEx - Failed to create the decoder");
 
@@ -417,6 +660,14 @@ bool PAPlayer::QueueNextFileEx(const CFileItem &file, bool fadeIn)
     return false;
   }
 
+  const unsigned int prepareTime = XbmcThreads::SystemClockMillis() - start;
+  if (si->m_preDecoded)
+    CLog::Log(LOGDEBUG, "PAPlayer::QueueNextFileEx - Prepared in %u ms, decoded ahead (open %u ms, decode %u ms)",
+              prepareTime, si->m_openTime, si->m_decodeTime);
+  else
+    CLog::Log(LOGDEBUG, "PAPlayer::QueueNextFileEx - Prepared in %u ms", prepareTime);
+  CServiceBroker::GetDataCacheCore().SetAudioPrepareTime(prepareTime);
+
   /* add the stream to the list */
   CSingleLock lock(m_streamsLock);
   m_streams.push_back(si);
@@ -517,6 +768,9 @@ bool PAPlayer::CloseFile(bool reopen)
   /* wait for the thread to terminate */
   StopThread(true);//true - wait for end of thread
 
+  // pre-decoding jobs which haven't started are dropped, running ones stop soon
+  ClosePreDecodedStreams();
+
   // wait for any pending jobs to complete
   {
     CSingleLock lock(m_streamsLock);
@@ -527,6 +781,7 @@ bool PAPlayer::CloseFile(bool reopen)
       lock.Enter();
     }
   }
+  ClosePreDecodedStreams();
 
   return true;
 }
@@ -10,6 +10,8 @@
 
 #include <atomic>
 #include <list>
+#include <map>
+#include <string>
 #include <vector>
 
 #include "FileItem.h"
@@ -108,6 +110,11 @@ private:
 
     bool m_isSlaved;                     /* true if the stream has been slaved to another */
     bool m_waitOnDrain;                  /* wait for stream being drained in AE */
+
+    bool m_preDecoded = false;           /* if the decoder was opened and filled ahead of time */
+    unsigned int m_openTime = 0;         /* ms it took to open the decoder */
+    unsigned int m_decodeTime = 0;       /* ms it took to fill the decoder's buffer */
+    std::atomic<bool> m_preDecodeStop{false}; /* stop decoding ahead, the file has been queued or skipped */
   };
 
   typedef std::list<StreamInfo*> StreamList;
@@ -127,6 +134,13 @@ private:
   CCriticalSection    m_streamsLock;         /* lock for the stream list */
   StreamList          m_streams;             /* playing streams */
   StreamList          m_finishing;           /* finishing streams */
+  StreamList          m_preDecoded;          /* upcoming streams with an opened and filled decoder */
+  struct PreDecodeJob
+  {
+    unsigned int m_jobId = 0;            /* id of the job in the job manager */
+    StreamInfo *m_stream = nullptr;      /* the stream once the job has started */
+  };
+  std::map<std::string, PreDecodeJob> m_preDecoding; /* upcoming files queued for pre-decoding */
   int                 m_jobCounter;
   CEvent              m_jobEvent;
   int64_t             m_newForcedPlayerTime;
@@ -134,6 +148,11 @@ private:
   std::unique_ptr<CProcessInfo> m_processInfo;
 
   bool QueueNextFileEx(const CFileItem &file, bool fadeIn);
+  void PreDecodeUpcomingFiles(const CFileItem &file, int offset);
+  void PreDecodeFile(const CFileItem &file, unsigned int bufferSize);
+  StreamInfo* TakePreDecodedStream(const CFileItem &file);
+  void ClosePreDecodedStreams();
+  void CancelPreDecodeJob(const PreDecodeJob &job);
   void SoftStart(bool wait = false);
   void SoftStop(bool wait = false, bool close = true);
   void CloseAllStreams(bool fade = true);
@@ -485,7 +485,9 @@ bool CDatabase::Connect(const std::string &dbName, const DatabaseSettings &dbSet
   // create the appropriate database structure
   if (dbSettings.type == "sqlite3")
   {
-    m_pDB.reset( new SqliteDatabase() ) ;
+    SqliteDatabase *sqlite = new SqliteDatabase();
+    sqlite->setPoolSize(g_advancedSettings.m_sqliteConnectionPoolSize);
+    m_pDB.reset(sqlite);
   }
 #if defined(HAS_MYSQL) || defined(HAS_MARIADB)
   else if (dbSettings.type == "mysql")
@@ -552,9 +554,13 @@ bool CDatabase::Connect(const std::string &dbName, const DatabaseSettings &dbSet
     // sqlite3 post connection operations
     if (dbSettings.type == "sqlite3")
     {
-      m_pDS->exec("PRAGMA cache_size=4096\n");
+      // negative cache sizes are in KiB rather than pages
+      m_pDS->exec(StringUtils::Format("PRAGMA cache_size=-%i\n", g_advancedSettings.m_sqliteCacheSizeKB));
       m_pDS->exec("PRAGMA synchronous='NORMAL'\n");
       m_pDS->exec("PRAGMA count_changes='OFF'\n");
+      m_pDS->exec("PRAGMA temp_store=MEMORY\n");
+      m_pDS->exec("PRAGMA mmap_size=" + std::to_string(static_cast<int64_t>(g_advancedSettings.m_sqliteMmapSizeMB) * 1024 * 1024) + "\n");
+      SetJournalMode(g_advancedSettings.m_sqliteWALMode ? "WAL" : "DELETE");
     }
   }
   catch (DbErrors &error)
@@ -569,6 +575,21 @@ bool CDatabase::Connect(const std::string &dbName, const DatabaseSettings &dbSet
   return true;
 }
 
+void CDatabase::SetJournalMode(const std::string &mode)
+{
+  // Switching journal modes needs exclusive access to the database file, so this fails
+  // while other connections are active. The mode is persistent, so a later Open() will
+  // take care of it.
+  try
+  {
+    m_pDS->exec("PRAGMA journal_mode=" + mode + "\n");
+  }
+  catch (DbErrors &error)
+  {
+    CLog::Log(LOGDEBUG, "%s unable to switch %s to journal mode %s: %s", __FUNCTION__, GetBaseDBName(), mode.c_str(), error.getMsg());
+  }
+}
+
 int CDatabase::GetDBVersion()
 {
   m_pDS->query("SELECT idVersion FROM version\n");
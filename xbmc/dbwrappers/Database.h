@@ -233,6 +233,11 @@ protected:
 
   int GetDBVersion();
 
+  /*! \brief Set the sqlite journal mode (e.g. WAL) of the open database.
+   Failures are logged and otherwise ignored.
+   */
+  void SetJournalMode(const std::string &mode);
+
   bool BuildSQL(const std::string &strQuery, const Filter &filter, std::string &strSQL);
 
   bool m_sqlite; ///< \brief whether we use sqlite (defaults to true)
@@ -0,0 +1,156 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "DatabaseStatementStats.h"
+#include "threads/SingleLock.h"
+#include "utils/log.h"
+#include "utils/StringUtils.h"
+#include "utils/TimeUtils.h"
+
+#include <algorithm>
+#include <ctype.h>
+
+CDatabaseStatementStats& CDatabaseStatementStats::GetInstance()
+{
+  static CDatabaseStatementStats sStatementStats;
+  return sStatementStats;
+}
+
+void CDatabaseStatementStats::Record(const std::string &sql, uint64_t durationUs)
+{
+  std::string statement = Normalize(sql);
+
+  CSingleLock lock(m_critSection);
+  auto it = m_statements.find(statement);
+  if (it == m_statements.end())
+  {
+    // keep memory bounded, statements showing up late are accounted for together
+    if (m_statements.size() >= MAX_STATEMENTS)
+      statement = "<other>";
+    it = m_statements.insert(std::make_pair(statement, Entry())).first;
+    it->second.statement = statement;
+  }
+
+  Entry &entry = it->second;
+  entry.count++;
+  entry.totalUs += durationUs;
+  entry.maxUs = std::max(entry.maxUs, durationUs);
+
+  unsigned int thresholdMs = m_slowThresholdMs;
+  lock.Leave();
+
+  if (thresholdMs && durationUs >= thresholdMs * 1000ULL)
+    CLog::Log(LOGWARNING, "Slow database statement took %u ms: %s",
+              static_cast<unsigned int>(durationUs / 1000), statement.c_str());
+}
+
+std::vector<CDatabaseStatementStats::Entry> CDatabaseStatementStats::GetTop(size_t count) const
+{
+  std::vector<Entry> entries;
+  {
+    CSingleLock lock(m_critSection);
+    entries.reserve(m_statements.size());
+    for (const auto &it : m_statements)
+      entries.push_back(it.second);
+  }
+
+  std::sort(entries.begin(), entries.end(), [](const Entry &lhs, const Entry &rhs)
+  {
+    return lhs.totalUs > rhs.totalUs;
+  });
+  if (entries.size() > count)
+    entries.resize(count);
+  return entries;
+}
+
+void CDatabaseStatementStats::Reset()
+{
+  CSingleLock lock(m_critSection);
+  m_statements.clear();
+}
+
+void CDatabaseStatementStats::SetSlowThreshold(unsigned int milliseconds)
+{
+  CSingleLock lock(m_critSection);
+  m_slowThresholdMs = milliseconds;
+}
+
+void CDatabaseStatementStats::LogSummary(size_t count) const
+{
+  std::vector<Entry> entries = GetTop(count);
+  if (entries.empty())
+    return;
+
+  CLog::Log(LOGNOTICE, "Database statements by total execution time:");
+  for (const auto &entry : entries)
+  {
+    CLog::Log(LOGNOTICE, "  total %.1f ms, %llu calls, avg %.2f ms, max %.1f ms: %s",
+              entry.totalUs / 1000.0, static_cast<unsigned long long>(entry.count),
+              entry.totalUs / 1000.0 / entry.count, entry.maxUs / 1000.0,
+              entry.statement.c_str());
+  }
+}
+
+std::string CDatabaseStatementStats::Normalize(const std::string &sql)
+{
+  std::string result;
+  result.reserve(sql.size());
+
+  for (size_t i = 0; i < sql.size(); ++i)
+  {
+    char c = sql[i];
+    if (c == '\'' || c == '"')
+    { // string literal, quotes are escaped by doubling them
+      for (++i; i < sql.size(); ++i)
+      {
+        if (sql[i] == c)
+        {
+          if (i + 1 < sql.size() && sql[i + 1] == c)
+            ++i;
+          else
+            break;
+        }
+      }
+      result += '?';
+    }
+    else if (isdigit(static_cast<unsigned char>(c)) &&
+             (result.empty() || (!isalnum(static_cast<unsigned char>(result.back())) && result.back() != '_')))
+    { // numeric literal
+      while (i + 1 < sql.size() && (isdigit(static_cast<unsigned char>(sql[i + 1])) || sql[i + 1] == '.'))
+        ++i;
+      result += '?';
+    }
+    else if (isspace(static_cast<unsigned char>(c)))
+    {
+      if (!result.empty() && result.back() != ' ')
+        result += ' ';
+    }
+    else
+      result += c;
+  }
+
+  // collapse lists of values, e.g. IN (?, ?, ?)
+  StringUtils::Replace(result, "?, ", "?,");
+  while (StringUtils::Replace(result, "?,?", "?") > 0)
+    ;
+
+  StringUtils::TrimRight(result);
+  return result;
+}
+
+CDatabaseStatementTimer::CDatabaseStatementTimer(const std::string &sql)
+  : m_sql(sql)
+  , m_start(CurrentHostCounter())
+{
+}
+
+CDatabaseStatementTimer::~CDatabaseStatementTimer()
+{
+  int64_t elapsed = CurrentHostCounter() - m_start;
+  CDatabaseStatementStats::GetInstance().Record(m_sql, elapsed * 1000000 / CurrentHostFrequency());
+}
@@ -0,0 +1,86 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+
+#include <map>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/*!
+ \brief Aggregated execution times of database statements.
+
+ Statements are grouped by their normalized form (literals replaced by '?'), so that
+ e.g. all "SELECT * FROM movie_view WHERE idMovie=..." lookups end up in the same bucket.
+ Statements taking longer than the slow query threshold are logged as they happen.
+ */
+class CDatabaseStatementStats
+{
+public:
+  struct Entry
+  {
+    std::string statement;
+    uint64_t count = 0;
+    uint64_t totalUs = 0;
+    uint64_t maxUs = 0;
+  };
+
+  static CDatabaseStatementStats& GetInstance();
+
+  /*! \brief Record an execution of a statement.
+   \param sql the statement as executed
+   \param durationUs execution time in microseconds
+   */
+  void Record(const std::string &sql, uint64_t durationUs);
+
+  /*! \brief Get the statements with the highest total execution time.
+   \param count the maximum number of statements to return
+   \return the statements, sorted by descending total execution time
+   */
+  std::vector<Entry> GetTop(size_t count) const;
+
+  void Reset();
+
+  /*! \brief Set the execution time above which a statement is logged, 0 to disable.
+   */
+  void SetSlowThreshold(unsigned int milliseconds);
+
+  /*! \brief Write the statements with the highest total execution time to the log.
+   */
+  void LogSummary(size_t count) const;
+
+  /*! \brief Replace string and numeric literals of a statement by '?' and collapse whitespace.
+   */
+  static std::string Normalize(const std::string &sql);
+
+private:
+  CDatabaseStatementStats() = default;
+
+  static const size_t MAX_STATEMENTS = 512;
+
+  std::map<std::string, Entry> m_statements;
+  unsigned int m_slowThresholdMs = 0;
+  mutable CCriticalSection m_critSection;
+};
+
+/*!
+ \brief Records the lifetime of the object as execution time of a statement.
+ */
+class CDatabaseStatementTimer
+{
+public:
+  explicit CDatabaseStatementTimer(const std::string &sql);
+  ~CDatabaseStatementTimer();
+
+private:
+  const std::string &m_sql;
+  int64_t m_start;
+};
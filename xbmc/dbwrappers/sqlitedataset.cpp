@@ -11,9 +11,14 @@
  */
 
 #include <iostream>
+#include <map>
 #include <string>
+#include <vector>
 
 #include "sqlitedataset.h"
+#include "DatabaseStatementStats.h"
+#include "threads/CriticalSection.h"
+#include "threads/SingleLock.h"
 #include "utils/log.h"
 #include "utils/URIUtils.h"
 
@@ -66,12 +71,57 @@ static int busy_callback(void*, int busyCount)
   return 1;
 }
 
+//************* Connection pool ***************
+// Idle connections per database file. Opening a connection means opening the file and
+// parsing the schema again, and drops the page cache, so connections of closed database
+// objects are kept around for the next Open().
+
+static CCriticalSection pool_section;
+static std::map<std::string, std::vector<sqlite3*> > pool;
+
+static sqlite3* pool_take(const std::string &path)
+{
+  CSingleLock lock(pool_section);
+  std::map<std::string, std::vector<sqlite3*> >::iterator it = pool.find(path);
+  if (it == pool.end() || it->second.empty())
+    return NULL;
+  sqlite3 *handle = it->second.back();
+  it->second.pop_back();
+  return handle;
+}
+
+static bool pool_put(const std::string &path, sqlite3 *handle, unsigned int size)
+{
+  // only connections in a clean state may be reused
+  if (!sqlite3_get_autocommit(handle) || sqlite3_next_stmt(handle, NULL) != NULL)
+    return false;
+
+  CSingleLock lock(pool_section);
+  std::vector<sqlite3*> &handles = pool[path];
+  if (handles.size() >= size)
+    return false;
+  handles.push_back(handle);
+  return true;
+}
+
+static void pool_close(const std::string &path)
+{
+  CSingleLock lock(pool_section);
+  std::map<std::string, std::vector<sqlite3*> >::iterator it = pool.find(path);
+  if (it == pool.end())
+    return;
+  for (size_t i = 0; i < it->second.size(); i++)
+    sqlite3_close(it->second[i]);
+  pool.erase(it);
+}
+
 //************* SqliteDatabase implementation ***************
 
 SqliteDatabase::SqliteDatabase() {
 
   active = false;
   _in_transaction = false;    // for transaction
+  pool_size = 0;
 
   error = "Unknown database error";//S_NO_CONNECTION;
   host = "localhost";
@@ -197,6 +247,13 @@ int SqliteDatabase::connect(bool create) {
   try
   {
     disconnect();
+
+    if (pool_size > 0 && (conn = pool_take(db_fullpath)) != NULL)
+    {
+      active = true;
+      return DB_CONNECTION_OK;
+    }
+
     int flags = SQLITE_OPEN_READWRITE;
     if (create)
       flags |= SQLITE_OPEN_CREATE;
@@ -250,11 +307,27 @@ bool SqliteDatabase::exists(void)
 }
 
 void SqliteDatabase::disconnect(void) {
+  close_connection(true);
+}
+
+void SqliteDatabase::close_connection(bool reuse) {
   if (active == false) return;
-  sqlite3_close(conn);
+  if (!reuse || pool_size == 0 || !pool_put(URIUtils::AddFileToFolder(host, db), conn, pool_size))
+    sqlite3_close(conn);
   active = false;
 }
 
+void SqliteDatabase::closePooledConnections() {
+  std::vector<std::string> paths;
+  {
+    CSingleLock lock(pool_section);
+    for (std::map<std::string, std::vector<sqlite3*> >::const_iterator it = pool.begin(); it != pool.end(); ++it)
+      paths.push_back(it->first);
+  }
+  for (size_t i = 0; i < paths.size(); i++)
+    pool_close(paths[i]);
+}
+
 int SqliteDatabase::create() {
   return connect(true);
 }
@@ -349,7 +422,8 @@ int SqliteDatabase::drop_analytics(void) {
 
 int SqliteDatabase::drop() {
   if (active == false) throw DbErrors("Can't drop database: no active connection...");
-  disconnect();
+  close_connection(false);
+  pool_close(URIUtils::AddFileToFolder(host, db));
   if (!unlink(db.c_str())) {
      throw DbErrors("Can't drop database: can't unlink the file %s,\nError: %s",db.c_str(),strerror(errno));
      }
@@ -647,6 +721,7 @@ int SqliteDataset::exec(const std::string &sql) {
       qry = qry.substr(0, pos);
   }
 
+  CDatabaseStatementTimer timer(qry);
   if((res = db->setErr(sqlite3_exec(handle(),qry.c_str(),&callback,&exec_res,&errmsg),qry.c_str())) == SQLITE_OK)
     return res;
   else
@@ -674,6 +749,7 @@ bool SqliteDataset::query(const std::string &query) {
 
   close();
 
+  CDatabaseStatementTimer timer(query);
   sqlite3_stmt *stmt = NULL;
   if (db->setErr(sqlite3_prepare_v2(handle(),query.c_str(),-1,&stmt, NULL),query.c_str()) != SQLITE_OK)
     throw DbErrors(db->getErrorMsg());
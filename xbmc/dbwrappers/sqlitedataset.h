@@ -28,6 +28,10 @@ protected:
   sqlite3 *conn;
   bool _in_transaction;
   int last_err;
+  unsigned int pool_size;
+
+/* closes the connection, or hands it to the connection pool if reuse is allowed */
+  void close_connection(bool reuse);
 
 public:
 /* default constructor */
@@ -80,6 +84,11 @@ public:
 
   bool in_transaction() override {return _in_transaction;};
 
+/* sets the number of idle connections per database file kept open for reuse (0 disables pooling) */
+  void setPoolSize(unsigned int size) { pool_size = size; }
+/* closes all idle pooled connections */
+  static void closePooledConnections();
+
 };
 
 
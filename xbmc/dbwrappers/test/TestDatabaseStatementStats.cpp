@@ -0,0 +1,44 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "dbwrappers/DatabaseStatementStats.h"
+
+#include "gtest/gtest.h"
+
+TEST(TestDatabaseStatementStats, Normalize)
+{
+  EXPECT_EQ("SELECT * FROM movie_view WHERE idMovie=?",
+            CDatabaseStatementStats::Normalize("SELECT * FROM movie_view WHERE idMovie=42\n"));
+  EXPECT_EQ("SELECT idPath FROM path WHERE strPath=?",
+            CDatabaseStatementStats::Normalize("SELECT idPath FROM path WHERE strPath='smb://nas/it''s/'"));
+  EXPECT_EQ("DELETE FROM files WHERE idFile IN (?)",
+            CDatabaseStatementStats::Normalize("DELETE FROM files WHERE idFile IN (1, 2,3,  4)"));
+  EXPECT_EQ("SELECT c00, c12 FROM episode WHERE c12 > ?",
+            CDatabaseStatementStats::Normalize("SELECT  c00,\tc12 FROM episode WHERE c12 > 1.5"));
+}
+
+TEST(TestDatabaseStatementStats, Record)
+{
+  CDatabaseStatementStats &stats = CDatabaseStatementStats::GetInstance();
+  stats.Reset();
+
+  stats.Record("SELECT * FROM song WHERE idSong=1", 100);
+  stats.Record("SELECT * FROM song WHERE idSong=2", 300);
+  stats.Record("SELECT * FROM album", 250);
+
+  std::vector<CDatabaseStatementStats::Entry> top = stats.GetTop(10);
+  ASSERT_EQ(2u, top.size());
+  EXPECT_EQ("SELECT * FROM song WHERE idSong=?", top[0].statement);
+  EXPECT_EQ(2u, top[0].count);
+  EXPECT_EQ(400u, top[0].totalUs);
+  EXPECT_EQ(300u, top[0].maxUs);
+  EXPECT_EQ(1u, stats.GetTop(1).size());
+
+  stats.Reset();
+  EXPECT_TRUE(stats.GetTop(10).empty());
+}
@@ -13,6 +13,7 @@
 #include "commons/Exception.h"
 #include "FileItem.h"
 #include "DirectoryCache.h"
+#include "File.h"
 #include "settings/Settings.h"
 #include "utils/log.h"
 #include "utils/Job.h"
@@ -20,15 +21,47 @@
 #include "Application.h"
 #include "guilib/GUIWindowManager.h"
 #include "dialogs/GUIDialogBusy.h"
+#include "threads/IRunnable.h"
 #include "threads/SingleLock.h"
+#include "threads/Thread.h"
 #include "utils/URIUtils.h"
 #include "URL.h"
 #include "PasswordManager.h"
 
+#include <algorithm>
+#include <atomic>
+
 using namespace XFILE;
 
 #define TIME_TO_BUSY_DIALOG 500
 
+namespace
+{
+class CStatRunner : public IRunnable
+{
+public:
+  CStatRunner(const std::vector<std::string> &paths, std::vector<int64_t> &times)
+    : m_paths(paths)
+    , m_times(times)
+  {}
+
+  void Run() override
+  {
+    for (size_t i = m_next++; i < m_paths.size(); i = m_next++)
+    {
+      struct __stat64 buffer;
+      if (CFile::Stat(m_paths[i], &buffer) == 0)
+        m_times[i] = buffer.st_mtime ? buffer.st_mtime : buffer.st_ctime;
+    }
+  }
+
+private:
+  const std::vector<std::string> &m_paths;
+  std::vector<int64_t> &m_times;
+  std::atomic<size_t> m_next{0};
+};
+}
+
 class CGetDirectory
 {
 private:
@@ -457,3 +490,24 @@ void CDirectory::FilterFileDirectories(CFileItemList &items, const std::string &
     }
   }
 }
+
+void CDirectory::GetModificationTimes(const std::vector<std::string> &paths,
+                                      std::vector<int64_t> &times,
+                                      unsigned int maxThreads)
+{
+  times.assign(paths.size(), 0);
+
+  CStatRunner runner(paths, times);
+  size_t threads = std::min<size_t>(maxThreads, paths.size());
+  std::vector<std::unique_ptr<CThread>> workers;
+  for (size_t i = 1; i < threads; ++i)
+  {
+    workers.emplace_back(new CThread(&runner, "DirectoryStat"));
+    workers.back()->Create();
+  }
+
+  // the calling thread takes its share, then waits for the workers to drain the rest
+  runner.Run();
+  for (auto &worker : workers)
+    worker->StopThread(true);
+}
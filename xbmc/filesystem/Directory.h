@@ -10,7 +10,9 @@
 
 #include "IDirectory.h"
 #include <memory>
+#include <stdint.h>
 #include <string>
+#include <vector>
 
 namespace XFILE
 {
@@ -77,5 +79,17 @@ public:
   */
   static void FilterFileDirectories(CFileItemList &items, const std::string &mask,
                                     bool expandImages=false);
+
+  /*! \brief Retrieve the modification times of a set of directories, e.g. one level of a tree.
+   The stat calls are spread over up to maxThreads threads, which hides the per-call
+   round-trip on network filesystems.
+   \param paths the directories to stat
+   \param times [out] modification time per path (creation time if no modification time is
+   available), 0 if the path could not be stat'ed
+   \param maxThreads maximum number of concurrent stat calls
+  */
+  static void GetModificationTimes(const std::vector<std::string> &paths,
+                                   std::vector<int64_t> &times,
+                                   unsigned int maxThreads = 8);
 };
 }
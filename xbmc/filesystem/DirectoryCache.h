@@ -61,7 +61,7 @@ namespace XFILE
     typedef std::map<std::string, CDir*>::const_iterator ciCache;
     void Delete(iCache i);
 
-    mutable CCriticalSection m_cs;
+    mutable CCriticalSection m_cs{"CDirectoryCache"};
 
     unsigned int m_accessCounter;
 
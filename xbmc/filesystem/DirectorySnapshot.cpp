@@ -0,0 +1,213 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "DirectorySnapshot.h"
+#include "Directory.h"
+#include "File.h"
+#include "FileItem.h"
+#include "threads/SingleLock.h"
+#include "utils/log.h"
+#include "utils/XBMCTinyXML.h"
+
+#include <stdlib.h>
+
+using namespace XFILE;
+
+CDirectorySnapshot::CDirectorySnapshot(std::string file)
+  : m_file(std::move(file))
+{
+}
+
+bool CDirectorySnapshot::Load()
+{
+  CSingleLock lock(m_critSection);
+  Clear();
+
+  if (!CFile::Exists(m_file))
+    return false;
+
+  CXBMCTinyXML doc;
+  if (!doc.LoadFile(m_file))
+  {
+    CLog::Log(LOGERROR, "%s - Unable to load: %s, Line %d\n%s",
+      __FUNCTION__, m_file.c_str(), doc.ErrorRow(), doc.ErrorDesc());
+    return false;
+  }
+
+  const TiXmlElement *root = doc.RootElement();
+  if (!root || root->ValueStr() != "directorysnapshot")
+    return false;
+
+  for (const TiXmlElement *directory = root->FirstChildElement("directory"); directory;
+       directory = directory->NextSiblingElement("directory"))
+  {
+    const char *path = directory->Attribute("path");
+    const char *mtime = directory->Attribute("mtime");
+    if (!path || !mtime)
+      continue;
+
+    CEntry entry;
+    entry.mtime = strtoll(mtime, nullptr, 10);
+    if (const char *fingerprint = directory->Attribute("fingerprint"))
+      entry.fingerprint = fingerprint;
+    directory->QueryIntAttribute("count", &entry.count);
+
+    for (const TiXmlElement *subdir = directory->FirstChildElement("subdir"); subdir;
+         subdir = subdir->NextSiblingElement("subdir"))
+    {
+      if (subdir->FirstChild())
+        entry.subdirs.push_back(subdir->FirstChild()->ValueStr());
+    }
+    m_entries[path] = std::move(entry);
+  }
+
+  CLog::Log(LOGDEBUG, "%s - loaded %u directories from %s",
+    __FUNCTION__, static_cast<unsigned int>(m_entries.size()), m_file.c_str());
+  return true;
+}
+
+bool CDirectorySnapshot::Save()
+{
+  CSingleLock lock(m_critSection);
+  if (!m_changed)
+    return true;
+
+  CXBMCTinyXML doc;
+  TiXmlElement rootElement("directorysnapshot");
+  TiXmlNode *root = doc.InsertEndChild(rootElement);
+  if (!root)
+    return false;
+
+  for (const auto &it : m_entries)
+  {
+    TiXmlElement directory("directory");
+    directory.SetAttribute("path", it.first.c_str());
+    directory.SetAttribute("mtime", std::to_string(it.second.mtime).c_str());
+    if (!it.second.fingerprint.empty())
+      directory.SetAttribute("fingerprint", it.second.fingerprint.c_str());
+    if (it.second.count)
+      directory.SetAttribute("count", it.second.count);
+
+    for (const auto &subdir : it.second.subdirs)
+    {
+      TiXmlElement subdirElement("subdir");
+      TiXmlText value(subdir);
+      subdirElement.InsertEndChild(value);
+      directory.InsertEndChild(subdirElement);
+    }
+    root->InsertEndChild(directory);
+  }
+
+  if (!doc.SaveFile(m_file))
+  {
+    CLog::Log(LOGERROR, "%s - Unable to save: %s", __FUNCTION__, m_file.c_str());
+    return false;
+  }
+
+  m_changed = false;
+  return true;
+}
+
+void CDirectorySnapshot::Clear()
+{
+  CSingleLock lock(m_critSection);
+  m_entries.clear();
+  m_modificationTimes.clear();
+  m_changed = false;
+}
+
+bool CDirectorySnapshot::GetUnchanged(const std::string &path, int64_t mtime, CEntry &entry) const
+{
+  if (!mtime)
+    return false;
+
+  CSingleLock lock(m_critSection);
+  auto it = m_entries.find(path);
+  if (it == m_entries.end() || it->second.mtime != mtime)
+    return false;
+
+  entry = it->second;
+  return true;
+}
+
+void CDirectorySnapshot::Set(const std::string &path, CEntry entry)
+{
+  CSingleLock lock(m_critSection);
+  m_entries[path] = std::move(entry);
+  m_changed = true;
+}
+
+void CDirectorySnapshot::Remove(const std::string &path)
+{
+  CSingleLock lock(m_critSection);
+  if (m_entries.erase(path))
+    m_changed = true;
+}
+
+void CDirectorySnapshot::PrefetchModificationTimes(const std::vector<std::string> &paths)
+{
+  std::vector<int64_t> times;
+  CDirectory::GetModificationTimes(paths, times);
+
+  CSingleLock lock(m_critSection);
+  for (size_t i = 0; i < paths.size(); ++i)
+    m_modificationTimes[paths[i]] = times[i];
+}
+
+int64_t CDirectorySnapshot::GetModificationTime(const std::string &path) const
+{
+  {
+    CSingleLock lock(m_critSection);
+    auto it = m_modificationTimes.find(path);
+    if (it != m_modificationTimes.end())
+      return it->second;
+  }
+
+  std::vector<int64_t> times;
+  CDirectory::GetModificationTimes({path}, times, 1);
+
+  CSingleLock lock(m_critSection);
+  m_modificationTimes[path] = times[0];
+  return times[0];
+}
+
+bool CDirectorySnapshot::GetRecursiveModificationTimes(const std::string &path,
+                                                       std::vector<std::pair<std::string, int64_t>> &dirs)
+{
+  std::vector<std::string> level{path};
+  while (!level.empty())
+  {
+    PrefetchModificationTimes(level);
+
+    std::vector<std::string> nextLevel;
+    for (const auto &directory : level)
+    {
+      int64_t mtime = GetModificationTime(directory);
+      if (!mtime)
+        return false;
+      dirs.emplace_back(directory, mtime);
+
+      CEntry entry;
+      if (!GetUnchanged(directory, mtime, entry))
+      {
+        CFileItemList items;
+        CDirectory::GetDirectory(directory, items, "", DIR_FLAG_NO_FILE_DIRS | DIR_FLAG_NO_FILE_INFO);
+        entry.mtime = mtime;
+        for (const auto &item : items)
+        {
+          if (item->m_bIsFolder && !item->IsPath(".."))
+            entry.subdirs.push_back(item->GetPath());
+        }
+        Set(directory, entry);
+      }
+      nextLevel.insert(nextLevel.end(), entry.subdirs.begin(), entry.subdirs.end());
+    }
+    level.swap(nextLevel);
+  }
+  return true;
+}
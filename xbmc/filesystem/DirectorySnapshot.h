@@ -0,0 +1,103 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+
+#include <map>
+#include <stdint.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace XFILE
+{
+/*!
+ \ingroup filesystem
+ \brief Persistent record of the directories seen by a library scan.
+
+ For every directory the snapshot keeps the modification time it had when it was last
+ listed, the fingerprint (path hash) the scanner computed for its content, the number of
+ media files and its subdirectories. While the modification time of a directory is
+ unchanged its entries have not been added, removed or renamed, so a scanner can skip
+ listing it and descend into the recorded subdirectories straight away.
+
+ Modification times are looked up through a per-scan cache that can be primed for a whole
+ level of the tree at once, see PrefetchModificationTimes().
+ */
+class CDirectorySnapshot
+{
+public:
+  struct CEntry
+  {
+    int64_t mtime = 0;
+    std::string fingerprint;
+    int count = 0;
+    std::vector<std::string> subdirs;
+  };
+
+  /*! \brief Create a snapshot stored in the given file.
+   \param file the file the snapshot is loaded from and saved to, e.g. special://database/...
+   */
+  explicit CDirectorySnapshot(std::string file);
+
+  /*! \brief Load the snapshot from disk, replacing any entries held in memory.
+   \return true if the file was loaded, false if it does not exist or could not be parsed.
+   */
+  bool Load();
+
+  /*! \brief Write the snapshot to disk if it was modified since the last Load()/Save().
+   \return true on success or if there was nothing to write.
+   */
+  bool Save();
+
+  /*! \brief Drop all entries and cached modification times.
+   */
+  void Clear();
+
+  /*! \brief Fetch the entry of a directory if its recorded modification time matches.
+   \param path the directory
+   \param mtime the current modification time of the directory
+   \param entry [out] the recorded entry
+   \return true if an entry with a matching (non-zero) modification time exists.
+   */
+  bool GetUnchanged(const std::string &path, int64_t mtime, CEntry &entry) const;
+
+  void Set(const std::string &path, CEntry entry);
+  void Remove(const std::string &path);
+
+  /*! \brief Stat the given directories in parallel and cache the results for
+   GetModificationTime().
+   */
+  void PrefetchModificationTimes(const std::vector<std::string> &paths);
+
+  /*! \brief Retrieve the modification time of a directory, using the value cached by
+   PrefetchModificationTimes() if there is one.
+   \return the modification time, 0 if the directory could not be stat'ed.
+   */
+  int64_t GetModificationTime(const std::string &path) const;
+
+  /*! \brief Collect the modification times of a directory and of all directories below it.
+   Each level of the tree is stat'ed in parallel. Only directories whose modification time
+   differs from the snapshot are listed; for the others the recorded subdirectories are used.
+   \param path the root directory
+   \param dirs [out] every directory found along with its modification time
+   \return false if any of the directories could not be stat'ed.
+   */
+  bool GetRecursiveModificationTimes(const std::string &path,
+                                     std::vector<std::pair<std::string, int64_t>> &dirs);
+
+private:
+  std::string m_file;
+  std::map<std::string, CEntry> m_entries;
+  mutable std::map<std::string, int64_t> m_modificationTimes;
+  bool m_changed = false;
+  mutable CCriticalSection m_critSection;
+};
+}
@@ -64,13 +64,9 @@ bool CLibraryDirectory::GetDirectory(const CURL& url, CFileItemList &items)
       }
       else if (type == "folder")
       {
-        std::string path;
-        XMLUtils::GetPath(node, "path", path);
+        std::string path = GetNodePath(node);
         if (!path.empty())
-        {
-          URIUtils::AddSlashAtEnd(path);
           return CDirectory::GetDirectory(path, items, m_strFileMask, m_flags);
-        }
       }
     }
     return false;
@@ -152,6 +148,28 @@ bool CLibraryDirectory::Exists(const CURL& url)
   return !GetNode(url).empty();
 }
 
+std::string CLibraryDirectory::GetFolderPath(const CURL& url)
+{
+  std::string libNode = GetNode(url);
+  if (!URIUtils::HasExtension(libNode, ".xml"))
+    return "";
+
+  TiXmlElement *node = LoadXML(libNode);
+  if (!node || XMLUtils::GetAttribute(node, "type") != "folder")
+    return "";
+
+  return GetNodePath(node);
+}
+
+std::string CLibraryDirectory::GetNodePath(const TiXmlElement *node)
+{
+  std::string path;
+  XMLUtils::GetPath(node, "path", path);
+  if (!path.empty())
+    URIUtils::AddSlashAtEnd(path);
+  return path;
+}
+
 std::string CLibraryDirectory::GetNode(const CURL& url)
 {
   std::string libDir = URIUtils::AddFileToFolder(m_profileManager.GetLibraryFolder(), url.GetHostName() + "/");
@@ -21,6 +21,12 @@ namespace XFILE
     bool GetDirectory(const CURL& url, CFileItemList &items) override;
     bool Exists(const CURL& url) override;
     bool AllowAll() const override { return true; }
+
+    /*! \brief resolve a folder node to the path it links to
+     \param url the library:// path of the node
+     \return the path (with a trailing slash) the node links to, empty if it isn't a visible folder node
+     */
+    std::string GetFolderPath(const CURL& url);
   private:
     /*! \brief parse the given path and return the node corresponding to this path
      \param path the library:// path to parse
@@ -35,6 +41,12 @@ namespace XFILE
      */
     TiXmlElement *LoadXML(const std::string &xmlFile);
 
+    /*! \brief get the path a folder node links to
+     \param node the <node> root element of the folder node
+     \return the path with a trailing slash, empty if the node doesn't link to a path
+     */
+    static std::string GetNodePath(const TiXmlElement *node);
+
     CXBMCTinyXML m_doc;
   };
 }
@@ -16,6 +16,7 @@
 #include "filesystem/FileDirectoryFactory.h"
 #include "music/MusicDatabase.h"
 #include "playlists/SmartPlayList.h"
+#include "playlists/SmartPlaylistCache.h"
 #include "settings/Settings.h"
 #include "utils/SortUtils.h"
 #include "utils/StringUtils.h"
@@ -40,9 +41,28 @@ namespace XFILE
     CSmartPlaylist playlist;
     if (!playlist.Load(url))
       return false;
+
+    // the listing only changes with the library, the playlist itself or the date
+    std::string key;
+    bool useCache = !(m_flags & DIR_FLAG_BYPASS_CACHE) && CServiceBroker::IsServiceManagerUp() &&
+                    playlist.SaveAsJson(key);
+    if (useCache)
+    {
+      key = url.Get() + "\n" + key;
+      if (CServiceBroker::GetSmartPlaylistCache().GetItems(key, items))
+      {
+        items.SetProperty("library.smartplaylist", true);
+        return true;
+      }
+    }
+
     bool result = GetDirectory(playlist, items);
     if (result)
+    {
       items.SetProperty("library.smartplaylist", true);
+      if (useCache)
+        CServiceBroker::GetSmartPlaylistCache().SetItems(key, items);
+    }
 
     return result;
   }
@@ -0,0 +1,79 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "filesystem/Directory.h"
+#include "filesystem/DirectorySnapshot.h"
+#include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
+#include "utils/URIUtils.h"
+
+#include "gtest/gtest.h"
+
+TEST(TestDirectorySnapshot, SaveLoad)
+{
+  std::string file = URIUtils::AddFileToFolder(CSpecialProtocol::TranslatePath("special://temp/"),
+                                               "TestDirectorySnapshot.xml");
+
+  XFILE::CDirectorySnapshot snapshot(file);
+  XFILE::CDirectorySnapshot::CEntry entry;
+  entry.mtime = 1234567890123;
+  entry.fingerprint = "0123456789abcdef";
+  entry.count = 3;
+  entry.subdirs = {"/media/movies/a/", "/media/movies/b & c/"};
+  snapshot.Set("/media/movies/", entry);
+  EXPECT_TRUE(snapshot.Save());
+
+  XFILE::CDirectorySnapshot loaded(file);
+  EXPECT_TRUE(loaded.Load());
+
+  XFILE::CDirectorySnapshot::CEntry result;
+  EXPECT_FALSE(loaded.GetUnchanged("/media/movies/", 1234567890124, result));
+  EXPECT_FALSE(loaded.GetUnchanged("/media/tvshows/", 1234567890123, result));
+  ASSERT_TRUE(loaded.GetUnchanged("/media/movies/", 1234567890123, result));
+  EXPECT_EQ("0123456789abcdef", result.fingerprint);
+  EXPECT_EQ(3, result.count);
+  ASSERT_EQ(2u, result.subdirs.size());
+  EXPECT_EQ("/media/movies/b & c/", result.subdirs[1]);
+
+  loaded.Remove("/media/movies/");
+  EXPECT_FALSE(loaded.GetUnchanged("/media/movies/", 1234567890123, result));
+
+  EXPECT_TRUE(XFILE::CFile::Delete(file));
+}
+
+TEST(TestDirectorySnapshot, RecursiveModificationTimes)
+{
+  std::string root = URIUtils::AddFileToFolder(CSpecialProtocol::TranslatePath("special://temp/"),
+                                               "TestDirectorySnapshot");
+  URIUtils::AddSlashAtEnd(root);
+  std::string level2 = URIUtils::AddFileToFolder(root, "level1", "level2");
+  URIUtils::AddSlashAtEnd(level2);
+  ASSERT_TRUE(XFILE::CDirectory::Create(level2));
+
+  std::vector<int64_t> times;
+  XFILE::CDirectory::GetModificationTimes({root, level2, root + "missing/"}, times);
+  ASSERT_EQ(3u, times.size());
+  EXPECT_NE(0, times[0]);
+  EXPECT_NE(0, times[1]);
+  EXPECT_EQ(0, times[2]);
+
+  XFILE::CDirectorySnapshot snapshot("special://temp/TestDirectorySnapshot.xml");
+  std::vector<std::pair<std::string, int64_t>> dirs;
+  EXPECT_TRUE(snapshot.GetRecursiveModificationTimes(root, dirs));
+  EXPECT_EQ(3u, dirs.size());
+
+  // the second walk is served from the snapshot
+  XFILE::CDirectorySnapshot::CEntry entry;
+  EXPECT_TRUE(snapshot.GetUnchanged(root, dirs[0].second, entry));
+  EXPECT_EQ(1u, entry.subdirs.size());
+  dirs.clear();
+  EXPECT_TRUE(snapshot.GetRecursiveModificationTimes(root, dirs));
+  EXPECT_EQ(3u, dirs.size());
+
+  EXPECT_TRUE(XFILE::CDirectory::RemoveRecursive(root));
+}
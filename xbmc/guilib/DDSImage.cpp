@@ -10,7 +10,10 @@
 #include "DDSImage.h"
 #include "XBTF.h"
 #include "utils/log.h"
+#include <climits>
+#include <cstdlib>
 #include <string.h>
+#include <vector>
 
 #ifndef NO_XBMC_FILESYSTEM
 #include "filesystem/File.h"
@@ -19,6 +22,193 @@ using namespace XFILE;
 #include "SimpleFS.h"
 #endif
 
+namespace
+{
+// mipmap chains are at most this long (a 32768 pixel wide texture)
+const unsigned int MAX_MIPMAP_COUNT = 16;
+
+// reads a 4x4 block of BGRA pixels, repeating the edge pixels of images that aren't a multiple of 4
+void GetBlock(const unsigned char *pixels, unsigned int width, unsigned int height, unsigned int pitch,
+              unsigned int x, unsigned int y, unsigned char block[16][4])
+{
+  for (unsigned int j = 0; j < 4; j++)
+  {
+    const unsigned char *row = pixels + std::min(y + j, height - 1) * pitch;
+    for (unsigned int i = 0; i < 4; i++)
+      memcpy(block[j * 4 + i], row + std::min(x + i, width - 1) * 4, 4);
+  }
+}
+
+uint16_t ToRGB565(const int color[3])
+{
+  return ((color[2] >> 3) << 11) | ((color[1] >> 2) << 5) | (color[0] >> 3);
+}
+
+void FromRGB565(uint16_t value, int color[3])
+{
+  int r = (value >> 11) & 0x1f;
+  int g = (value >> 5) & 0x3f;
+  int b = value & 0x1f;
+  color[0] = (b << 3) | (b >> 2);
+  color[1] = (g << 2) | (g >> 4);
+  color[2] = (r << 3) | (r >> 2);
+}
+
+void WriteLittleEndian(unsigned char *dest, uint64_t value, unsigned int bytes)
+{
+  for (unsigned int i = 0; i < bytes; i++)
+    dest[i] = (value >> (8 * i)) & 0xff;
+}
+
+// compresses the colors of a block using the bounding box of the colors as the end points
+void CompressColorBlock(const unsigned char block[16][4], unsigned char *dest)
+{
+  int minColor[3] = { 255, 255, 255 };
+  int maxColor[3] = { 0, 0, 0 };
+  for (unsigned int i = 0; i < 16; i++)
+  {
+    for (unsigned int c = 0; c < 3; c++)
+    {
+      minColor[c] = std::min(minColor[c], static_cast<int>(block[i][c]));
+      maxColor[c] = std::max(maxColor[c], static_cast<int>(block[i][c]));
+    }
+  }
+
+  // inset the box slightly, the end points then sit closer to the bulk of the colors
+  for (unsigned int c = 0; c < 3; c++)
+  {
+    int inset = (maxColor[c] - minColor[c]) >> 4;
+    minColor[c] += inset;
+    maxColor[c] -= inset;
+  }
+
+  uint16_t color0 = ToRGB565(maxColor);
+  uint16_t color1 = ToRGB565(minColor);
+  if (color0 < color1)
+    std::swap(color0, color1); // color0 > color1 selects the four color mode
+
+  uint32_t indices = 0;
+  if (color0 != color1)
+  {
+    int palette[4][3];
+    FromRGB565(color0, palette[0]);
+    FromRGB565(color1, palette[1]);
+    for (unsigned int c = 0; c < 3; c++)
+    {
+      palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+      palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+    }
+
+    for (unsigned int i = 0; i < 16; i++)
+    {
+      unsigned int best = 0;
+      int bestError = INT_MAX;
+      for (unsigned int p = 0; p < 4; p++)
+      {
+        int error = 0;
+        for (unsigned int c = 0; c < 3; c++)
+          error += (block[i][c] - palette[p][c]) * (block[i][c] - palette[p][c]);
+        if (error < bestError)
+        {
+          best = p;
+          bestError = error;
+        }
+      }
+      indices |= best << (2 * i);
+    }
+  }
+
+  WriteLittleEndian(dest, color0, 2);
+  WriteLittleEndian(dest + 2, color1, 2);
+  WriteLittleEndian(dest + 4, indices, 4);
+}
+
+// compresses the alpha values of a block using the eight value mode of DXT5
+void CompressAlphaBlock(const unsigned char block[16][4], unsigned char *dest)
+{
+  int minAlpha = 255;
+  int maxAlpha = 0;
+  for (unsigned int i = 0; i < 16; i++)
+  {
+    minAlpha = std::min(minAlpha, static_cast<int>(block[i][3]));
+    maxAlpha = std::max(maxAlpha, static_cast<int>(block[i][3]));
+  }
+
+  uint64_t indices = 0;
+  if (minAlpha != maxAlpha)
+  {
+    int palette[8] = { maxAlpha, minAlpha };
+    for (int i = 1; i < 7; i++)
+      palette[i + 1] = ((7 - i) * maxAlpha + i * minAlpha) / 7;
+
+    for (unsigned int i = 0; i < 16; i++)
+    {
+      uint64_t best = 0;
+      int bestError = INT_MAX;
+      for (unsigned int p = 0; p < 8; p++)
+      {
+        int error = std::abs(block[i][3] - palette[p]);
+        if (error < bestError)
+        {
+          best = p;
+          bestError = error;
+        }
+      }
+      indices |= best << (3 * i);
+    }
+  }
+
+  dest[0] = maxAlpha;
+  dest[1] = minAlpha;
+  WriteLittleEndian(dest + 2, indices, 6);
+}
+
+unsigned int CompressImage(const unsigned char *brga, unsigned int width, unsigned int height, unsigned int pitch,
+                           unsigned int format, unsigned char *dest)
+{
+  unsigned char *start = dest;
+  unsigned char block[16][4];
+  for (unsigned int y = 0; y < height; y += 4)
+  {
+    for (unsigned int x = 0; x < width; x += 4)
+    {
+      GetBlock(brga, width, height, pitch, x, y, block);
+      if (format == XB_FMT_DXT5)
+      {
+        CompressAlphaBlock(block, dest);
+        dest += 8;
+      }
+      CompressColorBlock(block, dest);
+      dest += 8;
+    }
+  }
+  return dest - start;
+}
+
+// box filters the image down to the next mipmap level
+void HalveImage(const unsigned char *brga, unsigned int width, unsigned int height, unsigned int pitch,
+                std::vector<unsigned char> &dest)
+{
+  unsigned int destWidth = std::max(width / 2, 1U);
+  unsigned int destHeight = std::max(height / 2, 1U);
+  dest.resize(destWidth * destHeight * 4);
+
+  unsigned char *out = dest.data();
+  for (unsigned int y = 0; y < destHeight; y++)
+  {
+    const unsigned char *row0 = brga + std::min(y * 2, height - 1) * pitch;
+    const unsigned char *row1 = brga + std::min(y * 2 + 1, height - 1) * pitch;
+    for (unsigned int x = 0; x < destWidth; x++)
+    {
+      unsigned int x0 = std::min(x * 2, width - 1) * 4;
+      unsigned int x1 = std::min(x * 2 + 1, width - 1) * 4;
+      for (unsigned int c = 0; c < 4; c++)
+        *out++ = (row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c] + 2) / 4;
+    }
+  }
+}
+}
+
 CDDSImage::CDDSImage()
 {
   m_data = NULL;
@@ -69,6 +259,20 @@ unsigned int CDDSImage::GetSize() const
   return m_desc.linearSize;
 }
 
+unsigned int CDDSImage::GetMipmapCount() const
+{
+  if ((m_desc.flags & ddsd_mipmapcount) && m_desc.mipmapcount > 1)
+    return std::min(m_desc.mipmapcount, MAX_MIPMAP_COUNT);
+  return 1;
+}
+
+unsigned int CDDSImage::GetDataSize() const
+{
+  if (GetMipmapCount() == 1)
+    return m_desc.linearSize;
+  return GetStorageRequirements(m_desc.width, m_desc.height, GetFormat(), GetMipmapCount());
+}
+
 unsigned char *CDDSImage::GetData() const
 {
   return m_data;
@@ -90,19 +294,74 @@ bool CDDSImage::ReadFile(const std::string &inputFile)
   if (!GetFormat())
     return false;  // not supported
 
-  // allocate our data
-  m_data = new unsigned char[m_desc.linearSize];
+  // allocate our data, all mipmap levels follow the base level
+  m_desc.linearSize = GetStorageRequirements(m_desc.width, m_desc.height, GetFormat());
+  unsigned int size = GetDataSize();
+  m_data = new unsigned char[size];
   if (!m_data)
     return false;
 
   // and read it in
-  if (file.Read(m_data, m_desc.linearSize) != static_cast<ssize_t>(m_desc.linearSize))
+  if (file.Read(m_data, size) != static_cast<ssize_t>(size))
     return false;
 
   file.Close();
   return true;
 }
 
+bool CDDSImage::Create(const std::string &outputFile, unsigned int width, unsigned int height, unsigned int pitch, const unsigned char *brga, bool hasAlpha)
+{
+  if (!brga || !width || !height)
+    return false;
+
+  unsigned int format = hasAlpha ? XB_FMT_DXT5 : XB_FMT_DXT1;
+  unsigned int mipmapCount = 1;
+  while (mipmapCount < MAX_MIPMAP_COUNT && std::max(width, height) >> mipmapCount)
+    mipmapCount++;
+
+  Allocate(width, height, format, mipmapCount);
+
+  std::vector<unsigned char> mipmap;
+  std::vector<unsigned char> nextMipmap;
+  unsigned char *dest = m_data;
+  for (unsigned int level = 0; level < mipmapCount; level++)
+  {
+    if (level > 0)
+    {
+      HalveImage(brga, width, height, pitch, nextMipmap);
+      mipmap.swap(nextMipmap);
+      width = std::max(width / 2, 1U);
+      height = std::max(height / 2, 1U);
+      pitch = width * 4;
+      brga = mipmap.data();
+    }
+    dest += CompressImage(brga, width, height, pitch, format, dest);
+  }
+
+  return WriteFile(outputFile);
+}
+
+bool CDDSImage::WriteFile(const std::string &outputFile) const
+{
+  // open the file
+  CFile file;
+  if (!file.OpenForWrite(outputFile, true))
+    return false;
+
+  // write the header
+  unsigned int size = GetDataSize();
+  if (file.Write("DDS ", 4) != 4 ||
+      file.Write(&m_desc, sizeof(m_desc)) != static_cast<ssize_t>(sizeof(m_desc)) ||
+      file.Write(m_data, size) != static_cast<ssize_t>(size))
+  {
+    CLog::Log(LOGERROR, "%s - failed writing '%s'", __FUNCTION__, outputFile.c_str());
+    return false;
+  }
+
+  file.Close();
+  return true;
+}
+
 unsigned int CDDSImage::GetStorageRequirements(unsigned int width, unsigned int height, unsigned int format)
 {
   switch (format)
@@ -118,7 +377,15 @@ unsigned int CDDSImage::GetStorageRequirements(unsigned int width, unsigned int
   }
 }
 
-void CDDSImage::Allocate(unsigned int width, unsigned int height, unsigned int format)
+unsigned int CDDSImage::GetStorageRequirements(unsigned int width, unsigned int height, unsigned int format, unsigned int mipmapCount)
+{
+  unsigned int size = 0;
+  for (unsigned int level = 0; level < mipmapCount; level++)
+    size += GetStorageRequirements(std::max(width >> level, 1U), std::max(height >> level, 1U), format);
+  return size;
+}
+
+void CDDSImage::Allocate(unsigned int width, unsigned int height, unsigned int format, unsigned int mipmapCount)
 {
   memset(&m_desc, 0, sizeof(m_desc));
   m_desc.size = sizeof(m_desc);
@@ -130,8 +397,14 @@ void CDDSImage::Allocate(unsigned int width, unsigned int height, unsigned int f
   m_desc.pixelFormat.flags = ddpf_fourcc;
   memcpy(&m_desc.pixelFormat.fourcc, GetFourCC(format), 4);
   m_desc.caps.flags1 = ddscaps_texture;
+  if (mipmapCount > 1)
+  {
+    m_desc.flags |= ddsd_mipmapcount;
+    m_desc.mipmapcount = mipmapCount;
+    m_desc.caps.flags1 |= ddscaps_complex | ddscaps_mipmap;
+  }
   delete[] m_data;
-  m_data = new unsigned char[m_desc.linearSize];
+  m_data = new unsigned char[GetStorageRequirements(width, height, format, mipmapCount)];
 }
 
 const char *CDDSImage::GetFourCC(unsigned int format)
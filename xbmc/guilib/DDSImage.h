@@ -11,6 +11,12 @@
 #include <string>
 #include <stdint.h>
 
+/*!
+ \brief Reads and writes DirectDraw Surface (.dds) images.
+
+ The pixel data holds the base level followed by the smaller mipmap levels,
+ if the image has any.
+ */
 class CDDSImage
 {
 public:
@@ -22,15 +28,31 @@ public:
   unsigned int GetHeight() const;
   unsigned int GetFormat() const;
   unsigned int GetSize() const;
+  unsigned int GetMipmapCount() const;
+  unsigned int GetDataSize() const;
   unsigned char *GetData() const;
 
   bool ReadFile(const std::string &file);
 
+  /*!
+   \brief Compress an image to DXT1 (or DXT5 if it has alpha) with a full mipmap chain and write it out.
+   \param outputFile the file to write.
+   \param width the width of the image.
+   \param height the height of the image.
+   \param pitch the number of bytes per row of the image.
+   \param brga the image in XB_FMT_A8R8G8B8 format.
+   \param hasAlpha whether the alpha channel of the image is used.
+   \return true if the image was written.
+   */
+  bool Create(const std::string &outputFile, unsigned int width, unsigned int height, unsigned int pitch, const unsigned char *brga, bool hasAlpha);
+
 private:
-  void Allocate(unsigned int width, unsigned int height, unsigned int format);
+  void Allocate(unsigned int width, unsigned int height, unsigned int format, unsigned int mipmapCount = 1);
+  bool WriteFile(const std::string &file) const;
   static const char *GetFourCC(unsigned int format);
 
   static unsigned int GetStorageRequirements(unsigned int width, unsigned int height, unsigned int format);
+  static unsigned int GetStorageRequirements(unsigned int width, unsigned int height, unsigned int format, unsigned int mipmapCount);
   enum {
     ddsd_caps        = 0x00000001,
     ddsd_height      = 0x00000002,
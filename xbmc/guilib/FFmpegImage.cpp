@@ -135,9 +135,44 @@ CFFmpegImage::~CFFmpegImage()
   m_buf.size = 0;
 }
 
+// Read the dimensions from the start of frame segment of a sequential DCT jpeg
+static bool GetJpegSize(const unsigned char* buffer, size_t bufSize, unsigned int& width, unsigned int& height)
+{
+  size_t pos = 2;
+  while (pos + 9 <= bufSize)
+  {
+    if (buffer[pos] != 0xFF)
+      return false;
+
+    unsigned char marker = buffer[pos + 1];
+    if (marker == 0xFF)
+    { // fill byte
+      pos++;
+      continue;
+    }
+
+    // only SOF0 (baseline) and SOF1 (extended sequential) are scaled while decoding
+    if (marker == 0xC0 || marker == 0xC1)
+    {
+      height = (buffer[pos + 5] << 8) | buffer[pos + 6];
+      width = (buffer[pos + 7] << 8) | buffer[pos + 8];
+      return width > 0 && height > 0;
+    }
+    if (marker >= 0xC2 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC)
+      return false;
+    if (marker == 0xDA)
+      return false;
+
+    pos += 2 + ((buffer[pos + 2] << 8) | buffer[pos + 3]);
+  }
+  return false;
+}
+
 bool CFFmpegImage::LoadImageFromMemory(unsigned char* buffer, unsigned int bufSize,
                                       unsigned int width, unsigned int height)
 {
+  m_idealWidth = width;
+  m_idealHeight = height;
 
   if (!Initialize(buffer, bufSize))
   {
@@ -249,6 +284,20 @@ bool CFFmpegImage::Initialize(unsigned char* buffer, size_t bufSize)
     return false;
   }
 
+  // let the decoder skip resolution which would be thrown away when scaling to the ideal size
+  m_sourceWidth = 0;
+  m_sourceHeight = 0;
+  if (is_jpeg && codec && m_idealWidth && m_idealHeight &&
+      GetJpegSize(buffer, bufSize, m_sourceWidth, m_sourceHeight))
+  {
+    double scale = std::min(static_cast<double>(m_idealWidth) / m_sourceWidth,
+                            static_cast<double>(m_idealHeight) / m_sourceHeight);
+    int lowres = 0;
+    while (lowres < codec->max_lowres && 1.0 / (2 << lowres) >= scale)
+      lowres++;
+    m_codec_ctx->lowres = lowres;
+  }
+
   if (avcodec_open2(m_codec_ctx, codec, NULL) < 0)
   {
     avformat_close_input(&m_fctx);
@@ -295,6 +344,11 @@ AVFrame* CFFmpegImage::ExtractFrame()
   m_width = frame->width;
   m_originalWidth = m_width;
   m_originalHeight = m_height;
+  if (m_codec_ctx->lowres > 0 && m_sourceWidth && m_sourceHeight)
+  {
+    m_originalWidth = m_sourceWidth;
+    m_originalHeight = m_sourceHeight;
+  }
 
   const AVPixFmtDescriptor* pixDescriptor = av_pix_fmt_desc_get(static_cast<AVPixelFormat>(frame->format));
   if (pixDescriptor && ((pixDescriptor->flags & (AV_PIX_FMT_FLAG_ALPHA | AV_PIX_FMT_FLAG_PAL)) != 0))
@@ -467,9 +521,10 @@ bool CFFmpegImage::DecodeFrame(AVFrame* frame, unsigned int width, unsigned int
   AVPixelFormat pixFormat = ConvertFormats(frame);
 
   // assumption quadratic maximums e.g. 2048x2048
+  // the frame might have been decoded at a reduced resolution
   float ratio = m_width / (float)m_height;
-  unsigned int nHeight = m_originalHeight;
-  unsigned int nWidth = m_originalWidth;
+  unsigned int nHeight = frame->height;
+  unsigned int nWidth = frame->width;
   if (nHeight > height)
   {
     nHeight = height;
@@ -481,7 +536,7 @@ bool CFFmpegImage::DecodeFrame(AVFrame* frame, unsigned int width, unsigned int
     nHeight = (unsigned int)(nWidth / ratio + 0.5f);
   }
 
-  struct SwsContext* context = sws_getContext(m_originalWidth, m_originalHeight, pixFormat,
+  struct SwsContext* context = sws_getContext(frame->width, frame->height, pixFormat,
     nWidth, nHeight, AV_PIX_FMT_RGB32, SWS_BICUBIC, NULL, NULL, NULL);
 
   if (range == AVCOL_RANGE_JPEG)
@@ -494,7 +549,7 @@ bool CFFmpegImage::DecodeFrame(AVFrame* frame, unsigned int width, unsigned int
     sws_setColorspaceDetails(context, inv_table, srcRange, table, dstRange, brightness, contrast, saturation);
   }
 
-  sws_scale(context, frame->data, frame->linesize, 0, m_originalHeight,
+  sws_scale(context, frame->data, frame->linesize, 0, frame->height,
     pictureRGB->data, pictureRGB->linesize);
   sws_freeContext(context);
 
@@ -92,4 +92,11 @@ private:
 
   AVFrame* m_pFrame;
   uint8_t* m_outputBuffer;
+
+  // ideal size given to LoadImageFromMemory, jpegs are decoded at a reduced
+  // resolution as long as they are still bigger than that
+  unsigned int m_idealWidth = 0;
+  unsigned int m_idealHeight = 0;
+  unsigned int m_sourceWidth = 0;
+  unsigned int m_sourceHeight = 0;
 };
@@ -15,6 +15,7 @@
 #include "GUIComponent.h"
 #include "GUIWindowManager.h"
 #include "GUIControlProfiler.h"
+#include "GUIFrameStatistics.h"
 #include "GUITexture.h"
 #include "input/mouse/MouseStat.h"
 #include "input/InputManager.h"
@@ -131,7 +132,9 @@ void CGUIControl::DoProcess(unsigned int currentTime, CDirtyRegionList &dirtyreg
     if (m_hasCamera)
       CServiceBroker::GetWinSystem()->GetGfxContext().SetCameraPosition(m_camera);
 
+    GUISTATISTICS_CONTROL_BEGIN();
     Process(currentTime, dirtyregions);
+    GUISTATISTICS_CONTROL_END(ControlType, false);
     m_bInvalidated = false;
 
     if (dirtyRegion != m_renderRegion)
@@ -181,6 +184,7 @@ void CGUIControl::DoRender()
       CServiceBroker::GetWinSystem()->GetGfxContext().SetStereoFactor(m_stereo);
 
     GUIPROFILER_RENDER_BEGIN(this);
+    GUISTATISTICS_CONTROL_BEGIN();
 
     if (m_hitColor != 0xffffffff)
     {
@@ -190,6 +194,7 @@ void CGUIControl::DoRender()
 
     Render();
 
+    GUISTATISTICS_CONTROL_END(ControlType, true);
     GUIPROFILER_RENDER_END(this);
 
     if (hasStereo)
@@ -9,6 +9,7 @@
 #include <stdint.h>
 #include <vector>
 #include "GUIFontTTF.h"
+#include "GUIFrameStatistics.h"
 #include "windowing/GraphicContext.h"
 
 template<class Position, class Value>
@@ -153,6 +154,7 @@ Value &CGUIFontCacheImpl<Position, Value>::Lookup(Position &pos,
   {
     // Cache miss
     dirtyCache = true;
+    CGUIFrameStatistics::GetInstance().AddFontCacheMiss();
     CGUIFontCacheEntry<Position, Value> *entry = nullptr;
     if (!m_list.ageMap.empty() && (nowMillis - m_list.ageMap.begin()->first) > FONT_CACHE_TIME_LIMIT)
     {
@@ -8,6 +8,7 @@
 
 #include "GUIComponent.h"
 #include "GUIFontManager.h"
+#include "GUITextLayoutCache.h"
 #include "windowing/GraphicContext.h"
 #include "GUIWindowManager.h"
 #include "addons/Skin.h"
@@ -209,6 +210,9 @@ void GUIFontManager::ReloadTTFFonts(void)
   if (!m_vecFonts.size())
     return;   // we haven't even loaded fonts in yet
 
+  // the text was measured with the old font files
+  CGUITextLayoutCache::GetInstance().Clear();
+
   for (unsigned int i = 0; i < m_vecFonts.size(); i++)
   {
     CGUIFont* font = m_vecFonts[i];
@@ -247,6 +251,7 @@ void GUIFontManager::Unload(const std::string& strFontName)
   {
     if (StringUtils::EqualsNoCase((*iFont)->GetFontName(), strFontName))
     {
+      CGUITextLayoutCache::GetInstance().Clear();
       delete (*iFont);
       m_vecFonts.erase(iFont);
       return;
@@ -328,6 +333,8 @@ CGUIFont* GUIFontManager::GetDefaultFont(bool border)
 
 void GUIFontManager::Clear()
 {
+  CGUITextLayoutCache::GetInstance().Clear();
+
   for (int i = 0; i < (int)m_vecFonts.size(); ++i)
   {
     CGUIFont* pFont = m_vecFonts[i];
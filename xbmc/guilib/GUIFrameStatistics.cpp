@@ -0,0 +1,227 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "GUIFrameStatistics.h"
+#include "threads/SingleLock.h"
+#include "utils/TimeUtils.h"
+
+#include <algorithm>
+
+std::atomic<bool> CGUIFrameStatistics::m_controlStatistics(false);
+
+namespace
+{
+float TicksToMs(int64_t ticks)
+{
+  return static_cast<float>(ticks * 1000.0 / CurrentHostFrequency());
+}
+}
+
+CGUIFrameStatistics& CGUIFrameStatistics::GetInstance()
+{
+  static CGUIFrameStatistics sFrameStatistics;
+  return sFrameStatistics;
+}
+
+void CGUIFrameStatistics::SetControlStatisticsEnabled(bool enabled)
+{
+  CSingleLock lock(m_critSection);
+  if (enabled && !m_controlStatistics)
+  {
+    m_controls.clear();
+    m_controlFrames = 0;
+  }
+  m_controlStatistics = enabled;
+}
+
+void CGUIFrameStatistics::AddWindowProcessTime(int windowId, int64_t ticks)
+{
+  m_currentWindows[windowId].processTicks += ticks;
+}
+
+void CGUIFrameStatistics::AddWindowRenderTime(int windowId, int64_t ticks)
+{
+  m_currentWindows[windowId].renderTicks += ticks;
+}
+
+void CGUIFrameStatistics::AddDirtyArea(float percent)
+{
+  m_currentDirtyArea += percent;
+}
+
+void CGUIFrameStatistics::BeginControl()
+{
+  m_controlTimers.push_back({CurrentHostCounter(), 0});
+}
+
+void CGUIFrameStatistics::EndControl(CGUIControl::GUICONTROLTYPES type, bool render)
+{
+  // statistics may have been enabled while the control was processed
+  if (m_controlTimers.empty())
+    return;
+
+  int64_t elapsed = CurrentHostCounter() - m_controlTimers.back().start;
+  int64_t exclusive = elapsed - m_controlTimers.back().children;
+  m_controlTimers.pop_back();
+  if (!m_controlTimers.empty())
+    m_controlTimers.back().children += elapsed;
+
+  ControlTotals &totals = m_currentControls[type];
+  if (render)
+  {
+    totals.renderCalls++;
+    totals.renderTicks += exclusive;
+  }
+  else
+  {
+    totals.processCalls++;
+    totals.processTicks += exclusive;
+  }
+}
+
+void CGUIFrameStatistics::EndFrame()
+{
+  FrameSample frame;
+  frame.dirtyArea = std::min(m_currentDirtyArea, 100.0f);
+  frame.textureUploads = m_textureUploads.exchange(0);
+  frame.textureUploadKB = m_textureUploadBytes.exchange(0) / 1024.0f;
+  frame.deferredTextureUploads = m_deferredTextureUploads.exchange(0);
+  frame.fontCacheMisses = m_fontCacheMisses.exchange(0);
+
+  CSingleLock lock(m_critSection);
+  for (const auto &it : m_currentWindows)
+  {
+    frame.processMs += TicksToMs(it.second.processTicks);
+    frame.renderMs += TicksToMs(it.second.renderTicks);
+
+    WindowHistory &history = m_windows[it.first];
+    if (history.samples.size() < FRAME_HISTORY)
+      history.samples.push_back(it.second);
+    else
+      history.samples[history.next] = it.second;
+    history.next = (history.next + 1) % FRAME_HISTORY;
+  }
+
+  if (m_frames.size() < FRAME_HISTORY)
+    m_frames.push_back(frame);
+  else
+    m_frames[m_nextFrame] = frame;
+  m_nextFrame = (m_nextFrame + 1) % FRAME_HISTORY;
+
+  if (m_controlStatistics)
+  {
+    for (const auto &it : m_currentControls)
+    {
+      ControlTotals &totals = m_controls[it.first];
+      totals.processCalls += it.second.processCalls;
+      totals.renderCalls += it.second.renderCalls;
+      totals.processTicks += it.second.processTicks;
+      totals.renderTicks += it.second.renderTicks;
+    }
+    m_controlFrames++;
+  }
+  lock.Leave();
+
+  m_currentWindows.clear();
+  m_currentDirtyArea = 0.0f;
+  m_currentControls.clear();
+  m_controlTimers.clear();
+}
+
+CGUIFrameStatistics::Snapshot CGUIFrameStatistics::GetSnapshot() const
+{
+  Snapshot snapshot;
+  std::vector<float> values;
+
+  CSingleLock lock(m_critSection);
+  snapshot.frames = m_frames.size();
+
+  values.reserve(FRAME_HISTORY);
+  for (const auto &frame : m_frames)
+  {
+    values.push_back(frame.processMs + frame.renderMs);
+    snapshot.textureUploads += frame.textureUploads;
+    snapshot.deferredTextureUploads += frame.deferredTextureUploads;
+    snapshot.fontCacheMisses += frame.fontCacheMisses;
+  }
+  snapshot.frameMs = CalcPercentiles(values);
+
+  values.clear();
+  for (const auto &frame : m_frames)
+    values.push_back(frame.dirtyArea);
+  snapshot.dirtyArea = CalcPercentiles(values);
+
+  values.clear();
+  for (const auto &frame : m_frames)
+    values.push_back(frame.textureUploadKB);
+  snapshot.textureUploadKB = CalcPercentiles(values);
+
+  for (const auto &it : m_windows)
+  {
+    Window window;
+    window.id = it.first;
+    window.frames = it.second.samples.size();
+
+    values.clear();
+    for (const auto &sample : it.second.samples)
+      values.push_back(TicksToMs(sample.processTicks));
+    window.processMs = CalcPercentiles(values);
+
+    values.clear();
+    for (const auto &sample : it.second.samples)
+      values.push_back(TicksToMs(sample.renderTicks));
+    window.renderMs = CalcPercentiles(values);
+
+    snapshot.windows.push_back(window);
+  }
+
+  snapshot.controlFrames = m_controlFrames;
+  if (m_controlFrames > 0)
+  {
+    for (const auto &it : m_controls)
+    {
+      Control control;
+      control.type = static_cast<CGUIControl::GUICONTROLTYPES>(it.first);
+      control.processCalls = static_cast<float>(it.second.processCalls) / m_controlFrames;
+      control.renderCalls = static_cast<float>(it.second.renderCalls) / m_controlFrames;
+      control.processMs = TicksToMs(it.second.processTicks) / m_controlFrames;
+      control.renderMs = TicksToMs(it.second.renderTicks) / m_controlFrames;
+      snapshot.controls.push_back(control);
+    }
+  }
+
+  return snapshot;
+}
+
+void CGUIFrameStatistics::Reset()
+{
+  CSingleLock lock(m_critSection);
+  m_frames.clear();
+  m_nextFrame = 0;
+  m_windows.clear();
+  m_controls.clear();
+  m_controlFrames = 0;
+}
+
+CGUIFrameStatistics::Percentiles CGUIFrameStatistics::CalcPercentiles(std::vector<float> &values)
+{
+  Percentiles result;
+  if (values.empty())
+    return result;
+
+  std::sort(values.begin(), values.end());
+  auto percentile = [&values](float p)
+  {
+    return values[std::min(values.size() - 1, static_cast<size_t>(p * values.size()))];
+  };
+  result.p50 = percentile(0.50f);
+  result.p95 = percentile(0.95f);
+  result.p99 = percentile(0.99f);
+  result.max = values.back();
+  return result;
+}
@@ -0,0 +1,165 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "GUIControl.h"
+#include "threads/CriticalSection.h"
+
+#include <atomic>
+#include <map>
+#include <stdint.h>
+#include <vector>
+
+/*!
+ \brief Rolling statistics of the time spent processing and rendering the GUI.
+
+ Frame and window times, the dirty area, texture uploads and font cache misses are always
+ collected, which costs a couple of timer reads per window and frame. Control times are only
+ collected while enabled, as every control is timed then. Control times are exclusive, i.e. the
+ time spent in the children of a group or container is accounted to the children.
+
+ Recording is done from the render thread, snapshots may be taken from any thread.
+ */
+class CGUIFrameStatistics
+{
+public:
+  //! number of frames the percentiles are calculated over
+  static const size_t FRAME_HISTORY = 256;
+
+  struct Percentiles
+  {
+    float p50 = 0.0f;
+    float p95 = 0.0f;
+    float p99 = 0.0f;
+    float max = 0.0f;
+  };
+
+  struct Window
+  {
+    int id = 0;
+    unsigned int frames = 0; //!< number of frames the percentiles are based on
+    Percentiles processMs;
+    Percentiles renderMs;
+  };
+
+  struct Control
+  {
+    CGUIControl::GUICONTROLTYPES type = CGUIControl::GUICONTROL_UNKNOWN;
+    float processCalls = 0.0f; //!< per frame
+    float renderCalls = 0.0f;  //!< per frame
+    float processMs = 0.0f;    //!< per frame
+    float renderMs = 0.0f;     //!< per frame
+  };
+
+  struct Snapshot
+  {
+    unsigned int frames = 0;
+    Percentiles frameMs;       //!< process and render time of all windows
+    Percentiles dirtyArea;     //!< percentage of the screen rendered
+    Percentiles textureUploadKB; //!< texture data uploaded to the GPU
+    unsigned int textureUploads = 0; //!< within the history
+    unsigned int deferredTextureUploads = 0; //!< postponed to the next frame within the history
+    unsigned int fontCacheMisses = 0; //!< within the history
+    std::vector<Window> windows;
+    unsigned int controlFrames = 0; //!< frames since control statistics were enabled
+    std::vector<Control> controls;
+  };
+
+  static CGUIFrameStatistics& GetInstance();
+
+  /*! \brief Whether times of individual controls are collected.
+   Checked before every control, hence static.
+   */
+  static bool IsControlStatisticsEnabled() { return m_controlStatistics; }
+  void SetControlStatisticsEnabled(bool enabled);
+
+  void AddWindowProcessTime(int windowId, int64_t ticks);
+  void AddWindowRenderTime(int windowId, int64_t ticks);
+  void AddDirtyArea(float percent);
+  void AddTextureUpload(size_t bytes) { m_textureUploads++; m_textureUploadBytes += bytes; }
+  void AddDeferredTextureUpload() { m_deferredTextureUploads++; }
+  void AddFontCacheMiss() { m_fontCacheMisses++; }
+
+  void BeginControl();
+  void EndControl(CGUIControl::GUICONTROLTYPES type, bool render);
+
+  /*! \brief Finish the current frame, called once per rendered frame.
+   */
+  void EndFrame();
+
+  Snapshot GetSnapshot() const;
+  void Reset();
+
+private:
+  CGUIFrameStatistics() = default;
+  CGUIFrameStatistics(const CGUIFrameStatistics&) = delete;
+  CGUIFrameStatistics& operator=(const CGUIFrameStatistics&) = delete;
+
+  struct FrameSample
+  {
+    float processMs = 0.0f;
+    float renderMs = 0.0f;
+    float dirtyArea = 0.0f;
+    float textureUploadKB = 0.0f;
+    unsigned int textureUploads = 0;
+    unsigned int deferredTextureUploads = 0;
+    unsigned int fontCacheMisses = 0;
+  };
+
+  struct WindowSample
+  {
+    int64_t processTicks = 0;
+    int64_t renderTicks = 0;
+  };
+
+  struct WindowHistory
+  {
+    std::vector<WindowSample> samples;
+    size_t next = 0;
+  };
+
+  struct ControlTotals
+  {
+    uint64_t processCalls = 0;
+    uint64_t renderCalls = 0;
+    int64_t processTicks = 0;
+    int64_t renderTicks = 0;
+  };
+
+  struct ControlTimer
+  {
+    int64_t start;
+    int64_t children;
+  };
+
+  static Percentiles CalcPercentiles(std::vector<float> &values);
+
+  static std::atomic<bool> m_controlStatistics;
+
+  // current frame, only accessed from the render thread
+  std::map<int, WindowSample> m_currentWindows;
+  float m_currentDirtyArea = 0.0f;
+  std::vector<ControlTimer> m_controlTimers;
+  std::map<int, ControlTotals> m_currentControls;
+  std::atomic<unsigned int> m_textureUploads{0};
+  std::atomic<size_t> m_textureUploadBytes{0};
+  std::atomic<unsigned int> m_deferredTextureUploads{0};
+  std::atomic<unsigned int> m_fontCacheMisses{0};
+
+  // history
+  std::vector<FrameSample> m_frames;
+  size_t m_nextFrame = 0;
+  std::map<int, WindowHistory> m_windows;
+  std::map<int, ControlTotals> m_controls;
+  unsigned int m_controlFrames = 0;
+  mutable CCriticalSection m_critSection;
+};
+
+#define GUISTATISTICS_CONTROL_BEGIN() { if (CGUIFrameStatistics::IsControlStatisticsEnabled()) CGUIFrameStatistics::GetInstance().BeginControl(); }
+#define GUISTATISTICS_CONTROL_END(type, render) { if (CGUIFrameStatistics::IsControlStatisticsEnabled()) CGUIFrameStatistics::GetInstance().EndControl(type, render); }
@@ -112,12 +112,14 @@ void CGUIListItem::SetArt(const ArtMap &art)
 void CGUIListItem::SetArtFallback(const std::string &from, const std::string &to)
 {
   m_artFallbacks[from] = to;
+  SetInvalid();
 }
 
 void CGUIListItem::ClearArt()
 {
   m_art.clear();
   m_artFallbacks.clear();
+  m_conditionCache.clear();
 }
 
 void CGUIListItem::AppendArt(const ArtMap &art, const std::string &prefix)
@@ -196,6 +198,8 @@ std::string CGUIListItem::GetOverlayImage() const
 
 void CGUIListItem::Select(bool bOnOff)
 {
+  if (m_bSelected != bOnOff)
+    m_conditionCache.clear();
   m_bSelected = bOnOff;
 }
 
@@ -341,6 +345,7 @@ void CGUIListItem::FreeMemory(bool immediately)
     m_focusedLayout->FreeResources(immediately);
     m_focusedLayout.reset();
   }
+  m_conditionCache.clear();
 }
 
 void CGUIListItem::SetLayout(CGUIListItemLayoutPtr layout)
@@ -367,6 +372,37 @@ void CGUIListItem::SetInvalid()
 {
   if (m_layout) m_layout->SetInvalid();
   if (m_focusedLayout) m_focusedLayout->SetInvalid();
+  m_conditionCache.clear();
+}
+
+bool CGUIListItem::GetCachedCondition(unsigned int condition, bool &value) const
+{
+  // m_bIsFolder is written directly, so the cache can't be cleared when it changes
+  if (m_conditionCacheIsFolder != m_bIsFolder)
+  {
+    m_conditionCache.clear();
+    return false;
+  }
+
+  for (const auto &it : m_conditionCache)
+  {
+    if (it.first == condition)
+    {
+      value = it.second;
+      return true;
+    }
+  }
+  return false;
+}
+
+void CGUIListItem::SetCachedCondition(unsigned int condition, bool value) const
+{
+  if (m_conditionCacheIsFolder != m_bIsFolder)
+  {
+    m_conditionCache.clear();
+    m_conditionCacheIsFolder = m_bIsFolder;
+  }
+  m_conditionCache.emplace_back(condition, value);
 }
 
 void CGUIListItem::SetProperty(const std::string &strKey, const CVariant &value)
@@ -16,6 +16,8 @@
 #include <map>
 #include <string>
 #include <memory>
+#include <utility>
+#include <vector>
 
 //  Forward
 class CGUIListItemLayout;
@@ -139,6 +141,15 @@ public:
   void FreeMemory(bool immediately = false);
   void SetInvalid();
 
+  /*! \brief Get the cached value of a condition that only depends on this item
+   The cache is cleared whenever the item is invalidated, its layouts are freed or m_bIsFolder changes.
+   \param condition the id of the condition, see INFO::InfoBool::ListItemStatic()
+   \param value [out] the cached value
+   \return true if the value of the condition is cached, false otherwise
+   */
+  bool GetCachedCondition(unsigned int condition, bool &value) const;
+  void SetCachedCondition(unsigned int condition, bool value) const;
+
   bool m_bIsFolder;     ///< is item a folder or a file
 
   void SetProperty(const std::string &strKey, const CVariant &value);
@@ -186,5 +197,9 @@ private:
 
   ArtMap m_art;
   ArtMap m_artFallbacks;
+
+  // a layout rarely has more than a handful of conditions, so a vector beats a map
+  mutable std::vector<std::pair<unsigned int, bool>> m_conditionCache;
+  mutable bool m_conditionCacheIsFolder = false; ///< value of m_bIsFolder the cached conditions were evaluated for
 };
 
@@ -10,6 +10,7 @@
 #include "GUIFont.h"
 #include "GUIControl.h"
 #include "GUIColorManager.h"
+#include "GUITextLayoutCache.h"
 #include "utils/CharsetConverter.h"
 #include "utils/StringUtils.h"
 
@@ -226,6 +227,31 @@ bool CGUITextLayout::UpdateW(const std::wstring &text, float maxWidth /*= 0*/, b
 
 void CGUITextLayout::UpdateCommon(const std::wstring &text, float maxWidth, bool forceLTRReadingOrder)
 {
+  // the same text is often laid out by several controls or list items
+  CGUITextLayoutCache::CKey key;
+  CGUITextLayoutCache::CLayout layout;
+  if (m_font)
+  {
+    CGraphicContext &context = CServiceBroker::GetWinSystem()->GetGfxContext();
+    key.font = m_font;
+    key.text = text;
+    key.maxWidth = m_wrap && maxWidth > 0 ? maxWidth : 0;
+    key.maxHeight = m_maxHeight;
+    key.style = m_font->GetStyle();
+    key.color = m_textColor;
+    key.forceLTRReadingOrder = forceLTRReadingOrder;
+    key.scaleX = context.GetGUIScaleX();
+    key.scaleY = context.GetGUIScaleY();
+    if (CGUITextLayoutCache::GetInstance().Get(key, layout))
+    {
+      m_lines.swap(layout.lines);
+      m_colors.swap(layout.colors);
+      m_textWidth = layout.width;
+      m_textHeight = layout.height;
+      return;
+    }
+  }
+
   // parse the text for style information
   vecText parsedText;
   std::vector<UTILS::Color> colors;
@@ -233,6 +259,15 @@ void CGUITextLayout::UpdateCommon(const std::wstring &text, float maxWidth, bool
 
   // and update
   UpdateStyled(parsedText, colors, maxWidth, forceLTRReadingOrder);
+
+  if (m_font)
+  {
+    layout.lines = m_lines;
+    layout.colors = m_colors;
+    layout.width = m_textWidth;
+    layout.height = m_textHeight;
+    CGUITextLayoutCache::GetInstance().Add(key, layout);
+  }
 }
 
 void CGUITextLayout::UpdateStyled(const vecText &text, const std::vector<UTILS::Color> &colors, float maxWidth, bool forceLTRReadingOrder)
@@ -0,0 +1,134 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "GUITextLayoutCache.h"
+#include "threads/SingleLock.h"
+#include "utils/log.h"
+
+#include <functional>
+#include <iterator>
+
+namespace
+{
+// maximum number of characters held by the cached lines
+const size_t CACHE_CHARACTER_BUDGET = 256 * 1024;
+
+template<typename T>
+void HashCombine(size_t &seed, const T &value)
+{
+  seed ^= std::hash<T>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+}
+
+bool CGUITextLayoutCache::CKey::operator==(const CKey &right) const
+{
+  return font == right.font &&
+         maxWidth == right.maxWidth &&
+         maxHeight == right.maxHeight &&
+         style == right.style &&
+         color == right.color &&
+         forceLTRReadingOrder == right.forceLTRReadingOrder &&
+         scaleX == right.scaleX &&
+         scaleY == right.scaleY &&
+         text == right.text;
+}
+
+CGUITextLayoutCache& CGUITextLayoutCache::GetInstance()
+{
+  static CGUITextLayoutCache sTextLayoutCache;
+  return sTextLayoutCache;
+}
+
+bool CGUITextLayoutCache::Get(const CKey &key, CLayout &layout)
+{
+  size_t hash = Hash(key);
+
+  CSingleLock lock(m_critSection);
+  auto range = m_index.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it)
+  {
+    if (it->second->key == key)
+    {
+      m_entries.splice(m_entries.begin(), m_entries, it->second);
+      layout = it->second->layout;
+      m_stats.hits++;
+      return true;
+    }
+  }
+
+  m_stats.misses++;
+  return false;
+}
+
+void CGUITextLayoutCache::Add(const CKey &key, const CLayout &layout)
+{
+  size_t size = key.text.size();
+  for (const auto &line : layout.lines)
+    size += line.m_text.size();
+  if (size > CACHE_CHARACTER_BUDGET / 4)
+    return;
+
+  size_t hash = Hash(key);
+
+  CSingleLock lock(m_critSection);
+  auto range = m_index.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it)
+  {
+    if (it->second->key == key)
+      return;
+  }
+
+  m_entries.push_front({hash, size, key, layout});
+  m_index.insert(std::make_pair(hash, m_entries.begin()));
+  m_size += size;
+
+  while (m_size > CACHE_CHARACTER_BUDGET)
+  {
+    auto last = std::prev(m_entries.end());
+    range = m_index.equal_range(last->hash);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+      if (it->second == last)
+      {
+        m_index.erase(it);
+        break;
+      }
+    }
+    m_size -= last->size;
+    m_entries.erase(last);
+    m_stats.evictions++;
+  }
+}
+
+void CGUITextLayoutCache::Clear()
+{
+  CSingleLock lock(m_critSection);
+  if (m_stats.hits || m_stats.misses)
+    CLog::Log(LOGDEBUG, "CGUITextLayoutCache: %u hits, %u misses, %u evicted", m_stats.hits, m_stats.misses, m_stats.evictions);
+
+  m_index.clear();
+  m_entries.clear();
+  m_size = 0;
+}
+
+CGUITextLayoutCache::SStats CGUITextLayoutCache::GetStats() const
+{
+  CSingleLock lock(m_critSection);
+  return m_stats;
+}
+
+size_t CGUITextLayoutCache::Hash(const CKey &key)
+{
+  size_t hash = std::hash<std::wstring>()(key.text);
+  HashCombine(hash, key.font);
+  HashCombine(hash, key.maxWidth);
+  HashCombine(hash, key.maxHeight);
+  HashCombine(hash, key.style);
+  HashCombine(hash, key.color);
+  return hash;
+}
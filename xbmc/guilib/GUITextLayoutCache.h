@@ -0,0 +1,90 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "GUITextLayout.h"
+#include "threads/CriticalSection.h"
+
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*!
+ \ingroup textures
+ \brief Cache of the parsed and wrapped lines of text layouts.
+
+ Parsing the style tags, wrapping and measuring a text is done once per font,
+ width and style. Text layouts of other controls or list items showing the same
+ text reuse the result. The least recently used entries are dropped once the
+ cached lines exceed the character budget.
+
+ The font manager clears the cache whenever fonts are unloaded or reloaded.
+ */
+class CGUITextLayoutCache
+{
+public:
+  struct CKey
+  {
+    const CGUIFont *font;
+    std::wstring text;
+    float maxWidth;          //!< 0 if the text isn't wrapped
+    float maxHeight;
+    uint32_t style;
+    UTILS::Color color;
+    bool forceLTRReadingOrder;
+    float scaleX;            //!< GUI scale the text was measured with
+    float scaleY;
+
+    bool operator==(const CKey &right) const;
+  };
+
+  struct CLayout
+  {
+    std::vector<CGUIString> lines;
+    std::vector<UTILS::Color> colors;
+    float width;
+    float height;
+  };
+
+  struct SStats
+  {
+    unsigned int hits = 0;
+    unsigned int misses = 0;
+    unsigned int evictions = 0;
+  };
+
+  static CGUITextLayoutCache& GetInstance();
+
+  bool Get(const CKey &key, CLayout &layout);
+  void Add(const CKey &key, const CLayout &layout);
+  void Clear();
+
+  SStats GetStats() const;
+
+private:
+  CGUITextLayoutCache() = default;
+
+  struct CEntry
+  {
+    size_t hash;
+    size_t size;
+    CKey key;
+    CLayout layout;
+  };
+  typedef std::list<CEntry> EntryList;
+
+  static size_t Hash(const CKey &key);
+
+  EntryList m_entries;  //!< most recently used first
+  std::unordered_multimap<size_t, EntryList::iterator> m_index;
+  size_t m_size = 0;
+  SStats m_stats;
+  mutable CCriticalSection m_critSection;
+};
@@ -10,6 +10,8 @@
 #include "windowing/GraphicContext.h"
 #include "TextureManager.h"
 #include "GUILargeTextureManager.h"
+#include "GUIFrameStatistics.h"
+#include "Texture.h"
 #include "utils/MathUtils.h"
 #include "utils/StringUtils.h"
 
@@ -140,12 +142,29 @@ bool CGUITextureBase::Process(unsigned int currentTime)
   if (m_isAllocated)
     changed |= !ReadyToRender();
 
+  // spread the upload of new textures over several frames
+  m_uploadDeferred = false;
+  if (m_texture.size())
+    changed |= !ReserveUpload();
+
   return changed;
 }
 
+bool CGUITextureBase::ReserveUpload()
+{
+  CBaseTexture *texture = m_texture.m_textures[m_currentFrame];
+  if (!texture->IsUploadPending())
+    return true;
+
+  m_uploadDeferred = !CServiceBroker::GetGUI()->GetTextureManager().ReserveUpload(texture);
+  if (m_uploadDeferred)
+    CGUIFrameStatistics::GetInstance().AddDeferredTextureUpload();
+  return !m_uploadDeferred;
+}
+
 void CGUITextureBase::Render()
 {
-  if (!m_visible || !m_texture.size())
+  if (!m_visible || !m_texture.size() || m_uploadDeferred)
     return;
 
   // see if we need to clip the image
@@ -461,6 +480,7 @@ void CGUITextureBase::FreeResources(bool immediately /* = false */)
   Free();
 
   m_isAllocated = NO;
+  m_uploadDeferred = false;
 }
 
 void CGUITextureBase::DynamicResourceAlloc(bool allocateDynamically)
@@ -110,6 +110,7 @@ protected:
   void LoadDiffuseImage();
   bool AllocateOnDemand();
   bool UpdateAnimFrame(unsigned int currentTime);
+  bool ReserveUpload();
   void Render(float left, float top, float bottom, float right, float u1, float v1, float u2, float v2, float u3, float v3);
   static void OrientateTexture(CRect &rect, float width, float height, int orientation);
   void ResetAnimState();
@@ -149,6 +150,7 @@ protected:
   bool m_allocateDynamically;
   enum ALLOCATE_TYPE { NO = 0, NORMAL, LARGE, NORMAL_FAILED, LARGE_FAILED };
   ALLOCATE_TYPE m_isAllocated;
+  bool m_uploadDeferred = false; ///< the frame's upload budget is used up, so the texture isn't rendered yet
 
   CTextureInfo m_info;
   CAspectRatio m_aspect;
@@ -13,6 +13,7 @@
 #include "GUIControlFactory.h"
 #include "GUIControlGroup.h"
 #include "GUIControlProfiler.h"
+#include "GUIFrameStatistics.h"
 
 #include "addons/Skin.h"
 #include "GUIInfoManager.h"
@@ -327,6 +328,8 @@ void CGUIWindow::DoProcess(unsigned int currentTime, CDirtyRegionList &dirtyregi
   if (!IsControlDirty() && g_advancedSettings.m_guiSmartRedraw)
     return;
 
+  int64_t start = CurrentHostCounter();
+
   CServiceBroker::GetWinSystem()->GetGfxContext().SetRenderingResolution(m_coordsRes, m_needsScaling);
   CServiceBroker::GetWinSystem()->GetGfxContext().AddGUITransform();
   CGUIControlGroup::DoProcess(currentTime, dirtyregions);
@@ -337,6 +340,8 @@ void CGUIWindow::DoProcess(unsigned int currentTime, CDirtyRegionList &dirtyregi
   CGUIControl* focusedControl = GetFocusedControl();
   if (focusedControl && !focusedControl->CanFocus())
     SET_CONTROL_FOCUS(m_defaultControl, 0);
+
+  CGUIFrameStatistics::GetInstance().AddWindowProcessTime(GetID(), CurrentHostCounter() - start);
 }
 
 void CGUIWindow::DoRender()
@@ -347,12 +352,16 @@ void CGUIWindow::DoRender()
   // to occur.
   if (!m_bAllocated) return;
 
+  int64_t start = CurrentHostCounter();
+
   CServiceBroker::GetWinSystem()->GetGfxContext().SetRenderingResolution(m_coordsRes, m_needsScaling);
 
   CServiceBroker::GetWinSystem()->GetGfxContext().AddGUITransform();
   CGUIControlGroup::DoRender();
   CServiceBroker::GetWinSystem()->GetGfxContext().RemoveTransform();
 
+  CGUIFrameStatistics::GetInstance().AddWindowRenderTime(GetID(), CurrentHostCounter() - start);
+
   if (CGUIControlProfiler::IsRunning()) CGUIControlProfiler::Instance().EndFrame();
 }
 
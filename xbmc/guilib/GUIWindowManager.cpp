@@ -9,6 +9,7 @@
 #include "GUIWindowManager.h"
 #include "GUIAudioManager.h"
 #include "GUIDialog.h"
+#include "GUIFrameStatistics.h"
 #include "Application.h"
 #include "messaging/ApplicationMessenger.h"
 #include "messaging/helpers/DialogHelper.h"
@@ -20,6 +21,7 @@
 #include "settings/AdvancedSettings.h"
 #include "addons/Skin.h"
 #include "GUITexture.h"
+#include "TextureManager.h"
 #include "utils/Variant.h"
 #include "input/Key.h"
 #include "utils/log.h"
@@ -1194,11 +1196,15 @@ bool CGUIWindowManager::Render()
   CDirtyRegionList dirtyRegions = m_tracker.GetDirtyRegions();
 
   bool hasRendered = false;
+  float screenArea = static_cast<float>(CServiceBroker::GetWinSystem()->GetGfxContext().GetWidth() *
+                                        CServiceBroker::GetWinSystem()->GetGfxContext().GetHeight());
+  float renderedArea = 0.0f;
   // If we visualize the regions we will always render the entire viewport
   if (g_advancedSettings.m_guiVisualizeDirtyRegions || g_advancedSettings.m_guiAlgorithmDirtyRegions == DIRTYREGION_SOLVER_FILL_VIEWPORT_ALWAYS)
   {
     RenderPass();
     hasRendered = true;
+    renderedArea = screenArea;
   }
   else if (g_advancedSettings.m_guiAlgorithmDirtyRegions == DIRTYREGION_SOLVER_FILL_VIEWPORT_ON_CHANGE)
   {
@@ -1206,6 +1212,7 @@ bool CGUIWindowManager::Render()
     {
       RenderPass();
       hasRendered = true;
+      renderedArea = screenArea;
     }
   }
   else
@@ -1218,6 +1225,7 @@ bool CGUIWindowManager::Render()
       CServiceBroker::GetWinSystem()->GetGfxContext().SetScissors(*i);
       RenderPass();
       hasRendered = true;
+      renderedArea += i->Area();
     }
     CServiceBroker::GetWinSystem()->GetGfxContext().ResetScissors();
   }
@@ -1232,12 +1240,17 @@ bool CGUIWindowManager::Render()
       CGUITexture::DrawQuad(*i, 0x4c00ff00);
   }
 
+  if (screenArea > 0.0f)
+    CGUIFrameStatistics::GetInstance().AddDirtyArea(100.0f * renderedArea / screenArea);
+
   return hasRendered;
 }
 
 void CGUIWindowManager::AfterRender()
 {
   m_tracker.CleanMarkedRegions();
+  CServiceBroker::GetGUI()->GetTextureManager().ResetUploadBudget();
+  CGUIFrameStatistics::GetInstance().EndFrame();
 
   CGUIWindow* pWindow = GetWindow(GetActiveWindow());
   if (pWindow)
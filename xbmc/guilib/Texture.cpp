@@ -96,6 +96,7 @@ void CBaseTexture::Allocate(unsigned int width, unsigned int height, unsigned in
 
   _aligned_free(m_pixels);
   m_pixels = NULL;
+  m_compressedMipmaps.clear();
   if (GetPitch() * GetRows() > 0)
   {
     size_t size = GetPitch() * GetRows();
@@ -113,7 +114,7 @@ void CBaseTexture::Update(unsigned int width, unsigned int height, unsigned int
   if (pixels == NULL)
     return;
 
-  if (format & XB_FMT_DXT_MASK)
+  if ((format & XB_FMT_DXT_MASK) && !CServiceBroker::GetRenderSystem()->SupportsDXT())
     return;
 
   Allocate(width, height, format);
@@ -226,6 +227,13 @@ bool CBaseTexture::LoadFromFileInternal(const std::string& texturePath, unsigned
     if (image.ReadFile(texturePath))
     {
       Update(image.GetWidth(), image.GetHeight(), 0, image.GetFormat(), image.GetData(), false);
+      if (m_pixels == nullptr)
+        return false;
+
+      m_hasAlpha = image.GetFormat() != XB_FMT_DXT1;
+      // the mipmaps only fit if the texture didn't need padding
+      if (image.GetMipmapCount() > 1 && m_textureWidth == image.GetWidth() && m_textureHeight == image.GetHeight())
+        m_compressedMipmaps.assign(image.GetData() + image.GetSize(), image.GetData() + image.GetDataSize());
       return true;
     }
     return false;
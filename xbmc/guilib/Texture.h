@@ -14,6 +14,8 @@
 #include "platform/linux/XMemUtils.h"
 #endif
 
+#include <vector>
+
 #pragma pack(1)
 struct COLOR {unsigned char b,g,r,x;};	// Windows GDI expects 4bytes per color
 #pragma pack()
@@ -84,6 +86,7 @@ public:
   virtual void BindToUnit(unsigned int unit) = 0;
 
   unsigned char* GetPixels() const { return m_pixels; }
+  bool IsUploadPending() const { return m_pixels && !m_loadedToGPU; }
   unsigned int GetPitch() const { return GetPitch(m_textureWidth); }
   unsigned int GetRows() const { return GetRows(m_textureHeight); }
   unsigned int GetTextureWidth() const { return m_textureWidth; }
@@ -127,6 +130,7 @@ protected:
   unsigned int m_originalHeight;  ///< original image height before scaling or cropping
 
   unsigned char* m_pixels;
+  std::vector<unsigned char> m_compressedMipmaps;  ///< levels 1 to n of compressed textures loaded from .dds files
   bool m_loadedToGPU;
   unsigned int m_format;
   int m_orientation;
@@ -7,6 +7,7 @@
  */
 
 #include "TextureDX.h"
+#include "GUIFrameStatistics.h"
 #include "utils/log.h"
 
 /************************************************************************/
@@ -68,6 +69,8 @@ void CDXTexture::LoadToGPU()
     return;
   }
 
+  CGUIFrameStatistics::GetInstance().AddTextureUpload(GetPitch() * GetRows());
+
   bool needUpdate = true;
   D3D11_USAGE usage = D3D11_USAGE_DEFAULT;
   if (m_format == XB_FMT_RGB8)
@@ -173,6 +176,8 @@ void CDXTexture::LoadToGPU()
   {
     _aligned_free(m_pixels);
     m_pixels = nullptr;
+    m_compressedMipmaps.clear();
+    m_compressedMipmaps.shrink_to_fit();
   }
 
   m_loadedToGPU = true;
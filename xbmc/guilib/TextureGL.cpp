@@ -11,12 +11,15 @@
 #include "rendering/RenderSystem.h"
 #include "utils/log.h"
 #include "utils/GLUtils.h"
+#include "guilib/GUIFrameStatistics.h"
 #include "guilib/TextureManager.h"
 #include "settings/AdvancedSettings.h"
 #ifdef TARGET_POSIX
 #include "platform/linux/XMemUtils.h"
 #endif
 
+#include <algorithm>
+
 
 /************************************************************************/
 /*    CGLTexture                                                       */
@@ -37,13 +40,48 @@ CGLTexture::~CGLTexture()
 
 void CGLTexture::CreateTextureObject()
 {
-  glGenTextures(1, (GLuint*) &m_texture);
+  // reuse a released texture object of the same size and format, its storage is updated in place
+  unsigned int maxSize = CServiceBroker::GetRenderSystem()->GetMaxTextureSize();
+  unsigned int width = std::min(m_textureWidth, maxSize);
+  unsigned int height = std::min(m_textureHeight, maxSize);
+  unsigned int format = m_format & XB_FMT_MASK;
+  if ((format & XB_FMT_DXT_MASK) == 0)
+    m_texture = CServiceBroker::GetGUI()->GetTextureManager().AcquireHwTexture(width, height, format);
+
+  if (m_texture)
+  {
+    m_storageWidth = width;
+    m_storageHeight = height;
+    m_storageFormat = format;
+  }
+  else
+  {
+    glGenTextures(1, (GLuint*) &m_texture);
+    m_storageFormat = XB_FMT_UNKNOWN;
+  }
 }
 
 void CGLTexture::DestroyTextureObject()
 {
   if (m_texture)
-    CServiceBroker::GetGUI()->GetTextureManager().ReleaseHwTexture(m_texture);
+  {
+    if (m_storageFormat != XB_FMT_UNKNOWN)
+      CServiceBroker::GetGUI()->GetTextureManager().ReleaseHwTexture(m_texture, m_storageWidth, m_storageHeight, m_storageFormat);
+    else
+      CServiceBroker::GetGUI()->GetTextureManager().ReleaseHwTexture(m_texture);
+  }
+}
+
+bool CGLTexture::UpdateStorage(unsigned int format)
+{
+  format &= XB_FMT_MASK;
+  if (m_storageFormat == format && m_storageWidth == m_textureWidth && m_storageHeight == m_textureHeight)
+    return true;
+
+  m_storageWidth = m_textureWidth;
+  m_storageHeight = m_textureHeight;
+  m_storageFormat = format;
+  return false;
 }
 
 void CGLTexture::LoadToGPU()
@@ -53,6 +91,8 @@ void CGLTexture::LoadToGPU()
     // nothing to load - probably same image (no change)
     return;
   }
+
+  CGUIFrameStatistics::GetInstance().AddTextureUpload(GetPitch() * GetRows() + m_compressedMipmaps.size());
   if (m_texture == 0)
   {
     // Have OpenGL generate a texture object handle for us
@@ -65,8 +105,10 @@ void CGLTexture::LoadToGPU()
 
   GLenum filter = (m_scalingMethod == TEXTURE_SCALING::NEAREST ? GL_NEAREST : GL_LINEAR);
 
+  bool compressedMipmaps = !m_compressedMipmaps.empty();
+
   // Set the texture's stretching properties
-  if (IsMipmapped())
+  if (IsMipmapped() || compressedMipmaps)
   {
     GLenum mipmapFilter = (m_scalingMethod == TEXTURE_SCALING::NEAREST ? GL_LINEAR_MIPMAP_NEAREST : GL_LINEAR_MIPMAP_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, mipmapFilter);
@@ -74,7 +116,7 @@ void CGLTexture::LoadToGPU()
 #ifndef HAS_GLES
     // Lower LOD bias equals more sharpness, but less smooth animation
     glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_LOD_BIAS, -0.5f);
-    if (!m_isOglVersion3orNewer)
+    if (!m_isOglVersion3orNewer && !compressedMipmaps)
       glTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_TRUE);
 #endif
   }
@@ -129,18 +171,40 @@ void CGLTexture::LoadToGPU()
 
   if ((m_format & XB_FMT_DXT_MASK) == 0)
   {
-    glTexImage2D(GL_TEXTURE_2D, 0, numcomponents,
-                 m_textureWidth, m_textureHeight, 0,
-                 format, GL_UNSIGNED_BYTE, m_pixels);
+    if (UpdateStorage(m_format))
+      glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0,
+                      m_textureWidth, m_textureHeight,
+                      format, GL_UNSIGNED_BYTE, m_pixels);
+    else
+      glTexImage2D(GL_TEXTURE_2D, 0, numcomponents,
+                   m_textureWidth, m_textureHeight, 0,
+                   format, GL_UNSIGNED_BYTE, m_pixels);
   }
   else
   {
+    m_storageFormat = XB_FMT_UNKNOWN;
     glCompressedTexImage2D(GL_TEXTURE_2D, 0, format,
                            m_textureWidth, m_textureHeight, 0,
                            GetPitch() * GetRows(), m_pixels);
+
+    // the mipmaps of .dds files can't be generated, each level is half the size of the previous one
+    GLint level = 0;
+    size_t offset = 0;
+    for (unsigned int width = m_textureWidth, height = m_textureHeight; width > 1 || height > 1;)
+    {
+      width = std::max(width / 2, 1U);
+      height = std::max(height / 2, 1U);
+      size_t size = GetPitch(width) * GetRows(height);
+      if (offset + size > m_compressedMipmaps.size())
+        break;
+      glCompressedTexImage2D(GL_TEXTURE_2D, ++level, format, width, height, 0,
+                             size, m_compressedMipmaps.data() + offset);
+      offset += size;
+    }
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, level);
   }
 
-  if (IsMipmapped() && m_isOglVersion3orNewer)
+  if (IsMipmapped() && m_isOglVersion3orNewer && !compressedMipmaps)
   {
     glGenerateMipmap(GL_TEXTURE_2D);
   }
@@ -190,8 +254,12 @@ void CGLTexture::LoadToGPU()
       }
       break;
   }
-  glTexImage2D(GL_TEXTURE_2D, 0, internalformat, m_textureWidth, m_textureHeight, 0,
-    pixelformat, GL_UNSIGNED_BYTE, m_pixels);
+  if (UpdateStorage(m_format))
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, m_textureWidth, m_textureHeight,
+      pixelformat, GL_UNSIGNED_BYTE, m_pixels);
+  else
+    glTexImage2D(GL_TEXTURE_2D, 0, internalformat, m_textureWidth, m_textureHeight, 0,
+      pixelformat, GL_UNSIGNED_BYTE, m_pixels);
 
   if (IsMipmapped())
   {
@@ -205,6 +273,8 @@ void CGLTexture::LoadToGPU()
   {
     _aligned_free(m_pixels);
     m_pixels = NULL;
+    m_compressedMipmaps.clear();
+    m_compressedMipmaps.shrink_to_fit();
   }
 
   m_loadedToGPU = true;
@@ -27,7 +27,15 @@ public:
   void BindToUnit(unsigned int unit) override;
 
 protected:
+  /*! \brief Whether the texture object's storage can be updated in place
+   Otherwise the storage is (re)allocated and recorded for the next upload.
+   */
+  bool UpdateStorage(unsigned int format);
+
   GLuint m_texture = 0;
   bool m_isOglVersion3orNewer = false;
+  unsigned int m_storageWidth = 0;
+  unsigned int m_storageHeight = 0;
+  unsigned int m_storageFormat = XB_FMT_UNKNOWN; //!< XB_FMT_UNKNOWN if the texture object has no reusable storage
 };
 
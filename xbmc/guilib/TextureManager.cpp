@@ -8,6 +8,7 @@
 
 #include "TextureManager.h"
 
+#include <algorithm>
 #include <cassert>
 
 #include "addons/Skin.h"
@@ -17,6 +18,7 @@
 #include "Texture.h"
 #include "threads/SingleLock.h"
 #include "threads/SystemClock.h"
+#include "settings/AdvancedSettings.h"
 #include "URL.h"
 #include "utils/log.h"
 #include "utils/StringUtils.h"
@@ -31,6 +33,12 @@
 #endif
 #include "FFmpegImage.h"
 
+namespace
+{
+// maximum storage of released texture objects kept for reuse
+const size_t HW_TEXTURE_POOL_SIZE = 64 * 1024 * 1024;
+}
+
 /************************************************************************/
 /*                                                                      */
 /************************************************************************/
@@ -498,6 +506,14 @@ void CGUITextureManager::FreeUnusedTextures(unsigned int timeDelay)
       ++i;
   }
 
+  // pooled texture objects which haven't been reused in time are deleted as well
+  while (!m_hwTexturePool.empty() && currFrameTime - m_hwTexturePool.back().releaseTime >= timeDelay)
+  {
+    m_hwTexturePoolSize -= GetHwTextureSize(m_hwTexturePool.back());
+    m_unusedHwTextures.push_back(m_hwTexturePool.back().texture);
+    m_hwTexturePool.pop_back();
+  }
+
 #if defined(HAS_GL) || defined(HAS_GLES)
   for (unsigned int i = 0; i < m_unusedHwTextures.size(); ++i)
   {
@@ -520,6 +536,72 @@ void CGUITextureManager::ReleaseHwTexture(unsigned int texture)
   m_unusedHwTextures.push_back(texture);
 }
 
+void CGUITextureManager::ReleaseHwTexture(unsigned int texture, unsigned int width, unsigned int height, unsigned int format)
+{
+  CHwTexture hwTexture = { texture, width, height, format, XbmcThreads::SystemClockMillis() };
+  size_t size = GetHwTextureSize(hwTexture);
+
+  CSingleLock lock(CServiceBroker::GetWinSystem()->GetGfxContext());
+  if (size > HW_TEXTURE_POOL_SIZE / 4)
+  {
+    m_unusedHwTextures.push_back(texture);
+    return;
+  }
+
+  m_hwTexturePool.push_front(hwTexture);
+  m_hwTexturePoolSize += size;
+
+  while (m_hwTexturePoolSize > HW_TEXTURE_POOL_SIZE)
+  {
+    m_hwTexturePoolSize -= GetHwTextureSize(m_hwTexturePool.back());
+    m_unusedHwTextures.push_back(m_hwTexturePool.back().texture);
+    m_hwTexturePool.pop_back();
+  }
+}
+
+unsigned int CGUITextureManager::AcquireHwTexture(unsigned int width, unsigned int height, unsigned int format)
+{
+  CSingleLock lock(CServiceBroker::GetWinSystem()->GetGfxContext());
+  for (auto it = m_hwTexturePool.begin(); it != m_hwTexturePool.end(); ++it)
+  {
+    if (it->width == width && it->height == height && it->format == format)
+    {
+      unsigned int texture = it->texture;
+      m_hwTexturePoolSize -= GetHwTextureSize(*it);
+      m_hwTexturePool.erase(it);
+      return texture;
+    }
+  }
+  return 0;
+}
+
+bool CGUITextureManager::ReserveUpload(const CBaseTexture *texture)
+{
+  // the same texture is often shown by several controls
+  if (std::find(m_uploads.begin(), m_uploads.end(), texture) != m_uploads.end())
+    return true;
+
+  size_t bytes = static_cast<size_t>(texture->GetPitch()) * texture->GetRows();
+  size_t budget = static_cast<size_t>(g_advancedSettings.m_guiTextureUploadBudgetKB) * 1024;
+  if (!m_uploads.empty() && budget > 0 && m_uploadedBytes + bytes > budget)
+    return false;
+
+  m_uploads.push_back(texture);
+  m_uploadedBytes += bytes;
+  return true;
+}
+
+void CGUITextureManager::ResetUploadBudget()
+{
+  m_uploads.clear();
+  m_uploadedBytes = 0;
+}
+
+size_t CGUITextureManager::GetHwTextureSize(const CHwTexture &texture)
+{
+  return static_cast<size_t>(texture.width) * texture.height * (texture.format == XB_FMT_RGB8 ? 3 : 4);
+}
+
 void CGUITextureManager::Cleanup()
 {
   CSingleLock lock(CServiceBroker::GetWinSystem()->GetGfxContext());
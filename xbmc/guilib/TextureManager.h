@@ -111,10 +111,52 @@ public:
 
   void FreeUnusedTextures(unsigned int timeDelay = 0); ///< Free textures (called from app thread only)
   void ReleaseHwTexture(unsigned int texture);
+
+  /*! \brief Release a texture object for reuse by a texture of the same size and format
+   \param texture the texture object
+   \param width the width of the texture object's storage
+   \param height the height of the texture object's storage
+   \param format the XB_FMT_* format of the texture object's storage
+   \sa AcquireHwTexture
+   */
+  void ReleaseHwTexture(unsigned int texture, unsigned int width, unsigned int height, unsigned int format);
+
+  /*! \brief Take a released texture object with storage of the given size and format
+   \return the texture object or 0 if none is available
+   \sa ReleaseHwTexture
+   */
+  unsigned int AcquireHwTexture(unsigned int width, unsigned int height, unsigned int format);
+
+  /*! \brief Reserve the upload of a texture to the GPU in the current frame
+   The first upload of a frame is always granted, further ones only while the
+   frame's upload budget isn't used up. Called from the render thread only.
+   \param texture the texture to upload
+   \return true if the texture may be uploaded now, false if it should be retried in the next frame
+   */
+  bool ReserveUpload(const CBaseTexture *texture);
+
+  /*! \brief Start a new upload budget, called once per rendered frame
+   */
+  void ResetUploadBudget();
 protected:
+  struct CHwTexture
+  {
+    unsigned int texture;
+    unsigned int width;
+    unsigned int height;
+    unsigned int format;
+    unsigned int releaseTime;
+  };
+
+  static size_t GetHwTextureSize(const CHwTexture &texture);
+
   std::vector<CTextureMap*> m_vecTextures;
   std::list<std::pair<CTextureMap*, unsigned int> > m_unusedTextures;
   std::vector<unsigned int> m_unusedHwTextures;
+  std::list<CHwTexture> m_hwTexturePool; //!< most recently released first
+  size_t m_hwTexturePoolSize = 0;
+  std::vector<const CBaseTexture*> m_uploads; //!< reserved in the current frame
+  size_t m_uploadedBytes = 0;
   typedef std::vector<CTextureMap*>::iterator ivecTextures;
   typedef std::list<std::pair<CTextureMap*, unsigned int> >::iterator ilistUnused;
   // we have 2 texture bundles (one for the base textures, one for the theme)
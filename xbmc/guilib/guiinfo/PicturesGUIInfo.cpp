@@ -16,6 +16,7 @@
 #include "guilib/GUIComponent.h"
 #include "guilib/GUIWindowManager.h"
 #include "pictures/GUIWindowSlideShow.h"
+#include "pictures/PictureDatabase.h"
 #include "pictures/PictureInfoTag.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
@@ -96,8 +97,27 @@ void CPicturesGUIInfo::SetCurrentSlide(CFileItem *item)
   if (item)
   {
     CPictureInfoTag* tag = item->GetPictureInfoTag();  // creates item if not yet set, so no nullptr checks needed
-    if (!tag->Loaded()) // If picture metadata has not been loaded yet, load it now
-      tag->Load(item->GetPath());
+    if (!tag->Loaded()) // If picture metadata has not been loaded yet, get it from the index or load it now
+    {
+      CPictureDatabase db;
+      CPictureDatabase::CEntry entry;
+      int64_t size;
+      std::string mtime;
+      bool hasKey = CPictureDatabase::GetFileKey(*item, size, mtime) && db.Open();
+      if (hasKey && db.GetPictureInfo(item->GetPath(), entry) && entry.size == size && entry.mtime == mtime)
+        *tag = entry.tag;
+      else
+      {
+        tag->Load(item->GetPath());
+        if (hasKey)
+        {
+          entry.size = size;
+          entry.mtime = mtime;
+          entry.tag = *tag;
+          db.SetPictureInfos({{item->GetPath(), entry}});
+        }
+      }
+    }
 
     m_currentSlide.reset(new CFileItem(*item));
   }
@@ -7,18 +7,47 @@
  */
 
 #include "InfoBool.h"
+#include "guilib/GUIListItem.h"
 #include "utils/StringUtils.h"
 
+#include <atomic>
+
+namespace
+{
+// ids are never reused, so values cached on listitems can't outlive their condition
+std::atomic<unsigned int> lastId(0);
+}
+
 namespace INFO
 {
   InfoBool::InfoBool(const std::string &expression, int context, unsigned int &refreshCounter)
     : m_value(false),
       m_context(context),
       m_listItemDependent(false),
+      m_listItemStatic(false),
+      m_id(++lastId),
       m_expression(expression),
       m_refreshCounter(0),
       m_parentRefreshCounter(refreshCounter)
   {
     StringUtils::ToLower(m_expression);
   }
+
+  bool InfoBool::GetCached(const CGUIListItem *item)
+  {
+    // string conditions of plain listitems are evaluated for the focused item
+    if (!item->IsFileItem())
+    {
+      Update(item);
+      return m_value;
+    }
+
+    bool value;
+    if (item->GetCachedCondition(m_id, value))
+      return value;
+
+    Update(item);
+    item->SetCachedCondition(m_id, m_value);
+    return m_value;
+  }
 }
@@ -34,7 +34,11 @@ public:
   inline bool Get(const CGUIListItem *item = NULL)
   {
     if (item && m_listItemDependent)
+    {
+      if (m_listItemStatic)
+        return GetCached(item);
       Update(item);
+    }
     else if (m_refreshCounter != m_parentRefreshCounter || m_refreshCounter == 0)
     {
       Update(NULL);
@@ -66,14 +70,19 @@ public:
 
   const std::string &GetExpression() const { return m_expression; }
   bool ListItemDependent() const { return m_listItemDependent; }
+  bool ListItemStatic() const { return m_listItemStatic; }
 protected:
 
   bool m_value;                ///< current value
   int m_context;               ///< contextual information to go with the condition
   bool m_listItemDependent;    ///< do not cache if a listitem pointer is given
+  bool m_listItemStatic;       ///< only depends on the listitem's own data, so the value is cached on the listitem
+  unsigned int m_id;           ///< unique id the value is cached under
   std::string  m_expression;   ///< original expression
 
 private:
+  bool GetCached(const CGUIListItem *item);
+
   unsigned int m_refreshCounter;
   unsigned int &m_parentRefreshCounter;
 };
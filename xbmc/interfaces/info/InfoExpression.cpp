@@ -19,7 +19,9 @@ using namespace INFO;
 
 void InfoSingle::Initialize()
 {
-  m_condition = CServiceBroker::GetGUI()->GetInfoManager().TranslateSingleString(m_expression, m_listItemDependent);
+  CGUIInfoManager& infoMgr = CServiceBroker::GetGUI()->GetInfoManager();
+  m_condition = infoMgr.TranslateSingleString(m_expression, m_listItemDependent);
+  m_listItemStatic = m_listItemDependent && infoMgr.IsListItemStatic(m_condition);
 }
 
 void InfoSingle::Update(const CGUIListItem *item)
@@ -205,6 +207,8 @@ bool InfoExpression::Parse(const std::string &expression)
   // The next two are for syntax-checking purposes
   bool after_binaryoperator = true;
   int bracket_count = 0;
+  // cache the value on the listitem only if all operands can be cached
+  bool listItemStatic = true;
 
   CGUIInfoManager& infoMgr = CServiceBroker::GetGUI()->GetInfoManager();
 
@@ -242,6 +246,7 @@ bool InfoExpression::Parse(const std::string &expression)
         }
         /* Propagate any listItem dependency from the operand to the expression */
         m_listItemDependent |= info->ListItemDependent();
+        listItemStatic &= info->ListItemStatic();
         nodes.push(std::make_shared<InfoLeaf>(info, invert));
         /* Reuse operand string for next operand */
         operand.clear();
@@ -293,11 +298,13 @@ bool InfoExpression::Parse(const std::string &expression)
     }
     /* Propagate any listItem dependency from the operand to the expression */
     m_listItemDependent |= info->ListItemDependent();
+    listItemStatic &= info->ListItemStatic();
     nodes.push(std::make_shared<InfoLeaf>(info, invert));
   }
   while (!operator_stack.empty())
     OperatorPop(operator_stack, invert, nodes);
 
   m_expression_tree = nodes.top();
+  m_listItemStatic = m_listItemDependent && listItemStatic;
   return true;
 }
@@ -12,6 +12,8 @@
 #include "messaging/ApplicationMessenger.h"
 #include "GUIInfoManager.h"
 #include "guilib/GUIComponent.h"
+#include "guilib/GUIControlFactory.h"
+#include "guilib/GUIFrameStatistics.h"
 #include "guilib/GUIWindowManager.h"
 #include "input/Key.h"
 #include "input/WindowTranslator.h"
@@ -122,6 +124,66 @@ JSONRPC_STATUS CGUIOperations::GetStereoscopicModes(const std::string &method, I
   return OK;
 }
 
+static CVariant PercentilesToVariant(const CGUIFrameStatistics::Percentiles &percentiles)
+{
+  CVariant result(CVariant::VariantTypeObject);
+  result["p50"] = percentiles.p50;
+  result["p95"] = percentiles.p95;
+  result["p99"] = percentiles.p99;
+  result["max"] = percentiles.max;
+  return result;
+}
+
+JSONRPC_STATUS CGUIOperations::GetFrameStatistics(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant &parameterObject, CVariant &result)
+{
+  CGUIFrameStatistics::Snapshot snapshot = CGUIFrameStatistics::GetInstance().GetSnapshot();
+
+  result["frames"] = snapshot.frames;
+  result["frametime"] = PercentilesToVariant(snapshot.frameMs);
+  result["dirtyarea"] = PercentilesToVariant(snapshot.dirtyArea);
+  result["textureuploads"] = snapshot.textureUploads;
+  result["textureuploadkb"] = PercentilesToVariant(snapshot.textureUploadKB);
+  result["deferredtextureuploads"] = snapshot.deferredTextureUploads;
+  result["fontcachemisses"] = snapshot.fontCacheMisses;
+
+  result["windows"] = CVariant(CVariant::VariantTypeArray);
+  for (const auto &window : snapshot.windows)
+  {
+    CVariant item(CVariant::VariantTypeObject);
+    item["id"] = window.id;
+    item["name"] = CWindowTranslator::TranslateWindow(window.id);
+    item["frames"] = window.frames;
+    item["processtime"] = PercentilesToVariant(window.processMs);
+    item["rendertime"] = PercentilesToVariant(window.renderMs);
+    result["windows"].push_back(item);
+  }
+
+  result["controlframes"] = snapshot.controlFrames;
+  result["controls"] = CVariant(CVariant::VariantTypeArray);
+  for (const auto &control : snapshot.controls)
+  {
+    CVariant item(CVariant::VariantTypeObject);
+    item["type"] = CGUIControlFactory::TranslateControlType(control.type);
+    item["processcalls"] = control.processCalls;
+    item["rendercalls"] = control.renderCalls;
+    item["processtime"] = control.processMs;
+    item["rendertime"] = control.renderMs;
+    result["controls"].push_back(item);
+  }
+
+  return OK;
+}
+
+JSONRPC_STATUS CGUIOperations::SetFrameStatistics(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant &parameterObject, CVariant &result)
+{
+  if (parameterObject["reset"].asBoolean())
+    CGUIFrameStatistics::GetInstance().Reset();
+  if (parameterObject["controls"].isBoolean())
+    CGUIFrameStatistics::GetInstance().SetControlStatisticsEnabled(parameterObject["controls"].asBoolean());
+
+  return ACK;
+}
+
 JSONRPC_STATUS CGUIOperations::GetPropertyValue(const std::string &property, CVariant &result)
 {
   if (property == "currentwindow")
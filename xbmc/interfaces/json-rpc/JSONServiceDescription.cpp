@@ -160,6 +160,8 @@ JsonRpcMethodMap CJSONServiceDescription::m_methodMaps[] = {
   { "GUI.SetFullscreen",                            CGUIOperations::SetFullscreen },
   { "GUI.SetStereoscopicMode",                      CGUIOperations::SetStereoscopicMode },
   { "GUI.GetStereoscopicModes",                     CGUIOperations::GetStereoscopicModes },
+  { "GUI.GetFrameStatistics",                       CGUIOperations::GetFrameStatistics },
+  { "GUI.SetFrameStatistics",                       CGUIOperations::SetFrameStatistics },
 
 // PVR operations
   { "PVR.GetProperties",                            CPVROperations::GetProperties },
@@ -232,7 +234,9 @@ JsonRpcMethodMap CJSONServiceDescription::m_methodMaps[] = {
 
 // XBMC operations
   { "XBMC.GetInfoLabels",                           CXBMCOperations::GetInfoLabels },
-  { "XBMC.GetInfoBooleans",                         CXBMCOperations::GetInfoBooleans }
+  { "XBMC.GetInfoBooleans",                         CXBMCOperations::GetInfoBooleans },
+  { "XBMC.GetLockStatistics",                       CXBMCOperations::GetLockStatistics },
+  { "XBMC.SetLockProfiler",                         CXBMCOperations::SetLockProfiler }
 };
 
 JSONSchemaTypeDefinition::JSONSchemaTypeDefinition()
@@ -10,6 +10,7 @@
 #include "messaging/ApplicationMessenger.h"
 #include "utils/Variant.h"
 #include "powermanagement/PowerManager.h"
+#include "threads/LockProfiler.h"
 #include "ServiceBroker.h"
 
 using namespace JSONRPC;
@@ -84,3 +85,33 @@ JSONRPC_STATUS CXBMCOperations::GetInfoBooleans(const std::string &method, ITran
 
   return OK;
 }
+
+JSONRPC_STATUS CXBMCOperations::GetLockStatistics(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant &parameterObject, CVariant &result)
+{
+  result["enabled"] = CLockProfiler::IsEnabled();
+  result["locks"] = CVariant(CVariant::VariantTypeArray);
+  for (const auto &lock : CLockProfiler::GetInstance().GetStatistics(static_cast<size_t>(parameterObject["limit"].asUnsignedInteger())))
+  {
+    CVariant item(CVariant::VariantTypeObject);
+    item["tag"] = lock.tag;
+    item["acquisitions"] = lock.acquisitions;
+    item["contentions"] = lock.contentions;
+    item["waittime"] = lock.waitMs;
+    item["maxwaittime"] = lock.maxWaitMs;
+    item["holdtime"] = lock.holdMs;
+    item["maxholdtime"] = lock.maxHoldMs;
+    result["locks"].push_back(item);
+  }
+
+  return OK;
+}
+
+JSONRPC_STATUS CXBMCOperations::SetLockProfiler(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant &parameterObject, CVariant &result)
+{
+  if (parameterObject["reset"].asBoolean())
+    CLockProfiler::GetInstance().Reset();
+  if (parameterObject["enabled"].isBoolean())
+    CLockProfiler::GetInstance().SetEnabled(parameterObject["enabled"].asBoolean());
+
+  return ACK;
+}
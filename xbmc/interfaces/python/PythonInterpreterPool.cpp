@@ -0,0 +1,132 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+// python.h should always be included first before any other includes
+#include <Python.h>
+
+#include "PythonInterpreterPool.h"
+#include "settings/AdvancedSettings.h"
+#include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
+#include "utils/log.h"
+
+#include <algorithm>
+
+_ts* CPythonInterpreterPool::Acquire(const std::string &key, LanguageHookRef &languageHook)
+{
+  CSingleLock lock(m_critSection);
+  auto it = std::find_if(m_entries.rbegin(), m_entries.rend(), [&key](const CEntry &entry)
+  {
+    return entry.key == key;
+  });
+  if (it == m_entries.rend())
+    return nullptr;
+
+  CEntry entry = *it;
+  m_entries.erase(std::next(it).base());
+  lock.Leave();
+
+  // thread states belong to the thread that created them, so hand over the interpreter
+  // to a new one for the calling thread
+  PyThreadState *threadState = PyThreadState_New(entry.threadState->interp);
+  PyThreadState_Swap(threadState);
+  PyThreadState_Clear(entry.threadState);
+  PyThreadState_Delete(entry.threadState);
+
+  languageHook = entry.languageHook;
+  return threadState;
+}
+
+bool CPythonInterpreterPool::Release(const std::string &key, _ts *threadState, const LanguageHookRef &languageHook)
+{
+  const size_t poolSize = static_cast<size_t>(std::max(g_advancedSettings.m_pythonInterpreterPoolSize, 0));
+  if (poolSize == 0)
+    return false;
+
+  std::vector<CEntry> evicted;
+  {
+    CSingleLock lock(m_critSection);
+    while (m_entries.size() >= poolSize)
+    {
+      evicted.push_back(m_entries.front());
+      m_entries.erase(m_entries.begin());
+    }
+    m_entries.push_back({key, threadState, languageHook, XbmcThreads::SystemClockMillis()});
+  }
+
+  // the GIL is held already
+  for (auto &entry : evicted)
+    EndInterpreter(entry);
+
+  return true;
+}
+
+void CPythonInterpreterPool::Cleanup()
+{
+  const unsigned int idleTime = g_advancedSettings.m_pythonInterpreterIdleTime * 1000;
+  const unsigned int now = XbmcThreads::SystemClockMillis();
+
+  std::vector<CEntry> expired;
+  {
+    CSingleLock lock(m_critSection);
+    for (auto it = m_entries.begin(); it != m_entries.end(); )
+    {
+      if (now - it->lastUsed >= idleTime)
+      {
+        expired.push_back(*it);
+        it = m_entries.erase(it);
+      }
+      else
+        ++it;
+    }
+  }
+
+  EndInterpreters(expired);
+}
+
+void CPythonInterpreterPool::Clear()
+{
+  std::vector<CEntry> entries;
+  {
+    CSingleLock lock(m_critSection);
+    entries.swap(m_entries);
+  }
+
+  EndInterpreters(entries);
+}
+
+bool CPythonInterpreterPool::IsEmpty() const
+{
+  CSingleLock lock(m_critSection);
+  return m_entries.empty();
+}
+
+void CPythonInterpreterPool::EndInterpreters(std::vector<CEntry> &entries)
+{
+  if (entries.empty())
+    return;
+
+  PyEval_AcquireLock();
+  for (auto &entry : entries)
+    EndInterpreter(entry);
+  PyEval_ReleaseLock();
+}
+
+void CPythonInterpreterPool::EndInterpreter(CEntry &entry)
+{
+  CLog::Log(LOGDEBUG, "CPythonInterpreterPool: ending interpreter of %s", entry.key.c_str());
+
+  PyThreadState *threadState = PyThreadState_New(entry.threadState->interp);
+  PyThreadState *old = PyThreadState_Swap(threadState);
+  PyThreadState_Clear(entry.threadState);
+  PyThreadState_Delete(entry.threadState);
+  Py_EndInterpreter(threadState);
+  PyThreadState_Swap(old);
+
+  entry.languageHook->UnregisterMe();
+}
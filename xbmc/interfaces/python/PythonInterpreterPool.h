@@ -0,0 +1,70 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "interfaces/python/LanguageHook.h"
+#include "threads/CriticalSection.h"
+
+#include <string>
+#include <vector>
+
+struct _ts;
+
+/*!
+ \brief Sub-interpreters of plugins kept for the next invocation of the same plugin.
+
+ Creating a sub-interpreter and importing the xbmc modules, the standard library and the
+ script modules a plugin depends on makes up most of the time of a short directory listing.
+ After a successful run the interpreter of a plugin is kept for a while instead, the plugin's
+ own modules and the globals of the script are removed before (see CPythonInvoker), so that
+ nothing like the handle taken from sys.argv is carried over into the next invocation.
+
+ Acquire() and Release() are called by the invoker with the GIL held, Cleanup() and Clear()
+ acquire the GIL themselves.
+ */
+class CPythonInterpreterPool
+{
+public:
+  typedef XBMCAddon::AddonClass::Ref<XBMCAddon::Python::PythonLanguageHook> LanguageHookRef;
+
+  /*! \brief Take a kept interpreter out of the pool.
+   \param key identifies the plugin and script
+   \param languageHook [out] the language hook registered for the interpreter
+   \return a thread state of the interpreter for the calling thread, which is made the current
+           one, or nullptr if no interpreter was kept for the key.
+   */
+  _ts* Acquire(const std::string &key, LanguageHookRef &languageHook);
+
+  /*! \brief Keep the interpreter of the current thread state.
+   The least recently used interpreter is ended if the pool is full.
+   \return false if interpreters aren't kept, the caller has to end it then.
+   */
+  bool Release(const std::string &key, _ts *threadState, const LanguageHookRef &languageHook);
+
+  /*! \brief End interpreters which haven't been used for the configured idle time.
+   */
+  void Cleanup();
+  void Clear();
+  bool IsEmpty() const;
+
+private:
+  struct CEntry
+  {
+    std::string key;
+    _ts *threadState;
+    LanguageHookRef languageHook;
+    unsigned int lastUsed;
+  };
+
+  static void EndInterpreters(std::vector<CEntry> &entries);
+  static void EndInterpreter(CEntry &entry);
+
+  std::vector<CEntry> m_entries;
+  mutable CCriticalSection m_critSection;
+};
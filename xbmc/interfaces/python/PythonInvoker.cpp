@@ -24,10 +24,12 @@
 #include "guilib/GUIWindowManager.h"
 #include "guilib/LocalizeStrings.h"
 #include "interfaces/python/PyContext.h"
+#include "interfaces/python/PythonInterpreterPool.h"
 #include "interfaces/python/pythreadstate.h"
 #include "interfaces/python/swig.h"
 #include "interfaces/python/XBPython.h"
 #include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
 #if defined(TARGET_WINDOWS)
 #include "utils/CharsetConverter.h"
 #endif // defined(TARGET_WINDOWS)
@@ -159,8 +161,33 @@ bool CPythonInvoker::execute(const std::string &script, const std::vector<std::s
   std::string scriptDir = URIUtils::GetDirectory(realFilename);
   URIUtils::RemoveSlashAtEnd(scriptDir);
 
+  // the interpreters of plugins are kept for the next listing of the same plugin
+  m_poolKey.clear();
+  if (m_addon && m_addon->Type() == ADDON::ADDON_PLUGIN &&
+      !arguments.empty() && StringUtils::StartsWith(arguments[0], "plugin://"))
+    m_poolKey = m_addon->ID() + "|" + m_addon->Version().asString() + "|" + m_sourceFile;
+
+  m_startTime = XbmcThreads::SystemClockMillis();
+  m_warmStart = false;
+
   // get the global lock
   PyEval_AcquireLock();
+  if (!m_threadState && !m_poolKey.empty())
+  {
+    m_threadState = CServiceBroker::GetXBPython().GetInterpreterPool().Acquire(m_poolKey, m_languageHook);
+    if (m_threadState)
+    {
+      // modules and paths are set up already, only the abort flag set after the last run is left
+      m_warmStart = true;
+      PyObject *m = PyImport_AddModule("xbmc");
+      if (m == NULL || PyObject_SetAttrString(m, "abortRequested", PyBool_FromLong(0)))
+        CLog::Log(LOGERROR, "CPythonInvoker(%d, %s): failed to reset abortRequested", GetId(), m_sourceFile.c_str());
+
+      setState(InvokerStateInitialized);
+      CLog::Log(LOGDEBUG, "CPythonInvoker(%d, %s): reusing the interpreter of a previous invocation", GetId(), m_sourceFile.c_str());
+    }
+  }
+
   if (!m_threadState)
   {
     m_threadState = Py_NewInterpreter();
@@ -252,7 +279,8 @@ bool CPythonInvoker::execute(const std::string &script, const std::vector<std::s
     PyThreadState_Swap(m_threadState);
 
   // set current directory and python's path.
-  PySys_SetArgv(argc, &argv[0]);
+  // a kept interpreter has the script's directory in its path already
+  PySys_SetArgvEx(argc, &argv[0], m_warmStart ? 0 : 1);
 
   CLog::Log(LOGDEBUG, "CPythonInvoker(%d, %s): entering source directory %s", GetId(), m_sourceFile.c_str(), scriptDir.c_str());
   PyObject* module = PyImport_AddModule("__main__");
@@ -327,6 +355,9 @@ bool CPythonInvoker::execute(const std::string &script, const std::vector<std::s
   if (!failed && !PyErr_Occurred())
   {
     CLog::Log(LOGINFO, "CPythonInvoker(%d, %s): script successfully run", GetId(), m_sourceFile.c_str());
+    if (!m_poolKey.empty())
+      CLog::Log(LOGDEBUG, "CPythonInvoker(%d, %s): plugin run took %u ms with a %s interpreter", GetId(), m_sourceFile.c_str(),
+                XbmcThreads::SystemClockMillis() - m_startTime, m_warmStart ? "kept" : "new");
     stateToSet = InvokerStateScriptDone;
     onSuccess();
   }
@@ -521,6 +552,20 @@ void CPythonInvoker::onExecutionDone()
 
     onDeinitialization();
 
+    if (keepInterpreter())
+    {
+      PyThreadState_Swap(NULL);
+      PyEval_ReleaseLock();
+
+      m_stoppedEvent.Set();
+      m_threadState = nullptr;
+      m_languageHook.reset();
+
+      setState(InvokerStateExecutionDone);
+      ILanguageInvoker::onExecutionDone();
+      return;
+    }
+
     // run the gc before finishing
     //
     // if the script exited by throwing a SystemExit exception then going back
@@ -558,6 +603,69 @@ void CPythonInvoker::onExecutionDone()
   ILanguageInvoker::onExecutionDone();
 }
 
+bool CPythonInvoker::keepInterpreter()
+{
+  // the interpreter must be left as if it was new, so nothing which might still be running
+  // or refer to the script is kept
+  if (m_poolKey.empty() || m_stop || m_systemExitThrown || GetState() != InvokerStateScriptDone ||
+      m_threadState->interp->tstate_head != m_threadState || m_threadState->next != NULL)
+    return false;
+
+  // drop the globals of the script, e.g. the handle taken from sys.argv
+  PyObject *mainDict = PyModule_GetDict(PyImport_AddModule("__main__")); // borrowed ref
+  PyDict_Clear(mainDict);
+  PyObject *builtins = PyImport_ImportModule("__builtin__");
+  if (builtins != NULL)
+  {
+    PyDict_SetItemString(mainDict, "__builtins__", builtins);
+    Py_DECREF(builtins);
+  }
+  PyObject *name = PyString_FromString("__main__");
+  PyDict_SetItemString(mainDict, "__name__", name);
+  Py_DECREF(name);
+
+  // drop the modules of the plugin itself, they are imported again by the next invocation
+  std::string addonPath = CSpecialProtocol::TranslatePath(m_addon->Path());
+#ifdef TARGET_WINDOWS
+  g_charsetConverter.utf8ToSystem(addonPath, true);
+#endif
+  PyObject *modules = PyImport_GetModuleDict(); // borrowed ref
+  PyObject *keys = PyDict_Keys(modules);
+  for (Py_ssize_t i = 0; keys != NULL && i < PyList_Size(keys); i++)
+  {
+    PyObject *key = PyList_GetItem(keys, i); // borrowed ref
+    PyObject *module = PyDict_GetItem(modules, key); // borrowed ref
+    if (module == Py_None)
+    {
+      PyDict_DelItem(modules, key);
+      continue;
+    }
+
+    PyObject *file = PyObject_GetAttrString(module, "__file__");
+    if (file == NULL)
+    {
+      PyErr_Clear();
+      continue;
+    }
+    if (PyString_Check(file) && StringUtils::StartsWith(PyString_AsString(file), addonPath))
+      PyDict_DelItem(modules, key);
+    Py_DECREF(file);
+  }
+  Py_XDECREF(keys);
+
+  if (PyRun_SimpleString(GC_SCRIPT) == -1)
+    CLog::Log(LOGERROR, "CPythonInvoker(%d, %s): failed to run the gc before keeping the Interpreter", GetId(), m_sourceFile.c_str());
+
+  // objects of the script still alive would be bound to the next invocation
+  if (m_languageHook->HasRegisteredAddonClasses() || PyErr_Occurred())
+  {
+    PyErr_Clear();
+    return false;
+  }
+
+  return CServiceBroker::GetXBPython().GetInterpreterPool().Release(m_poolKey, m_threadState, m_languageHook);
+}
+
 void CPythonInvoker::onExecutionFailed()
 {
   PyThreadState_Swap(NULL);
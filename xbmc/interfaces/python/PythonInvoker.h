@@ -61,6 +61,7 @@ private:
   void addPath(const std::string& path); // add path in UTF-8 encoding
   void addNativePath(const std::string& path); // add path in system/Python encoding
   void getAddonModuleDeps(const ADDON::AddonPtr& addon, std::set<std::string>& paths);
+  bool keepInterpreter();
 
   std::string m_pythonPath;
   _ts *m_threadState;
@@ -70,5 +71,9 @@ private:
   XBMCAddon::AddonClass::Ref<XBMCAddon::Python::PythonLanguageHook> m_languageHook;
   bool m_systemExitThrown = false;
 
+  std::string m_poolKey; //!< set if the interpreter may be kept for the next invocation
+  bool m_warmStart = false;
+  unsigned int m_startTime = 0;
+
   static CCriticalSection s_critical;
 };
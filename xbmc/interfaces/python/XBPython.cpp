@@ -32,6 +32,7 @@
 #include "interfaces/legacy/Monitor.h"
 #include "interfaces/legacy/AddonUtils.h"
 #include "interfaces/python/AddonPythonInvoker.h"
+#include "interfaces/python/PythonInterpreterPool.h"
 #include "interfaces/python/PythonInvoker.h"
 #include "ServiceBroker.h"
 
@@ -43,6 +44,7 @@ XBPython::XBPython()
   m_iDllScriptCounter = 0;
   m_endtime           = 0;
   m_pDll              = NULL;
+  m_interpreterPool.reset(new CPythonInterpreterPool());
   m_vecPlayerCallbackList.clear();
   m_vecMonitorCallbackList.clear();
 
@@ -521,6 +523,8 @@ void XBPython::Uninitialize()
 
   // cleanup threads that are still running
   tmpvec.clear(); // boost releases the XBPyThreads which, if deleted, calls OnScriptFinalized
+
+  m_interpreterPool->Clear();
 }
 
 void XBPython::Process()
@@ -545,8 +549,11 @@ void XBPython::Process()
     //delete scripts which are done
     tmpvec.clear(); // boost releases the XBPyThreads which, if deleted, calls OnScriptFinalized
 
+    // end kept interpreters which haven't been used for a while
+    m_interpreterPool->Cleanup();
+
     CSingleLock l2(m_critSection);
-    if(m_iDllScriptCounter == 0 && (XbmcThreads::SystemClockMillis() - m_endtime) > 10000 )
+    if(m_iDllScriptCounter == 0 && m_interpreterPool->IsEmpty() && (XbmcThreads::SystemClockMillis() - m_endtime) > 10000 )
     {
       Finalize();
     }
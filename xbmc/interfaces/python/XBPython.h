@@ -21,6 +21,7 @@
 
 #define g_pythonParser CServiceBroker::GetXBPython()
 
+class CPythonInterpreterPool;
 class CPythonInvoker;
 class CVariant;
 
@@ -101,6 +102,8 @@ public:
   void UnregisterExtensionLib(LibraryLoader *pLib);
   void UnloadExtensionLibs();
 
+  CPythonInterpreterPool& GetInterpreterPool() { return *m_interpreterPool; }
+
 private:
   void Finalize();
 
@@ -119,6 +122,8 @@ private:
   MonitorCallbackList m_vecMonitorCallbackList;
   LibraryLoader*      m_pDll;
 
+  std::unique_ptr<CPythonInterpreterPool> m_interpreterPool;
+
   // any global events that scripts should be using
   CEvent m_globalEvent;
 
@@ -205,6 +205,11 @@ void CMusicDatabase::CreateTables()
   CLog::Log(LOGINFO, "create versiontagscan table");
   m_pDS->exec("CREATE TABLE versiontagscan (idVersion INTEGER, iNeedsScan INTEGER, lastscanned VARCHAR(20))");
   m_pDS->exec(PrepareSQL("INSERT INTO versiontagscan (idVersion, iNeedsScan) values(%i, 0)", GetSchemaVersion()));
+
+  CLog::Log(LOGINFO, "create artistsummary table");
+  m_pDS->exec("CREATE TABLE artistsummary (idArtist INTEGER PRIMARY KEY, "
+              " bAlbumArtist INTEGER NOT NULL DEFAULT 0, bSongArtist INTEGER NOT NULL DEFAULT 0, "
+              " bContributor INTEGER NOT NULL DEFAULT 0)");
 }
 
 void CMusicDatabase::CreateAnalytics()
@@ -268,6 +273,7 @@ void CMusicDatabase::CreateAnalytics()
               "  DELETE FROM song_artist WHERE song_artist.idArtist = old.idArtist;"
               "  DELETE FROM discography WHERE discography.idArtist = old.idArtist;"
               "  DELETE FROM art WHERE media_id=old.idArtist AND media_type='artist';"
+              "  DELETE FROM artistsummary WHERE artistsummary.idArtist = old.idArtist;"
               " END");
   m_pDS->exec("CREATE TRIGGER tgrDeleteSong AFTER delete ON song FOR EACH ROW BEGIN"
               "  DELETE FROM song_artist WHERE song_artist.idSong = old.idSong;"
@@ -278,10 +284,50 @@ void CMusicDatabase::CreateAnalytics()
               "  DELETE FROM source_path WHERE source_path.idSource = old.idSource;"
               "  DELETE FROM album_source WHERE album_source.idSource = old.idSource;"
               " END");
-  
+
+  // Keep artistsummary in step with the artist links. Links are added using REPLACE, which
+  // doesn't fire delete triggers on SQLite, so flags are set on insert and re-evaluated on delete.
+  std::string summaryRow = "  INSERT INTO artistsummary (idArtist) SELECT artist.idArtist FROM artist"
+                           "  WHERE artist.idArtist = new.idArtist"
+                           "  AND NOT EXISTS (SELECT 1 FROM artistsummary WHERE artistsummary.idArtist = new.idArtist);";
+  m_pDS->exec("CREATE TRIGGER tgrInsertAlbumArtist AFTER insert ON album_artist FOR EACH ROW BEGIN" +
+              summaryRow +
+              "  UPDATE artistsummary SET bAlbumArtist = 1 WHERE idArtist = new.idArtist;"
+              " END");
+  m_pDS->exec("CREATE TRIGGER tgrDeleteAlbumArtist AFTER delete ON album_artist FOR EACH ROW BEGIN"
+              "  UPDATE artistsummary SET bAlbumArtist ="
+              "  EXISTS (SELECT 1 FROM album_artist WHERE album_artist.idArtist = old.idArtist)"
+              "  WHERE idArtist = old.idArtist;"
+              " END");
+  m_pDS->exec("CREATE TRIGGER tgrInsertSongArtist AFTER insert ON song_artist FOR EACH ROW BEGIN" +
+              summaryRow +
+              "  UPDATE artistsummary SET bContributor = 1,"
+              "  bSongArtist = CASE WHEN new.idRole = 1 THEN 1 ELSE bSongArtist END"
+              "  WHERE idArtist = new.idArtist;"
+              " END");
+  m_pDS->exec("CREATE TRIGGER tgrDeleteSongArtist AFTER delete ON song_artist FOR EACH ROW BEGIN"
+              "  UPDATE artistsummary SET"
+              "  bContributor = EXISTS (SELECT 1 FROM song_artist WHERE song_artist.idArtist = old.idArtist),"
+              "  bSongArtist = EXISTS (SELECT 1 FROM song_artist WHERE song_artist.idArtist = old.idArtist AND song_artist.idRole = 1)"
+              "  WHERE idArtist = old.idArtist;"
+              " END");
+
   // we create views last to ensure all indexes are rolled in
   CreateViews();
 
+  RebuildArtistSummary();
+}
+
+void CMusicDatabase::RebuildArtistSummary()
+{
+  CLog::Log(LOGINFO, "%s - rebuilding artist summary", __FUNCTION__);
+  m_pDS->exec("DELETE FROM artistsummary");
+  m_pDS->exec("INSERT INTO artistsummary (idArtist, bAlbumArtist, bSongArtist, bContributor) "
+              "SELECT artist.idArtist, "
+              "EXISTS (SELECT 1 FROM album_artist WHERE album_artist.idArtist = artist.idArtist), "
+              "EXISTS (SELECT 1 FROM song_artist WHERE song_artist.idArtist = artist.idArtist AND song_artist.idRole = 1), "
+              "EXISTS (SELECT 1 FROM song_artist WHERE song_artist.idArtist = artist.idArtist) "
+              "FROM artist");
 }
 
 void CMusicDatabase::CreateViews()
@@ -7354,6 +7400,13 @@ void CMusicDatabase::UpdateTables(int version)
     // and filled as part of scanning anyway so simply force full rescan.
     MigrateSources();
   }
+  if (version < 73)
+  {
+    // Create artistsummary table, it is filled in CreateAnalytics
+    m_pDS->exec("CREATE TABLE artistsummary (idArtist INTEGER PRIMARY KEY, "
+                " bAlbumArtist INTEGER NOT NULL DEFAULT 0, bSongArtist INTEGER NOT NULL DEFAULT 0, "
+                " bContributor INTEGER NOT NULL DEFAULT 0)");
+  }
 
   // Set the verion of tag scanning required.
   // Not every schema change requires the tags to be rescanned, set to the highest schema version
@@ -7374,7 +7427,7 @@ void CMusicDatabase::UpdateTables(int version)
 
 int CMusicDatabase::GetSchemaVersion() const
 {
-  return 72;
+  return 73;
 }
 
 int CMusicDatabase::GetMusicNeedsTagScan()
@@ -10350,6 +10403,18 @@ bool CMusicDatabase::GetFilter(CDbUrl &musicUrl, Filter &filter, SortDescription
         filter.AppendWhere(PrepareSQL("artistview.idArtist IN (SELECT song_artist.idArtist FROM song_artist "
           "WHERE song_artist.idSong = %i %s)", idSong, strRoleSQL.c_str()));
       }
+      else if (idGenre <= 0 && idSource <= 0 && (idRole < 0 || idRole == 1))
+      { // Only which links an artist has matters, that is kept in artistsummary
+        if (idRole < 0)
+          filter.AppendWhere("artistview.idArtist IN (SELECT idArtist FROM artistsummary "
+            "WHERE bAlbumArtist = 1 OR bContributor = 1)");
+        else if (!albumArtistsOnly)
+          filter.AppendWhere("artistview.idArtist IN (SELECT idArtist FROM artistsummary "
+            "WHERE bAlbumArtist = 1 OR bSongArtist = 1)");
+        else
+          filter.AppendWhere("artistview.idArtist IN (SELECT idArtist FROM artistsummary "
+            "WHERE bAlbumArtist = 1)");
+      }
       else
       { /*
         Process idRole, idGenre, idSource and albumArtistsOnly options
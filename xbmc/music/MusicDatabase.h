@@ -626,6 +626,11 @@ private:
    */
   virtual void CreateViews();
 
+  /*! \brief Refill the artistsummary table, which records for every artist whether it
+   is linked to albums, to songs as artist or to songs in any role
+   */
+  void RebuildArtistSummary();
+
   void SplitPath(const std::string& strFileNameAndPath, std::string& strPath, std::string& strFileName);
 
   CSong GetSongFromDataset();
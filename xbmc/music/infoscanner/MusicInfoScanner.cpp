@@ -60,7 +60,8 @@ using namespace ADDON;
 using KODI::UTILITY::CDigest;
 
 CMusicInfoScanner::CMusicInfoScanner()
-: m_fileCountReader(this, "MusicFileCounter")
+: m_snapshot("special://database/MusicDirectorySnapshot.xml")
+, m_fileCountReader(this, "MusicFileCounter")
 {
   m_bStop = false;
   m_currentItem=0;
@@ -119,6 +120,12 @@ void CMusicInfoScanner::Process()
       m_bCanInterrupt = false;
       m_needsCleanup = false;
 
+      if (g_advancedSettings.m_bMusicLibraryUseDirectorySnapshot)
+      {
+        m_snapshot.Load();
+        m_snapshot.PrefetchModificationTimes(std::vector<std::string>(m_pathsToScan.begin(), m_pathsToScan.end()));
+      }
+
       bool commit = true;
       for (std::set<std::string>::const_iterator it = m_pathsToScan.begin(); it != m_pathsToScan.end(); ++it)
       {
@@ -159,6 +166,9 @@ void CMusicInfoScanner::Process()
         }
       }
 
+      if (g_advancedSettings.m_bMusicLibraryUseDirectorySnapshot)
+        m_snapshot.Save();
+
       if (commit)
       {
         CServiceBroker::GetGUI()->GetInfoManager().GetInfoProviders().GetLibraryInfoProvider().ResetLibraryBools();
@@ -475,8 +485,32 @@ bool CMusicInfoScanner::DoScan(const std::string& strDirectory)
   if (HasNoMedia(strDirectory))
     return true;
 
-  // load subfolder
   CFileItemList items;
+  bool useSnapshot = g_advancedSettings.m_bMusicLibraryUseDirectorySnapshot && !URIUtils::IsPlugin(strDirectory);
+  int64_t mtime = useSnapshot ? m_snapshot.GetModificationTime(strDirectory) : 0;
+
+  CDirectorySnapshot::CEntry snapshot;
+  std::string dbHash;
+  if (useSnapshot && !(m_flags & SCAN_RESCAN) && m_snapshot.GetUnchanged(strDirectory, mtime, snapshot) &&
+      m_musicDatabase.GetPathHash(strDirectory, dbHash) && StringUtils::EqualsNoCase(snapshot.fingerprint, dbHash))
+  { // path unchanged since it was last listed - no need to fetch it, just recurse into its subfolders
+    CLog::Log(LOGDEBUG, "%s Skipping dir '%s' due to no change (snapshot)", __FUNCTION__, CURL::GetRedacted(strDirectory).c_str());
+    m_currentItem += snapshot.count;
+
+    // updated the dialog with our progress
+    if (m_handle)
+    {
+      if (m_itemCount>0)
+        m_handle->SetPercentage(static_cast<float>(m_currentItem * 100) / static_cast<float>(m_itemCount));
+      OnDirectoryScanned(strDirectory);
+    }
+
+    for (const auto &subdir : snapshot.subdirs)
+      items.Add(CFileItemPtr(new CFileItem(subdir, true)));
+    return ScanSubfolders(items);
+  }
+
+  // load subfolder
   CDirectory::GetDirectory(strDirectory, items, CServiceBroker::GetFileExtensionProvider().GetMusicExtensions() + "|.jpg|.tbn|.lrc|.cdg", DIR_FLAG_DEFAULTS);
 
   // sort and get the path hash.  Note that we don't filter .cue sheet items here as we want
@@ -486,8 +520,21 @@ bool CMusicInfoScanner::DoScan(const std::string& strDirectory)
   std::string hash;
   GetPathHash(items, hash);
 
+  if (mtime)
+  { // remember the listing, the database hash is brought up to date below either way
+    snapshot = CDirectorySnapshot::CEntry();
+    snapshot.mtime = mtime;
+    snapshot.fingerprint = hash;
+    snapshot.count = CountFiles(items, false);
+    for (const auto &item : items)
+    {
+      if (item->m_bIsFolder && !item->IsParentFolder() && !item->IsPlayList())
+        snapshot.subdirs.push_back(item->GetPath());
+    }
+  }
+
   // check whether we need to rescan or not
-  std::string dbHash;
+  dbHash.clear();
   if ((m_flags & SCAN_RESCAN) || !m_musicDatabase.GetPathHash(strDirectory, dbHash) || !StringUtils::EqualsNoCase(dbHash, hash))
   { // path has changed - rescan
     if (dbHash.empty())
@@ -526,6 +573,25 @@ bool CMusicInfoScanner::DoScan(const std::string& strDirectory)
     }
   }
 
+  if (mtime)
+    m_snapshot.Set(strDirectory, std::move(snapshot));
+
+  return ScanSubfolders(items);
+}
+
+bool CMusicInfoScanner::ScanSubfolders(const CFileItemList& items)
+{
+  if (g_advancedSettings.m_bMusicLibraryUseDirectorySnapshot)
+  { // stat the subfolders we're about to recurse into in one go
+    std::vector<std::string> subdirs;
+    for (const auto &item : items)
+    {
+      if (item->m_bIsFolder && !item->IsParentFolder() && !item->IsPlayList() && !item->IsPlugin())
+        subdirs.push_back(item->GetPath());
+    }
+    m_snapshot.PrefetchModificationTimes(subdirs);
+  }
+
   // now scan the subfolders
   for (int i = 0; i < items.Size(); ++i)
   {
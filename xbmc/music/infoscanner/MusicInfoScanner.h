@@ -11,6 +11,7 @@
 #include "InfoScanner.h"
 #include "MusicAlbumInfo.h"
 #include "MusicInfoScraper.h"
+#include "filesystem/DirectorySnapshot.h"
 #include "music/MusicDatabase.h"
 #include "threads/Thread.h"
 #include "threads/IRunnable.h"
@@ -222,6 +223,12 @@ protected:
   int CountFiles(const CFileItemList& items, bool recursive);
   int CountFilesRecursively(const std::string& strPath);
 
+  /*! \brief Recurse into the (non-playlist) subfolders of a listing
+   \param items [in] the folder listing
+   \return false if the scan was stopped
+   */
+  bool ScanSubfolders(const CFileItemList& items);
+
   /*! \brief Resolve a MusicBrainzID to a URL
    If we have a MusicBrainz ID for an artist or album,
    resolve it to an MB URL and set up the scrapers accordingly.
@@ -240,6 +247,7 @@ protected:
   int m_scanType = 0; // 0 - load from files, 1 - albums, 2 - artists
   int m_idSourcePath;
   CMusicDatabase m_musicDatabase;
+  XFILE::CDirectorySnapshot m_snapshot;
 
   std::set<int> m_albumsAdded;
 
@@ -9,15 +9,19 @@
 #include "WebServer.h"
 
 #include <algorithm>
+#include <limits>
 #include <memory>
 #include <stdexcept>
 #include <utility>
 
 #if defined(TARGET_POSIX)
+#include <fcntl.h>
 #include <pthread.h>
+#include <unistd.h>
 #endif
 
 #include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
 #include "network/httprequesthandler/HTTPRequestHandlerUtils.h"
 #include "network/httprequesthandler/IHTTPRequestHandler.h"
 #include "settings/AdvancedSettings.h"
@@ -51,6 +55,13 @@
 
 #define HEADER_NEWLINE        "\r\n"
 
+// size of the blocks MHD requests from responses filled from VFS files
+#define FILE_DOWNLOAD_BLOCK_SIZE      (64 * 1024)
+// size of the reads from VFS files done ahead of the blocks requested by MHD
+#define FILE_DOWNLOAD_READAHEAD_SIZE  (1024 * 1024)
+// number of unused read-ahead buffers kept for the next downloads
+#define FILE_DOWNLOAD_POOLED_BUFFERS  4
+
 typedef struct {
   std::shared_ptr<XFILE::CFile> file;
   CHttpRanges ranges;
@@ -61,8 +72,72 @@ typedef struct {
   bool boundaryWritten;
   std::string contentType;
   uint64_t writePosition;
+  std::unique_ptr<char[]> readAhead;
+  uint64_t readAheadPosition;
+  size_t readAheadLength;
 } HttpFileDownloadContext;
 
+namespace
+{
+CCriticalSection readAheadBuffersSection;
+std::vector<std::unique_ptr<char[]>> readAheadBuffers;
+
+std::unique_ptr<char[]> GetReadAheadBuffer()
+{
+  CSingleLock lock(readAheadBuffersSection);
+  if (readAheadBuffers.empty())
+    return std::unique_ptr<char[]>(new char[FILE_DOWNLOAD_READAHEAD_SIZE]);
+
+  std::unique_ptr<char[]> buffer = std::move(readAheadBuffers.back());
+  readAheadBuffers.pop_back();
+  return buffer;
+}
+
+void ReleaseReadAheadBuffer(std::unique_ptr<char[]> buffer)
+{
+  CSingleLock lock(readAheadBuffersSection);
+  if (buffer && readAheadBuffers.size() < FILE_DOWNLOAD_POOLED_BUFFERS)
+    readAheadBuffers.push_back(std::move(buffer));
+}
+
+// Copies up to size bytes of the file from the current write position, which must be
+// within the range ending at end, to buf. The file is read ahead in large chunks.
+ssize_t ReadFileData(HttpFileDownloadContext *context, char *buf, size_t size, uint64_t end)
+{
+  const uint64_t position = context->writePosition;
+  if (position < context->readAheadPosition ||
+      position >= context->readAheadPosition + context->readAheadLength)
+  {
+    if (!context->readAhead)
+      context->readAhead = GetReadAheadBuffer();
+
+    // seek to the position if necessary
+    if (context->file->GetPosition() < 0 || position != static_cast<uint64_t>(context->file->GetPosition()))
+      context->file->Seek(position);
+
+    // don't read ahead beyond the end of the range
+    const size_t length = static_cast<size_t>(std::min<uint64_t>(FILE_DOWNLOAD_READAHEAD_SIZE, end - position + 1));
+    context->readAheadPosition = position;
+    context->readAheadLength = 0;
+    while (context->readAheadLength < length)
+    {
+      ssize_t res = context->file->Read(context->readAhead.get() + context->readAheadLength, length - context->readAheadLength);
+      if (res <= 0)
+        break;
+      context->readAheadLength += res;
+    }
+
+    if (context->readAheadLength == 0)
+      return -1;
+  }
+
+  const size_t offset = static_cast<size_t>(position - context->readAheadPosition);
+  const size_t length = std::min(size, context->readAheadLength - offset);
+  memcpy(buf, context->readAhead.get() + offset, length);
+  return length;
+}
+}
+
 CWebServer::CWebServer()
   : m_authenticationUsername("kodi"),
     m_authenticationPassword(""),
@@ -199,9 +274,18 @@ int CWebServer::HandlePartialRequest(struct MHD_Connection *connection, Connecti
         if (handler->CanBeCached())
         {
           bool cacheable = IsRequestCacheable(request);
+          bool notModified = false;
+
+          // handle If-None-Match (but only if the response is cacheable)
+          // it takes precedence over If-Modified-Since
+          std::string ifNoneMatch = HTTPRequestHandlerUtils::GetRequestHeaderValue(connection, MHD_HEADER_KIND, MHD_HTTP_HEADER_IF_NONE_MATCH);
+          std::string entityTag;
+          if (cacheable && !ifNoneMatch.empty() &&
+              handler->GetEntityTag(entityTag) && IsEntityTagMatching(ifNoneMatch, entityTag))
+            notModified = true;
 
           CDateTime lastModified;
-          if (handler->GetLastModifiedDate(lastModified) && lastModified.IsValid())
+          if (!notModified && handler->GetLastModifiedDate(lastModified) && lastModified.IsValid())
           {
             // handle If-Modified-Since or If-Unmodified-Since
             std::string ifModifiedSince = HTTPRequestHandlerUtils::GetRequestHeaderValue(connection, MHD_HEADER_KIND, MHD_HTTP_HEADER_IF_MODIFIED_SINCE);
@@ -210,25 +294,28 @@ int CWebServer::HandlePartialRequest(struct MHD_Connection *connection, Connecti
             CDateTime ifModifiedSinceDate;
             CDateTime ifUnmodifiedSinceDate;
             // handle If-Modified-Since (but only if the response is cacheable)
-            if (cacheable &&
+            if (cacheable && ifNoneMatch.empty() &&
               ifModifiedSinceDate.SetFromRFC1123DateTime(ifModifiedSince) &&
               lastModified.GetAsUTCDateTime() <= ifModifiedSinceDate)
-            {
-              struct MHD_Response *response = create_response(0, nullptr, MHD_NO, MHD_NO);
-              if (response == nullptr)
-              {
-                CLog::Log(LOGERROR, "CWebServer[%hu]: failed to create a HTTP 304 response", m_port);
-                return MHD_NO;
-              }
-
-              return FinalizeRequest(handler, MHD_HTTP_NOT_MODIFIED, response);
-            }
+              notModified = true;
             // handle If-Unmodified-Since
             else if (ifUnmodifiedSinceDate.SetFromRFC1123DateTime(ifUnmodifiedSince) &&
               lastModified.GetAsUTCDateTime() > ifUnmodifiedSinceDate)
               return SendErrorResponse(request, MHD_HTTP_PRECONDITION_FAILED, request.method);
           }
 
+          if (notModified)
+          {
+            struct MHD_Response *response = create_response(0, nullptr, MHD_NO, MHD_NO);
+            if (response == nullptr)
+            {
+              CLog::Log(LOGERROR, "CWebServer[%hu]: failed to create a HTTP 304 response", m_port);
+              return MHD_NO;
+            }
+
+            return FinalizeRequest(handler, MHD_HTTP_NOT_MODIFIED, response);
+          }
+
           // pass the requested ranges on to the request handler
           handler->SetRequestRanged(IsRequestRanged(request, lastModified));
         }
@@ -373,6 +460,11 @@ int CWebServer::FinalizeRequest(const std::shared_ptr<IHTTPRequestHandler>& hand
   if (handler->GetLastModifiedDate(lastModified) && lastModified.IsValid())
     handler->AddResponseHeader(MHD_HTTP_HEADER_LAST_MODIFIED, lastModified.GetAsRFC1123DateTime());
 
+  // if the request handler has set an entity tag and it hasn't been set as a header, add it
+  std::string entityTag;
+  if (handler->CanBeCached() && handler->GetEntityTag(entityTag) && !entityTag.empty())
+    handler->AddResponseHeader(MHD_HTTP_HEADER_ETAG, entityTag);
+
   // check if the request handler has set Cache-Control and add it if not
   if (!handler->HasResponseHeader(MHD_HTTP_HEADER_CACHE_CONTROL))
   {
@@ -465,6 +557,31 @@ bool CWebServer::IsRequestCacheable(const HTTPRequest& request) const
   return true;
 }
 
+bool CWebServer::IsEntityTagMatching(const std::string &ifNoneMatch, const std::string &entityTag)
+{
+  if (entityTag.empty())
+    return false;
+
+  // If-None-Match uses the weak comparison, i.e. a weak indicator is ignored
+  auto stripWeakIndicator = [](std::string tag)
+  {
+    StringUtils::Trim(tag);
+    if (StringUtils::StartsWith(tag, "W/"))
+      tag.erase(0, 2);
+    return tag;
+  };
+
+  const std::string tag = stripWeakIndicator(entityTag);
+  for (const auto& value : StringUtils::Split(ifNoneMatch, ","))
+  {
+    std::string requestedTag = stripWeakIndicator(value);
+    if (requestedTag == "*" || requestedTag == tag)
+      return true;
+  }
+
+  return false;
+}
+
 bool CWebServer::IsRequestRanged(const HTTPRequest& request, const CDateTime &lastModified) const
 {
   // parse the Range header and store it in the request object
@@ -759,6 +876,8 @@ int CWebServer::CreateFileDownloadResponse(const std::shared_ptr<IHTTPRequestHan
     context->contentType = mimeType;
     context->boundaryWritten = false;
     context->writePosition = 0;
+    context->readAheadPosition = 0;
+    context->readAheadLength = 0;
 
     if (handler->IsRequestRanged())
     {
@@ -818,18 +937,26 @@ int CWebServer::CreateFileDownloadResponse(const std::shared_ptr<IHTTPRequestHan
     // set the initial write position
     context->ranges.GetFirstPosition(context->writePosition);
 
-    // create the response object
-    response = MHD_create_response_from_callback(totalLength, 2048,
-                                                  &CWebServer::ContentReaderCallback,
-                                                  context.get(),
-                                                  &CWebServer::ContentReaderFreeCallback);
+    // a single range of a local file is sent by MHD straight from the file descriptor
+    // which lets it use sendfile()
+    if (context->rangeCountTotal == 1)
+      response = CreateFileDescriptorResponse(filePath, context->writePosition, totalLength);
+
     if (response == nullptr)
     {
-      CLog::Log(LOGERROR, "CWebServer[%hu]: failed to create a HTTP response for %s to be filled from %s", m_port, request.pathUrl.c_str(), filePath.c_str());
-      return MHD_NO;
-    }
+      // create the response object
+      response = MHD_create_response_from_callback(totalLength, FILE_DOWNLOAD_BLOCK_SIZE,
+                                                    &CWebServer::ContentReaderCallback,
+                                                    context.get(),
+                                                    &CWebServer::ContentReaderFreeCallback);
+      if (response == nullptr)
+      {
+        CLog::Log(LOGERROR, "CWebServer[%hu]: failed to create a HTTP response for %s to be filled from %s", m_port, request.pathUrl.c_str(), filePath.c_str());
+        return MHD_NO;
+      }
 
-    context.release(); // ownership was passed to mhd
+      context.release(); // ownership was passed to mhd
+    }
 
     // add Content-Range header
     if (ranged)
@@ -854,6 +981,43 @@ int CWebServer::CreateFileDownloadResponse(const std::shared_ptr<IHTTPRequestHan
   return MHD_YES;
 }
 
+struct MHD_Response* CWebServer::CreateFileDescriptorResponse(const std::string &filePath, uint64_t offset, uint64_t length) const
+{
+#if defined(TARGET_POSIX)
+  if (!m_fileDescriptorResponses)
+    return nullptr;
+
+  // only plain local paths can be opened directly
+  std::string nativePath = CSpecialProtocol::TranslatePath(filePath);
+  if (!CURL(nativePath).GetProtocol().empty())
+    return nullptr;
+
+  int fd = open(nativePath.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    return nullptr;
+
+  // MHD takes over the file descriptor and closes it together with the response
+#if (MHD_VERSION >= 0x00094400)
+  struct MHD_Response *response = MHD_create_response_from_fd_at_offset64(length, fd, offset);
+#else
+  struct MHD_Response *response = nullptr;
+  if (offset <= static_cast<uint64_t>(std::numeric_limits<off_t>::max()) &&
+      length <= std::numeric_limits<size_t>::max())
+    response = MHD_create_response_from_fd_at_offset(static_cast<size_t>(length), fd, static_cast<off_t>(offset));
+#endif
+  if (response == nullptr)
+  {
+    close(fd);
+    return nullptr;
+  }
+
+  CLog::Log(LOGDEBUG, LOGWEBSERVER, "CWebServer[%hu]: sending %" PRIu64 " bytes of %s from its file descriptor", m_port, length, nativePath.c_str());
+  return response;
+#else
+  return nullptr;
+#endif
+}
+
 int CWebServer::CreateErrorResponse(struct MHD_Connection *connection, int responseType, HTTPMethod method, struct MHD_Response *&response) const
 {
   size_t payloadSize = 0;
@@ -1002,12 +1166,8 @@ ssize_t CWebServer::ContentReaderCallback(void *cls, uint64_t pos, char *buf, si
   // adjust the maximum number of read bytes
   maximum = std::min(maximum, end - context->writePosition + 1);
 
-  // seek to the position if necessary
-  if (context->file->GetPosition() < 0 || context->writePosition != static_cast<uint64_t>(context->file->GetPosition()))
-    context->file->Seek(context->writePosition);
-
   // read data from the file
-  ssize_t res = context->file->Read(buf, static_cast<size_t>(maximum));
+  ssize_t res = ReadFileData(context, buf, static_cast<size_t>(maximum), end);
   if (res <= 0)
     return -1;
 
@@ -1033,6 +1193,8 @@ ssize_t CWebServer::ContentReaderCallback(void *cls, uint64_t pos, char *buf, si
 void CWebServer::ContentReaderFreeCallback(void *cls)
 {
   HttpFileDownloadContext *context = (HttpFileDownloadContext *)cls;
+  if (context != nullptr)
+    ReleaseReadAheadBuffer(std::move(context->readAhead));
   delete context;
 
   CLog::Log(LOGDEBUG, LOGWEBSERVER, "CWebServer [OUT] done");
@@ -36,6 +36,12 @@ public:
   void RegisterRequestHandler(IHTTPRequestHandler *handler);
   void UnregisterRequestHandler(IHTTPRequestHandler *handler);
 
+  /*!
+   \brief Whether local files are sent straight from their file descriptor (using sendfile()
+   where available) instead of being read through the VFS. Enabled by default.
+   */
+  void SetFileDescriptorResponses(bool enabled) { m_fileDescriptorResponses = enabled; }
+
 protected:
   typedef struct ConnectionHandler
   {
@@ -70,6 +76,7 @@ private:
   bool IsAuthenticated(const HTTPRequest& request) const;
 
   bool IsRequestCacheable(const HTTPRequest& request) const;
+  static bool IsEntityTagMatching(const std::string &ifNoneMatch, const std::string &entityTag);
   bool IsRequestRanged(const HTTPRequest& request, const CDateTime &lastModified) const;
 
   void SetupPostDataProcessing(const HTTPRequest& request, ConnectionHandler *connectionHandler, std::shared_ptr<IHTTPRequestHandler> handler, void **con_cls) const;
@@ -81,6 +88,7 @@ private:
 
   int CreateRedirect(struct MHD_Connection *connection, const std::string &strURL, struct MHD_Response *&response) const;
   int CreateFileDownloadResponse(const std::shared_ptr<IHTTPRequestHandler>& handler, struct MHD_Response *&response) const;
+  struct MHD_Response* CreateFileDescriptorResponse(const std::string &filePath, uint64_t offset, uint64_t length) const;
   int CreateErrorResponse(struct MHD_Connection *connection, int responseType, HTTPMethod method, struct MHD_Response *&response) const;
   int CreateMemoryDownloadResponse(struct MHD_Connection *connection, const void *data, size_t size, bool free, bool copy, struct MHD_Response *&response) const;
 
@@ -117,6 +125,7 @@ private:
   bool m_running = false;
   size_t m_thread_stacksize = 0;
   bool m_authenticationRequired = false;
+  bool m_fileDescriptorResponses = true;
   std::string m_authenticationUsername;
   std::string m_authenticationPassword;
   std::string m_key;
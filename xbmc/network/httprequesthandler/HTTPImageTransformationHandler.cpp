@@ -14,6 +14,8 @@
 #include "filesystem/ImageFile.h"
 #include "network/WebServer.h"
 #include "network/httprequesthandler/HTTPRequestHandlerUtils.h"
+#include "pictures/PictureScalingAlgorithm.h"
+#include "utils/Crc32.h"
 #include "utils/Mime.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
@@ -27,7 +29,6 @@ static const std::string ImageBasePath = "/image/";
 CHTTPImageTransformationHandler::CHTTPImageTransformationHandler()
   : m_url(),
     m_lastModified(),
-    m_buffer(NULL),
     m_responseData()
 { }
 
@@ -35,7 +36,6 @@ CHTTPImageTransformationHandler::CHTTPImageTransformationHandler(const HTTPReque
   : IHTTPRequestHandler(request),
     m_url(),
     m_lastModified(),
-    m_buffer(NULL),
     m_responseData()
 {
   m_url = m_request.pathUrl.substr(ImageBasePath.size());
@@ -63,6 +63,52 @@ CHTTPImageTransformationHandler::CHTTPImageTransformationHandler(const HTTPReque
   StringUtils::ToLower(ext);
   m_response.contentType = CMime::GetMimeType(ext);
 
+  // get the transformation options
+  std::map<std::string, std::string> options;
+  HTTPRequestHandlerUtils::GetRequestHeaderValues(m_request.connection, MHD_GET_ARGUMENT_KIND, options);
+
+  std::vector<std::string> urlOptions;
+  std::map<std::string, std::string>::const_iterator option = options.find(TRANSFORMATION_OPTION_WIDTH);
+  if (option != options.end())
+    urlOptions.push_back(TRANSFORMATION_OPTION_WIDTH "=" + option->second);
+
+  option = options.find(TRANSFORMATION_OPTION_HEIGHT);
+  if (option != options.end())
+    urlOptions.push_back(TRANSFORMATION_OPTION_HEIGHT "=" + option->second);
+
+  option = options.find(TRANSFORMATION_OPTION_SCALING_ALGORITHM);
+  if (option != options.end())
+    urlOptions.push_back(TRANSFORMATION_OPTION_SCALING_ALGORITHM "=" + option->second);
+
+  m_options = StringUtils::Join(urlOptions, "&");
+  m_imagePath = m_url;
+  if (!m_options.empty())
+  {
+    m_imagePath += "?";
+    m_imagePath += m_options;
+  }
+
+  // the transformed image is identified by the source image's hash and the transformation options
+  unsigned int width, height;
+  CPictureScalingAlgorithm::Algorithm scalingAlgorithm;
+  std::string additionalInfo;
+  std::string image = CTextureCacheJob::DecodeImageURL(m_imagePath, width, height, scalingAlgorithm, additionalInfo);
+  if (!image.empty())
+  {
+    m_imageHash = CTextureCacheJob::GetImageHash(image);
+    if (m_imageHash == "BADHASH")
+      m_imageHash.clear();
+
+    // the transformed image is encoded in the format of the source image
+    m_extension = URIUtils::GetExtension(image);
+    StringUtils::ToLower(m_extension);
+    if (m_extension.empty())
+      m_extension = ".jpg";
+  }
+
+  if (!m_imageHash.empty())
+    m_entityTag = StringUtils::Format("\"%s-%08x\"", m_imageHash.c_str(), Crc32::Compute(m_imagePath));
+
   //! @todo determine the maximum age
 
   // determine the last modified date
@@ -86,8 +132,6 @@ CHTTPImageTransformationHandler::CHTTPImageTransformationHandler(const HTTPReque
 CHTTPImageTransformationHandler::~CHTTPImageTransformationHandler()
 {
   m_responseData.clear();
-  delete m_buffer;
-  m_buffer = NULL;
 }
 
 bool CHTTPImageTransformationHandler::CanHandleRequest(const HTTPRequest &request) const
@@ -118,52 +162,42 @@ int CHTTPImageTransformationHandler::HandleRequest()
     return MHD_YES;
   }
 
-  // get the transformation options
-  std::map<std::string, std::string> options;
-  HTTPRequestHandlerUtils::GetRequestHeaderValues(m_request.connection, MHD_GET_ARGUMENT_KIND, options);
-
-  std::vector<std::string> urlOptions;
-  std::map<std::string, std::string>::const_iterator option = options.find(TRANSFORMATION_OPTION_WIDTH);
-  if (option != options.end())
-    urlOptions.push_back(TRANSFORMATION_OPTION_WIDTH "=" + option->second);
-
-  option = options.find(TRANSFORMATION_OPTION_HEIGHT);
-  if (option != options.end())
-    urlOptions.push_back(TRANSFORMATION_OPTION_HEIGHT "=" + option->second);
-
-  option = options.find(TRANSFORMATION_OPTION_SCALING_ALGORITHM);
-  if (option != options.end())
-    urlOptions.push_back(TRANSFORMATION_OPTION_SCALING_ALGORITHM "=" + option->second);
-
-  std::string imagePath = m_url;
-  if (!urlOptions.empty())
-  {
-    imagePath += "?";
-    imagePath += StringUtils::Join(urlOptions, "&");
-  }
+  // look for the transformed image in the cache
+  if (!m_imageHash.empty())
+    m_data = CImageTransformationCache::GetInstance().Get(m_url, m_options, m_imageHash, m_extension);
 
-  // resize the image into the local buffer
-  size_t bufferSize;
-  if (!CTextureCacheJob::ResizeTexture(imagePath, m_buffer, bufferSize))
+  if (m_data == nullptr)
   {
-    m_response.status = MHD_HTTP_INTERNAL_SERVER_ERROR;
-    m_response.type = HTTPError;
-
-    return MHD_YES;
+    // resize the image into a local buffer
+    uint8_t *buffer;
+    size_t bufferSize;
+    if (!CTextureCacheJob::ResizeTexture(m_imagePath, buffer, bufferSize))
+    {
+      m_response.status = MHD_HTTP_INTERNAL_SERVER_ERROR;
+      m_response.type = HTTPError;
+
+      return MHD_YES;
+    }
+
+    m_data = std::make_shared<const std::vector<uint8_t>>(buffer, buffer + bufferSize);
+    delete[] buffer;
+
+    if (!m_imageHash.empty())
+      CImageTransformationCache::GetInstance().Add(m_url, m_options, m_imageHash, m_extension, m_data);
   }
 
   // store the size of the image
-  m_response.totalLength = bufferSize;
+  m_response.totalLength = m_data->size();
 
   // nothing else to do if the request is not ranged
   if (!GetRequestedRanges(m_response.totalLength))
   {
-    m_responseData.push_back(CHttpResponseRange(m_buffer, 0, m_response.totalLength - 1));
+    m_responseData.push_back(CHttpResponseRange(m_data->data(), 0, m_response.totalLength - 1));
     return MHD_YES;
   }
 
   for (HttpRanges::const_iterator range = m_request.ranges.Begin(); range != m_request.ranges.End(); ++range)
-    m_responseData.push_back(CHttpResponseRange(m_buffer + range->GetFirstPosition(), range->GetFirstPosition(), range->GetLastPosition()));
+    m_responseData.push_back(CHttpResponseRange(m_data->data() + range->GetFirstPosition(), range->GetFirstPosition(), range->GetLastPosition()));
 
   return MHD_YES;
 }
@@ -176,3 +210,12 @@ bool CHTTPImageTransformationHandler::GetLastModifiedDate(CDateTime &lastModifie
   lastModified = m_lastModified;
   return true;
 }
+
+bool CHTTPImageTransformationHandler::GetEntityTag(std::string &entityTag) const
+{
+  if (m_entityTag.empty())
+    return false;
+
+  entityTag = m_entityTag;
+  return true;
+}
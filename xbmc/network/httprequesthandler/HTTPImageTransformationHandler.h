@@ -13,6 +13,7 @@
 
 #include "XBDateTime.h"
 #include "network/httprequesthandler/IHTTPRequestHandler.h"
+#include "network/httprequesthandler/ImageTransformationCache.h"
 
 class CHTTPImageTransformationHandler : public IHTTPRequestHandler
 {
@@ -28,6 +29,7 @@ public:
   bool CanHandleRanges() const override { return true; }
   bool CanBeCached() const override { return true; }
   bool GetLastModifiedDate(CDateTime &lastModified) const override;
+  bool GetEntityTag(std::string &entityTag) const override;
 
   HttpResponseRanges GetResponseData() const override { return m_responseData; }
 
@@ -39,8 +41,13 @@ protected:
 
 private:
   std::string m_url;
+  std::string m_imagePath;   //!< m_url including the transformation options
+  std::string m_options;     //!< the transformation options
+  std::string m_imageHash;   //!< hash of the source image, empty if it can't be cached
+  std::string m_extension;   //!< extension of the format of the transformed image
+  std::string m_entityTag;
   CDateTime m_lastModified;
 
-  uint8_t* m_buffer;
+  CImageTransformationCache::ImageData m_data;
   HttpResponseRanges m_responseData;
 };
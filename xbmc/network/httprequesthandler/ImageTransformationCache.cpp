@@ -0,0 +1,247 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ImageTransformationCache.h"
+#include "TextureCache.h"
+#include "TextureCacheJob.h"
+#include "TextureDatabase.h"
+#include "URL.h"
+#include "filesystem/File.h"
+#include "threads/SingleLock.h"
+#include "utils/auto_buffer.h"
+#include "utils/log.h"
+#include "utils/StringUtils.h"
+#include "utils/URIUtils.h"
+
+#include <iterator>
+
+namespace
+{
+// maximum number of bytes of resized images kept in memory
+const size_t MEMORY_BUDGET = 16 * 1024 * 1024;
+
+// distinguishes the transformed images in the texture cache from the ones cached for the GUI
+const char *TRANSFORMATION_CACHE_OPTION = "transformation=http";
+
+// the type the description of a slot is stored under in the path table of the texture database
+const char *SLOT_TYPE = "httptransformation";
+}
+
+const unsigned int CImageTransformationCache::MAX_STORED_TRANSFORMATIONS;
+
+CImageTransformationCache& CImageTransformationCache::GetInstance()
+{
+  static CImageTransformationCache sImageTransformationCache;
+  return sImageTransformationCache;
+}
+
+CImageTransformationCache::ImageData CImageTransformationCache::Get(const std::string &image, const std::string &options, const std::string &hash, const std::string &extension)
+{
+  const std::string url = image + "?" + options;
+  {
+    CSingleLock lock(m_critSection);
+    auto it = m_index.find(url);
+    if (it != m_index.end())
+    {
+      if (it->second->hash == hash)
+      {
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        m_stats.memoryHits++;
+        return it->second->data;
+      }
+
+      m_size -= it->second->data->size();
+      m_entries.erase(it->second);
+      m_index.erase(it);
+    }
+  }
+
+  CSingleLock storageLock(m_storageSection);
+  CTextureDatabase db;
+  if (db.Open())
+  {
+    std::vector<SSlot> slots = LoadSlots(db, image, hash);
+    for (unsigned int i = 0; i < slots.size(); i++)
+    {
+      if (slots[i].hash.empty() || slots[i].options != options)
+        continue;
+
+      const std::string storageUrl = GetStorageUrl(image, i);
+      CTextureDetails details;
+      XUTILS::auto_buffer buffer;
+      if (CTextureCache::GetInstance().GetCachedTexture(storageUrl, details) &&
+          URIUtils::HasExtension(details.file, extension) &&
+          XFILE::CFile().LoadFile(CTextureCache::GetCachedPath(details.file), buffer) > 0)
+      {
+        const uint8_t *begin = reinterpret_cast<const uint8_t*>(buffer.get());
+        ImageData data = std::make_shared<const std::vector<uint8_t>>(begin, begin + buffer.size());
+        CTextureCache::GetInstance().IncrementUseCount(details);
+        slots[i].lastUsed = CDateTime::GetUTCDateTime();
+        db.SetTextureForPath(storageUrl, SLOT_TYPE, SerializeSlot(slots[i]));
+        AddToMemory(url, hash, data);
+
+        CSingleLock lock(m_critSection);
+        m_stats.diskHits++;
+        return data;
+      }
+      break;
+    }
+  }
+
+  CSingleLock lock(m_critSection);
+  m_stats.misses++;
+  return nullptr;
+}
+
+void CImageTransformationCache::Add(const std::string &image, const std::string &options, const std::string &hash, const std::string &extension, const ImageData &data)
+{
+  if (data == nullptr || data->empty())
+    return;
+
+  const std::string url = image + "?" + options;
+  AddToMemory(url, hash, data);
+
+  CSingleLock storageLock(m_storageSection);
+  CTextureDatabase db;
+  if (!db.Open())
+    return;
+
+  const CDateTime now = CDateTime::GetUTCDateTime();
+  std::vector<SSlot> slots = LoadSlots(db, image, hash);
+  {
+    // transformations held in memory are in use, even if their files weren't read lately
+    CSingleLock lock(m_critSection);
+    for (auto& slot : slots)
+    {
+      if (!slot.hash.empty() && m_index.find(image + "?" + slot.options) != m_index.end())
+        slot.lastUsed = now;
+    }
+  }
+
+  const unsigned int index = ChooseSlot(slots, options);
+  const std::string storageUrl = GetStorageUrl(image, index);
+  if (!slots[index].hash.empty())
+    CTextureCache::GetInstance().ClearCachedImage(storageUrl);
+
+  CTextureDetails details;
+  details.file = CTextureCache::GetCacheFile(storageUrl) + extension;
+
+  XFILE::CFile file;
+  if (!file.OpenForWrite(CTextureCache::GetCachedPath(details.file), true) ||
+      file.Write(data->data(), data->size()) != static_cast<ssize_t>(data->size()))
+  {
+    CLog::Log(LOGWARNING, "CImageTransformationCache: failed to store the resized image '%s'", CURL::GetRedacted(url).c_str());
+    db.ClearTextureForPath(storageUrl, SLOT_TYPE);
+    return;
+  }
+  file.Close();
+
+  CTextureCache::GetInstance().AddCachedTexture(storageUrl, details);
+  db.SetTextureForPath(storageUrl, SLOT_TYPE, SerializeSlot({options, hash, now}));
+}
+
+CImageTransformationCache::SStats CImageTransformationCache::GetStats() const
+{
+  CSingleLock lock(m_critSection);
+  return m_stats;
+}
+
+std::string CImageTransformationCache::GetStorageUrl(const std::string &image, unsigned int slot)
+{
+  return StringUtils::Format("%s?%s&slot=%u", image.c_str(), TRANSFORMATION_CACHE_OPTION, slot);
+}
+
+std::string CImageTransformationCache::SerializeSlot(const SSlot &slot)
+{
+  // the options and the date don't contain '|', the hash goes last as it might
+  return slot.options + "|" + slot.lastUsed.GetAsDBDateTime() + "|" + slot.hash;
+}
+
+CImageTransformationCache::SSlot CImageTransformationCache::ParseSlot(const std::string &value)
+{
+  SSlot slot;
+  const size_t options = value.find('|');
+  if (options == std::string::npos)
+    return slot;
+  const size_t lastUsed = value.find('|', options + 1);
+  if (lastUsed == std::string::npos)
+    return slot;
+
+  slot.options = value.substr(0, options);
+  slot.lastUsed.SetFromDBDateTime(value.substr(options + 1, lastUsed - options - 1));
+  slot.hash = value.substr(lastUsed + 1);
+  return slot;
+}
+
+unsigned int CImageTransformationCache::ChooseSlot(const std::vector<SSlot> &slots, const std::string &options)
+{
+  for (unsigned int i = 0; i < slots.size(); i++)
+  {
+    if (!slots[i].hash.empty() && slots[i].options == options)
+      return i;
+  }
+  for (unsigned int i = 0; i < slots.size(); i++)
+  {
+    if (slots[i].hash.empty())
+      return i;
+  }
+
+  unsigned int oldest = 0;
+  for (unsigned int i = 1; i < slots.size(); i++)
+  {
+    if (slots[i].lastUsed < slots[oldest].lastUsed)
+      oldest = i;
+  }
+  return oldest;
+}
+
+std::vector<CImageTransformationCache::SSlot> CImageTransformationCache::LoadSlots(CTextureDatabase &db, const std::string &image, const std::string &hash)
+{
+  std::vector<SSlot> slots;
+  for (unsigned int i = 0; i < MAX_STORED_TRANSFORMATIONS; i++)
+  {
+    const std::string storageUrl = GetStorageUrl(image, i);
+    SSlot slot = ParseSlot(db.GetTextureForPath(storageUrl, SLOT_TYPE));
+    if (!slot.hash.empty() && slot.hash != hash)
+    {
+      // the source image has changed since it was resized
+      CTextureCache::GetInstance().ClearCachedImage(storageUrl);
+      db.ClearTextureForPath(storageUrl, SLOT_TYPE);
+      slot = SSlot();
+    }
+    slots.push_back(slot);
+  }
+  return slots;
+}
+
+void CImageTransformationCache::AddToMemory(const std::string &url, const std::string &hash, const ImageData &data)
+{
+  if (data->size() > MEMORY_BUDGET / 4)
+    return;
+
+  CSingleLock lock(m_critSection);
+  auto it = m_index.find(url);
+  if (it != m_index.end())
+  {
+    m_size -= it->second->data->size();
+    m_entries.erase(it->second);
+    m_index.erase(it);
+  }
+
+  m_entries.push_front({url, hash, data});
+  m_index[url] = m_entries.begin();
+  m_size += data->size();
+
+  while (m_size > MEMORY_BUDGET)
+  {
+    auto last = std::prev(m_entries.end());
+    m_size -= last->data->size();
+    m_index.erase(last->url);
+    m_entries.erase(last);
+  }
+}
@@ -0,0 +1,115 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "XBDateTime.h"
+#include "threads/CriticalSection.h"
+
+#include <list>
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class CTextureDatabase;
+
+/*!
+ \brief Cache of the images resized for HTTP image transformation requests.
+
+ The resized images are kept in memory and on disk. The files on disk are
+ stored in the texture cache and listed in the texture database, so they are
+ cleaned up together with all other cached textures. Every entry holds the
+ hash (see CTextureCacheJob::GetImageHash) of the source image it was created
+ from and is dropped as soon as the source image changes.
+
+ The transformations of one source image share a fixed number of slots on
+ disk, so clients asking for many different sizes can't fill the disk. Once
+ all slots are taken, a new transformation replaces the least recently used one.
+ */
+class CImageTransformationCache
+{
+public:
+  typedef std::shared_ptr<const std::vector<uint8_t>> ImageData;
+
+  struct SStats
+  {
+    unsigned int memoryHits = 0;
+    unsigned int diskHits = 0;
+    unsigned int misses = 0;
+  };
+
+  //! a transformation of a source image stored on disk
+  struct SSlot
+  {
+    std::string options;
+    std::string hash;    //!< hash of the source image, empty if the slot is free
+    CDateTime lastUsed;
+  };
+
+  //! maximum number of transformations of one source image stored on disk
+  static const unsigned int MAX_STORED_TRANSFORMATIONS = 4;
+
+  static CImageTransformationCache& GetInstance();
+
+  /*!
+   \brief Get the resized image for the given transformation.
+   \param image the wrapped URL of the source image
+   \param options the transformation options
+   \param hash the current hash of the source image
+   \param extension the extension (with the dot) of the resized image's format
+   \return the resized image or nullptr if it isn't cached
+   */
+  ImageData Get(const std::string &image, const std::string &options, const std::string &hash, const std::string &extension);
+  void Add(const std::string &image, const std::string &options, const std::string &hash, const std::string &extension, const ImageData &data);
+
+  SStats GetStats() const;
+
+  /*!
+   \brief Get the URL a slot of a source image is stored under in the texture cache.
+   \param image the wrapped URL of the source image
+   \param slot the slot, less than MAX_STORED_TRANSFORMATIONS
+   */
+  static std::string GetStorageUrl(const std::string &image, unsigned int slot);
+
+  //! the description of a slot as stored in the texture database
+  static std::string SerializeSlot(const SSlot &slot);
+  static SSlot ParseSlot(const std::string &value);
+
+  /*!
+   \brief Choose the slot to store a transformation in.
+   \param slots the slots of the source image, at least one
+   \param options the transformation options
+   \return the slot holding the same transformation, else a free one, else the least recently used one
+   */
+  static unsigned int ChooseSlot(const std::vector<SSlot> &slots, const std::string &options);
+
+private:
+  CImageTransformationCache() = default;
+
+  struct CEntry
+  {
+    std::string url;
+    std::string hash;
+    ImageData data;
+  };
+  typedef std::list<CEntry> EntryList;
+
+  void AddToMemory(const std::string &url, const std::string &hash, const ImageData &data);
+
+  //! read the slots of the source image, slots of an older version of it are freed
+  std::vector<SSlot> LoadSlots(CTextureDatabase &db, const std::string &image, const std::string &hash);
+
+  EntryList m_entries;  //!< most recently used first
+  std::unordered_map<std::string, EntryList::iterator> m_index;
+  size_t m_size = 0;
+  SStats m_stats;
+  mutable CCriticalSection m_critSection;
+  CCriticalSection m_storageSection;  //!< held while reading or changing the slots on disk
+};
@@ -0,0 +1,152 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "network/httprequesthandler/ImageTransformationCache.h"
+#include "utils/StringUtils.h"
+
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+typedef CImageTransformationCache::SSlot SSlot;
+
+static const std::string image = "image://special%3a%2f%2fxbmc%2fmedia%2ficon256x256.png/";
+
+static SSlot CreateSlot(const std::string &options, const std::string &hash, int minutesAgo)
+{
+  SSlot slot;
+  slot.options = options;
+  slot.hash = hash;
+  slot.lastUsed = CDateTime(2018, 6, 1, 12, 0, 0) - CDateTimeSpan(0, 0, minutesAgo, 0);
+  return slot;
+}
+
+static CImageTransformationCache::ImageData CreateData(uint8_t value)
+{
+  return std::make_shared<const std::vector<uint8_t>>(64, value);
+}
+
+TEST(TestImageTransformationCache, GetStorageUrl_OnePerSlot)
+{
+  std::set<std::string> urls;
+  for (unsigned int slot = 0; slot < CImageTransformationCache::MAX_STORED_TRANSFORMATIONS; slot++)
+    urls.insert(CImageTransformationCache::GetStorageUrl(image, slot));
+
+  EXPECT_EQ(CImageTransformationCache::MAX_STORED_TRANSFORMATIONS, urls.size());
+  for (const auto& url : urls)
+    EXPECT_TRUE(StringUtils::StartsWith(url, image + "?"));
+  EXPECT_NE(CImageTransformationCache::GetStorageUrl(image, 0),
+            CImageTransformationCache::GetStorageUrl(image + "other/", 0));
+}
+
+TEST(TestImageTransformationCache, SerializeSlot_RoundTrip)
+{
+  // hashes of remote images may contain anything
+  SSlot slot = CreateSlot("width=100&height=50", "\"etag|with|pipes\"", 0);
+  SSlot parsed = CImageTransformationCache::ParseSlot(CImageTransformationCache::SerializeSlot(slot));
+
+  EXPECT_EQ(slot.options, parsed.options);
+  EXPECT_EQ(slot.hash, parsed.hash);
+  EXPECT_EQ(slot.lastUsed, parsed.lastUsed);
+}
+
+TEST(TestImageTransformationCache, ParseSlot_Free)
+{
+  EXPECT_TRUE(CImageTransformationCache::ParseSlot("").hash.empty());
+  EXPECT_TRUE(CImageTransformationCache::ParseSlot("width=100").hash.empty());
+}
+
+TEST(TestImageTransformationCache, ChooseSlot_SameOptions)
+{
+  std::vector<SSlot> slots = { CreateSlot("width=100", "hash", 1),
+                               SSlot(),
+                               CreateSlot("width=200", "hash", 10),
+                               SSlot() };
+  EXPECT_EQ(2U, CImageTransformationCache::ChooseSlot(slots, "width=200"));
+}
+
+TEST(TestImageTransformationCache, ChooseSlot_Free)
+{
+  std::vector<SSlot> slots = { CreateSlot("width=100", "hash", 10),
+                               CreateSlot("width=200", "hash", 20),
+                               SSlot(),
+                               CreateSlot("width=300", "hash", 30) };
+  EXPECT_EQ(2U, CImageTransformationCache::ChooseSlot(slots, "width=400"));
+}
+
+TEST(TestImageTransformationCache, ChooseSlot_LeastRecentlyUsed)
+{
+  std::vector<SSlot> slots = { CreateSlot("width=100", "hash", 10),
+                               CreateSlot("width=200", "hash", 30),
+                               CreateSlot("width=300", "hash", 20),
+                               CreateSlot("width=400", "hash", 5) };
+  EXPECT_EQ(1U, CImageTransformationCache::ChooseSlot(slots, "width=500"));
+
+  // new sizes replace the oldest ones instead of evicting each other
+  for (int width = 1; width <= 100; width++)
+  {
+    const std::string options = StringUtils::Format("width=%d", width);
+    slots[CImageTransformationCache::ChooseSlot(slots, options)] = CreateSlot(options, "hash", 100 - width);
+  }
+  for (int width = 97; width <= 100; width++)
+  {
+    const std::string options = StringUtils::Format("width=%d", width);
+    EXPECT_EQ(options, slots[CImageTransformationCache::ChooseSlot(slots, options)].options);
+  }
+}
+
+TEST(TestImageTransformationCache, AddGet_RoundTrip)
+{
+  CImageTransformationCache &cache = CImageTransformationCache::GetInstance();
+  const std::string source = image + "roundtrip/";
+  const CImageTransformationCache::ImageData data = CreateData(1);
+
+  cache.Add(source, "width=100", "hash", ".png", data);
+  const CImageTransformationCache::SStats before = cache.GetStats();
+  EXPECT_EQ(data, cache.Get(source, "width=100", "hash", ".png"));
+  EXPECT_EQ(before.memoryHits + 1, cache.GetStats().memoryHits);
+}
+
+TEST(TestImageTransformationCache, AddGet_KeepsEachTransformation)
+{
+  CImageTransformationCache &cache = CImageTransformationCache::GetInstance();
+  const std::string source = image + "transformations/";
+  std::vector<CImageTransformationCache::ImageData> data;
+  for (unsigned int i = 0; i <= CImageTransformationCache::MAX_STORED_TRANSFORMATIONS; i++)
+  {
+    data.push_back(CreateData(i));
+    cache.Add(source, StringUtils::Format("width=%u", 100 + i), "hash", ".png", data.back());
+  }
+
+  for (unsigned int i = 0; i < data.size(); i++)
+    EXPECT_EQ(data[i], cache.Get(source, StringUtils::Format("width=%u", 100 + i), "hash", ".png"));
+}
+
+TEST(TestImageTransformationCache, AddGet_SourceChanged)
+{
+  CImageTransformationCache &cache = CImageTransformationCache::GetInstance();
+  const std::string source = image + "changed/";
+
+  cache.Add(source, "width=100", "hash", ".png", CreateData(1));
+  const CImageTransformationCache::SStats before = cache.GetStats();
+  EXPECT_EQ(nullptr, cache.Get(source, "width=100", "newhash", ".png"));
+  EXPECT_EQ(before.misses + 1, cache.GetStats().misses);
+
+  // the outdated image isn't returned for the old hash any longer either
+  EXPECT_EQ(nullptr, cache.Get(source, "width=100", "hash", ".png"));
+}
+
+TEST(TestImageTransformationCache, Get_Missing)
+{
+  CImageTransformationCache &cache = CImageTransformationCache::GetInstance();
+  const CImageTransformationCache::SStats before = cache.GetStats();
+  EXPECT_EQ(nullptr, cache.Get(image + "missing/", "width=100", "hash", ".png"));
+  EXPECT_EQ(before.misses + 1, cache.GetStats().misses);
+}
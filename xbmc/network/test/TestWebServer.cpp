@@ -28,6 +28,9 @@
 #include "utils/URIUtils.h"
 #include "utils/Variant.h"
 
+#include <algorithm>
+#include <chrono>
+#include <inttypes.h>
 #include <random>
 
 using namespace XFILE;
@@ -41,6 +44,8 @@ using namespace XFILE;
 #define TEST_FILES_HTML         TEST_FILES_DATA ".html"
 #define TEST_FILES_RANGES       TEST_FILES_DATA "-ranges.txt"
 
+#define TEST_FILES_LARGE_SIZE   (32 * 1024 * 1024)
+
 class TestWebServer : public testing::Test
 {
 protected:
@@ -897,3 +902,62 @@ TEST_F(TestWebServer, CanGetCachedRangedFileWithNewerIfRange)
   ASSERT_TRUE(curl.Get(GetUrlOfTestFile(TEST_FILES_RANGES), result));
   CheckRangesTestFileResponse(curl, result, ranges);
 }
+
+TEST_F(TestWebServer, CanGetLargeFileFromFileDescriptorAndVfs)
+{
+  // create a large local file with a pattern which doesn't repeat at block boundaries
+  CFile *tempFile;
+  ASSERT_NE(nullptr, (tempFile = XBMC_CREATETEMPFILE(".bin")));
+  std::string content(TEST_FILES_LARGE_SIZE, '\0');
+  for (size_t i = 0; i < content.size(); i++)
+    content[i] = static_cast<char>((i * 7 + i / 251) & 0xff);
+  ASSERT_EQ(static_cast<ssize_t>(content.size()), tempFile->Write(content.data(), content.size()));
+  tempFile->Close();
+
+  const std::string tempPath = XBMC_TEMPFILEPATH(tempFile);
+  const std::string tempFolder = URIUtils::GetDirectory(tempPath);
+  CMediaSource source;
+  source.strName = "WebServer Temp Share";
+  source.strPath = tempFolder;
+  source.vecPaths.push_back(tempFolder);
+  source.m_allowSharing = true;
+  source.m_iDriveType = CMediaSource::SOURCE_TYPE_LOCAL;
+  source.m_iLockMode = LOCK_MODE_EVERYONE;
+  source.m_ignore = true;
+  CMediaSourceSettings::GetInstance().AddShare("videos", source);
+
+  const std::string url = GetUrl(URIUtils::AddFileToFolder("vfs", CURL::Encode(tempPath)));
+  const uint64_t rangeStart = content.size() / 3;
+  const uint64_t rangeEnd = content.size() - 12345;
+  const std::string range = GenerateRangeHeaderValue(rangeStart, rangeEnd);
+
+  for (bool fileDescriptor : { true, false })
+  {
+    webserver.SetFileDescriptorResponses(fileDescriptor);
+
+    // get the whole file
+    std::string result;
+    CCurlFile curl;
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(curl.Get(url, result));
+    auto end = std::chrono::steady_clock::now();
+    ASSERT_EQ(content.size(), result.size());
+    EXPECT_TRUE(content == result);
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    RecordProperty(fileDescriptor ? "file_descriptor_kib_per_second" : "vfs_kib_per_second",
+                   static_cast<int>(result.size() / 1024.0 / std::max(seconds, 1e-6)));
+
+    // get a single range of the file
+    CCurlFile curlRange;
+    curlRange.SetRequestHeader(MHD_HTTP_HEADER_RANGE, range);
+    ASSERT_TRUE(curlRange.Get(url, result));
+    EXPECT_STREQ(StringUtils::Format("bytes %" PRIu64 "-%" PRIu64 "/%" PRIu64, rangeStart, rangeEnd,
+                                     static_cast<uint64_t>(content.size())).c_str(),
+                 curlRange.GetHttpHeader().GetValue(MHD_HTTP_HEADER_CONTENT_RANGE).c_str());
+    ASSERT_EQ(rangeEnd - rangeStart + 1, result.size());
+    EXPECT_TRUE(content.compare(rangeStart, result.size(), result) == 0);
+  }
+
+  EXPECT_TRUE(XBMC_DELETETEMPFILE(tempFile));
+}
@@ -17,9 +17,13 @@
 #include "music/MusicThumbLoader.h"
 #include "interfaces/AnnouncementManager.h"
 #include "filesystem/Directory.h"
+#include "filesystem/LibraryDirectory.h"
 #include "filesystem/MusicDatabaseDirectory.h"
+#include "filesystem/MusicDatabaseDirectory/DirectoryNode.h"
+#include "filesystem/MusicDatabaseDirectory/QueryParams.h"
 #include "filesystem/SpecialProtocol.h"
 #include "filesystem/VideoDatabaseDirectory.h"
+#include "filesystem/VideoDatabaseDirectory/QueryParams.h"
 #include "guilib/GUIComponent.h"
 #include "guilib/WindowIDs.h"
 #include "guilib/LocalizeStrings.h"
@@ -59,12 +63,17 @@ const char* audio_containers[] = { "musicdb://genres/", "musicdb://artists/", "m
 const char* video_containers[] = { "library://video/movies/titles.xml/", "library://video/tvshows/titles.xml/",
                                    "videodb://recentlyaddedmovies/", "videodb://recentlyaddedepisodes/"  };
 
+// maximum number of characters of cached DIDL fragments
+const size_t didl_cache_size = 8 * 1024 * 1024;
+
 /*----------------------------------------------------------------------
 |   CUPnPServer::CUPnPServer
 +---------------------------------------------------------------------*/
 CUPnPServer::CUPnPServer(const char* friendly_name, const char* uuid /*= NULL*/, int port /*= 0*/) :
     PLT_MediaConnect(friendly_name, false, uuid, port),
     PLT_FileMediaConnectDelegate("/", "/"),
+    m_DidlCacheSize(0),
+    m_LibraryUpdateID(0),
     m_scanning(g_application.IsMusicScanning() || g_application.IsVideoScanning())
 {
 }
@@ -144,6 +153,7 @@ CUPnPServer::UpdateContainer(const std::string& id)
     if (itr != m_UpdateIDs.end())
         count = ++itr->second.second;
     m_UpdateIDs[id] = std::make_pair(true, count);
+    InvalidateDidlCache();
     PropagateUpdates();
 }
 
@@ -430,6 +440,11 @@ CUPnPServer::Announce(AnnouncementFlag flag, const char *sender, const char *mes
         }
     }
     else {
+        // any library change may affect cached DIDL of containers that
+        // aren't updated below (artists, genres, sets, other songs, ...)
+        if (flag == VideoLibrary || flag == AudioLibrary)
+            InvalidateDidlCache();
+
         // handle both updates & removals
         if (!data["item"].isNull()) {
             item_id = (int)data["item"]["id"].asInteger();
@@ -644,11 +659,15 @@ CUPnPServer::OnBrowseDirectChildren(PLT_ActionReference&          action,
 
     items.SetPath(std::string(parent_id));
 
+    // large library listings are sorted and paged by the database so only
+    // the requested items are retrieved
+    bool load = GetLibraryPage(std::string(parent_id), starting_index, requested_count, items);
+
     // guard against loading while saving to the same cache file
     // as CArchive currently performs no locking itself
-    bool load;
-    { NPT_AutoLock lock(m_CacheMutex);
-      load = items.Load();
+    if (!load) {
+        NPT_AutoLock lock(m_CacheMutex);
+        load = items.Load();
     }
 
     if (!load) {
@@ -720,6 +739,116 @@ CUPnPServer::OnBrowseDirectChildren(PLT_ActionReference&          action,
         (action_name.Compare("Search", true)==0)?NULL:parent_id.GetChars());
 }
 
+/*----------------------------------------------------------------------
+|   CUPnPServer::GetLibraryPage
++---------------------------------------------------------------------*/
+bool
+CUPnPServer::GetLibraryPage(const std::string& path,
+                            NPT_UInt32         starting_index,
+                            NPT_UInt32         count,
+                            CFileItemList&     items)
+{
+    std::string db_path = path;
+    if (StringUtils::StartsWith(path, "library://")) {
+        CLibraryDirectory library;
+        db_path = library.GetFolderPath(CURL(path));
+    }
+
+    bool is_music = URIUtils::IsMusicDb(db_path);
+    bool is_video = URIUtils::IsVideoDb(db_path);
+    if (!is_music && !is_video)
+        return false;
+
+    MUSICDATABASEDIRECTORY::NODE_TYPE music_type = MUSICDATABASEDIRECTORY::NODE_TYPE_NONE;
+    VIDEODATABASEDIRECTORY::NODE_TYPE video_type = VIDEODATABASEDIRECTORY::NODE_TYPE_NONE;
+    if (is_music) {
+        music_type = CMusicDatabaseDirectory::GetDirectoryChildType(db_path);
+        if (music_type != MUSICDATABASEDIRECTORY::NODE_TYPE_SONG &&
+            music_type != MUSICDATABASEDIRECTORY::NODE_TYPE_ALBUM &&
+            music_type != MUSICDATABASEDIRECTORY::NODE_TYPE_ARTIST)
+            return false;
+    } else {
+        video_type = CVideoDatabaseDirectory::GetDirectoryChildType(db_path);
+        if (video_type != VIDEODATABASEDIRECTORY::NODE_TYPE_TITLE_MOVIES &&
+            video_type != VIDEODATABASEDIRECTORY::NODE_TYPE_TITLE_TVSHOWS &&
+            video_type != VIDEODATABASEDIRECTORY::NODE_TYPE_TITLE_MUSICVIDEOS)
+            return false;
+    }
+
+    // sort the same way DefaultSortItems sorts the whole listing
+    CFileItemList sort_items(db_path);
+    CGUIViewState* viewState = CGUIViewState::GetViewState(is_video ? WINDOW_VIDEO_NAV : -1, sort_items);
+    if (!viewState)
+        return false;
+
+    SortDescription sorting = viewState->GetSortMethod();
+    delete viewState;
+
+    NPT_UInt32 max_count = (count == 0)?m_MaxReturnedItems:std::min(count, m_MaxReturnedItems);
+    sorting.limitStart = starting_index;
+    sorting.limitEnd = starting_index + max_count;
+
+    CFileItemList page;
+    bool success = false;
+    if (is_music) {
+        CMusicDatabase database;
+        if (!database.Open())
+            return false;
+
+        MUSICDATABASEDIRECTORY::CQueryParams params;
+        MUSICDATABASEDIRECTORY::CDirectoryNode::GetDatabaseInfo(db_path, params);
+        switch (music_type) {
+        case MUSICDATABASEDIRECTORY::NODE_TYPE_SONG:
+            success = database.GetSongsNav(db_path, page, params.GetGenreId(), params.GetArtistId(), params.GetAlbumId(), sorting);
+            break;
+        case MUSICDATABASEDIRECTORY::NODE_TYPE_ALBUM:
+            success = database.GetAlbumsNav(db_path, page, params.GetGenreId(), params.GetArtistId(), CDatabase::Filter(), sorting);
+            break;
+        default:
+            success = database.GetArtistsNav(db_path, page, !CServiceBroker::GetSettings().GetBool(CSettings::SETTING_MUSICLIBRARY_SHOWCOMPILATIONARTISTS),
+                                             params.GetGenreId(), -1, -1, CDatabase::Filter(), sorting);
+            break;
+        }
+    } else {
+        CVideoDatabase database;
+        if (!database.Open())
+            return false;
+
+        VIDEODATABASEDIRECTORY::CQueryParams params;
+        CVideoDatabaseDirectory::GetQueryParams(db_path, params);
+        switch (video_type) {
+        case VIDEODATABASEDIRECTORY::NODE_TYPE_TITLE_MOVIES:
+            success = database.GetMoviesNav(db_path, page, params.GetGenreId(), params.GetYear(), params.GetActorId(), params.GetDirectorId(),
+                                            params.GetStudioId(), params.GetCountryId(), params.GetSetId(), params.GetTagId(), sorting);
+            break;
+        case VIDEODATABASEDIRECTORY::NODE_TYPE_TITLE_TVSHOWS:
+            success = database.GetTvShowsNav(db_path, page, params.GetGenreId(), params.GetYear(), params.GetActorId(), params.GetDirectorId(),
+                                             params.GetStudioId(), params.GetTagId(), sorting);
+            break;
+        default:
+            success = database.GetMusicVideosNav(db_path, page, params.GetGenreId(), params.GetYear(), params.GetActorId(), params.GetDirectorId(),
+                                                 params.GetStudioId(), params.GetAlbumId(), params.GetTagId(), sorting);
+            break;
+        }
+    }
+
+    if (!success)
+        return false;
+
+    // the database doesn't limit sorted results if the page starts beyond the end
+    int total = page.HasProperty("total") ? (int)page.GetProperty("total").asInteger() : page.Size();
+    if ((int)starting_index >= total)
+        page.ClearItems();
+
+    CLog::Log(LOGDEBUG, "UPnP: Retrieved %d items starting @ %d out of %d from the library for '%s'",
+        page.Size(), starting_index, total, path.c_str());
+
+    items.Append(page);
+    items.SetProperty("total", total);
+    items.SetProperty("upnp.paged", true);
+    return true;
+}
+
 /*----------------------------------------------------------------------
 |   CUPnPServer::BuildResponse
 +---------------------------------------------------------------------*/
@@ -767,25 +896,47 @@ CUPnPServer::BuildResponse(PLT_ActionReference&          action,
         }
     }
 
+    // a paged listing only holds the requested items out of all matches
+    NPT_Cardinal total = items.Size();
+    if (items.GetProperty("upnp.paged").asBoolean()) {
+        total = (NPT_Cardinal)items.GetProperty("total").asInteger();
+        starting_index = 0;
+    }
+
     // won't return more than UPNP_MAX_RETURNED_ITEMS items at a time to keep things smooth
     // 0 requested means as many as possible
     NPT_UInt32 max_count  = (requested_count == 0)?m_MaxReturnedItems:std::min((unsigned long)requested_count, (unsigned long)m_MaxReturnedItems);
     NPT_UInt32 stop_index = std::min((unsigned long)(starting_index + max_count), (unsigned long)items.Size()); // don't return more than we can
 
+    // the DIDL of library items only changes together with the library
+    bool cache_didl = URIUtils::IsMusicDb(items.GetPath()) || URIUtils::IsVideoDb(items.GetPath()) ||
+                      StringUtils::StartsWith(items.GetPath(), "library://");
+    NPT_UInt32 update_id;
+    { NPT_AutoLock lock(m_DidlCacheMutex);
+      update_id = m_LibraryUpdateID;
+    }
+
     NPT_Cardinal count = 0;
-    NPT_Cardinal total = items.Size();
     NPT_String didl = didl_header;
     PLT_MediaObjectReference object;
     for (unsigned long i=starting_index; i<stop_index; ++i) {
-        object = Build(items[i], true, context, thumb_loader, parent_id);
-        if (object.IsNull()) {
-            // don't tell the client this item ever existed
-            --total;
-            continue;
-        }
-
         NPT_String tmp;
-        NPT_CHECK(PLT_Didl::ToDidl(*object.AsPointer(), filter, tmp));
+        std::string key;
+        if (cache_didl)
+            key = GetDidlCacheKey(*items[i], filter, context, parent_id);
+
+        if (key.empty() || !GetCachedDidl(key, tmp)) {
+            object = Build(items[i], true, context, thumb_loader, parent_id);
+            if (object.IsNull()) {
+                // don't tell the client this item ever existed
+                --total;
+                continue;
+            }
+
+            NPT_CHECK(PLT_Didl::ToDidl(*object.AsPointer(), filter, tmp));
+            if (!key.empty())
+                AddCachedDidl(key, tmp, update_id);
+        }
 
         // Neptunes string growing is dead slow for small additions
         if (didl.GetCapacity() < tmp.GetLength() + didl.GetLength()) {
@@ -1216,6 +1367,95 @@ CUPnPServer::ServeFile(const NPT_HttpRequest&              request,
                                        file_path);
 }
 
+/*----------------------------------------------------------------------
+|   CUPnPServer::GetDidlCacheKey
++---------------------------------------------------------------------*/
+std::string
+CUPnPServer::GetDidlCacheKey(const CFileItem&              item,
+                             const char*                   filter,
+                             const PLT_HttpRequestContext& context,
+                             const char*                   parent_id)
+{
+    // the resource URIs depend on the local address, the mime types and
+    // quirks on the client
+    const NPT_HttpHeaders& headers = context.GetRequest().GetHeaders();
+    const NPT_String* user_agent = headers.GetHeaderValue(NPT_HTTP_HEADER_USER_AGENT);
+    const NPT_String* server     = headers.GetHeaderValue(NPT_HTTP_HEADER_SERVER);
+
+    std::string key = item.GetPath();
+    key += "\n";
+    key += parent_id ? parent_id : "";
+    key += "\n";
+    key += filter ? filter : "";
+    key += "\n";
+    key += (const char*)context.GetLocalAddress().ToString();
+    key += "\n";
+    key += user_agent ? (const char*)*user_agent : "";
+    key += "\n";
+    key += server ? (const char*)*server : "";
+    return key;
+}
+
+/*----------------------------------------------------------------------
+|   CUPnPServer::GetCachedDidl
++---------------------------------------------------------------------*/
+bool
+CUPnPServer::GetCachedDidl(const std::string& key, NPT_String& didl)
+{
+    NPT_AutoLock lock(m_DidlCacheMutex);
+    std::unordered_map<std::string, DidlCacheList::iterator>::iterator itr = m_DidlCacheIndex.find(key);
+    if (itr == m_DidlCacheIndex.end())
+        return false;
+
+    m_DidlCache.splice(m_DidlCache.begin(), m_DidlCache, itr->second);
+    didl = itr->second->didl;
+    return true;
+}
+
+/*----------------------------------------------------------------------
+|   CUPnPServer::AddCachedDidl
++---------------------------------------------------------------------*/
+void
+CUPnPServer::AddCachedDidl(const std::string& key, const NPT_String& didl, NPT_UInt32 update_id)
+{
+    size_t size = key.size() + didl.GetLength();
+    if (size > didl_cache_size / 4)
+        return;
+
+    NPT_AutoLock lock(m_DidlCacheMutex);
+
+    // the library changed while the DIDL was built
+    if (update_id != m_LibraryUpdateID || m_DidlCacheIndex.find(key) != m_DidlCacheIndex.end())
+        return;
+
+    CDidlCacheEntry entry;
+    entry.key = key;
+    entry.didl = didl;
+    m_DidlCache.push_front(entry);
+    m_DidlCacheIndex[key] = m_DidlCache.begin();
+    m_DidlCacheSize += size;
+
+    while (m_DidlCacheSize > didl_cache_size) {
+        DidlCacheList::iterator last = --m_DidlCache.end();
+        m_DidlCacheSize -= last->key.size() + last->didl.GetLength();
+        m_DidlCacheIndex.erase(last->key);
+        m_DidlCache.erase(last);
+    }
+}
+
+/*----------------------------------------------------------------------
+|   CUPnPServer::InvalidateDidlCache
++---------------------------------------------------------------------*/
+void
+CUPnPServer::InvalidateDidlCache()
+{
+    NPT_AutoLock lock(m_DidlCacheMutex);
+    ++m_LibraryUpdateID;
+    m_DidlCacheIndex.clear();
+    m_DidlCache.clear();
+    m_DidlCacheSize = 0;
+}
+
 /*----------------------------------------------------------------------
 |   CUPnPServer::SortItems
 |
@@ -8,6 +8,9 @@
 
 #pragma once
 
+#include <list>
+#include <string>
+#include <unordered_map>
 #include <utility>
 #include <Platinum/Source/Devices/MediaConnect/PltMediaConnect.h>
 
@@ -104,6 +107,10 @@ private:
                            const PLT_HttpRequestContext& context,
                            NPT_Reference<CThumbLoader>&  thumbLoader,
                            const char*                   parent_id = NULL);
+    bool GetLibraryPage(const std::string& path,
+                        NPT_UInt32         starting_index,
+                        NPT_UInt32         count,
+                        CFileItemList&     items);
     NPT_Result BuildResponse(PLT_ActionReference&          action,
                              CFileItemList&                items,
                              const char*                   filter,
@@ -123,8 +130,29 @@ private:
         return file_path.Left(index);
     }
 
+    // cache of the DIDL fragments of library items
+    std::string GetDidlCacheKey(const CFileItem&              item,
+                                const char*                   filter,
+                                const PLT_HttpRequestContext& context,
+                                const char*                   parent_id);
+    bool GetCachedDidl(const std::string& key, NPT_String& didl);
+    void AddCachedDidl(const std::string& key, const NPT_String& didl, NPT_UInt32 update_id);
+    void InvalidateDidlCache();
+
     NPT_Mutex m_CacheMutex;
 
+    struct CDidlCacheEntry
+    {
+        std::string key;
+        NPT_String  didl;
+    };
+    typedef std::list<CDidlCacheEntry> DidlCacheList;
+    NPT_Mutex m_DidlCacheMutex;
+    DidlCacheList m_DidlCache; // most recently used first
+    std::unordered_map<std::string, DidlCacheList::iterator> m_DidlCacheIndex;
+    size_t m_DidlCacheSize;
+    NPT_UInt32 m_LibraryUpdateID; // incremented on every change of a library container
+
     NPT_Mutex m_FileMutex;
     NPT_Map<NPT_String, NPT_String> m_FileMap;
 
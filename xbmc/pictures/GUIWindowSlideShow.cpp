@@ -22,6 +22,7 @@
 #include "GUIDialogPictureInfo.h"
 #include "GUIUserMessages.h"
 #include "guilib/GUIWindowManager.h"
+#include "settings/AdvancedSettings.h"
 #include "settings/DisplaySettings.h"
 #include "settings/Settings.h"
 #include "FileItem.h"
@@ -40,6 +41,7 @@
 #ifdef TARGET_POSIX
 #include "platform/linux/XTimeUtils.h"
 #endif
+#include <algorithm>
 #include <random>
 
 using namespace XFILE;
@@ -83,6 +85,9 @@ void CBackgroundPicLoader::Create(CGUIWindowSlideShow *pCallback)
 {
   m_pCallback = pCallback;
   m_isLoading = false;
+  if (g_advancedSettings.m_slideshowPrefetch > 0)
+    m_cache.reset(new CSlideShowCache(static_cast<size_t>(g_advancedSettings.m_slideshowCacheSize) * 1024 * 1024,
+                                      g_advancedSettings.m_slideshowCacheThreads));
   CThread::Create(false);
 }
 
@@ -97,7 +102,11 @@ void CBackgroundPicLoader::Process()
       if (m_pCallback)
       {
         unsigned int start = XbmcThreads::SystemClockMillis();
-        CBaseTexture* texture = CTexture::LoadFromFile(m_strFileName, m_maxWidth, m_maxHeight);
+        CBaseTexture* texture;
+        if (m_cache)
+          texture = m_cache->Take(m_strFileName, m_maxWidth, m_maxHeight);
+        else
+          texture = CTexture::LoadFromFile(m_strFileName, m_maxWidth, m_maxHeight);
         totalTime += XbmcThreads::SystemClockMillis() - start;
         count++;
         // tell our parent
@@ -137,6 +146,12 @@ void CBackgroundPicLoader::LoadPic(int iPic, int iSlideNumber, const std::string
   m_loadPic.Set();
 }
 
+void CBackgroundPicLoader::Prefetch(const std::vector<std::string> &fileNames, const int maxWidth, const int maxHeight)
+{
+  if (m_cache)
+    m_cache->Prefetch(fileNames, maxWidth, maxHeight);
+}
+
 CGUIWindowSlideShow::CGUIWindowSlideShow(void)
     : CGUIDialog(WINDOW_SLIDESHOW, "SlideShow.xml")
 {
@@ -223,6 +238,7 @@ void CGUIWindowSlideShow::Reset()
   m_iCurrentPic = 0;
   m_iDirection = 1;
   m_iLastFailedNextSlide = -1;
+  m_iPrefetchSlide = -1;
   m_slides.clear();
   AnnouncePlaylistClear();
   m_Resolution = CServiceBroker::GetWinSystem()->GetGfxContext().GetVideoResolution();
@@ -390,6 +406,7 @@ void CGUIWindowSlideShow::Process(unsigned int currentTime, CDirtyRegionList &re
   {
     m_pBackgroundLoader.reset(new CBackgroundPicLoader());
     m_pBackgroundLoader->Create(this);
+    m_iPrefetchSlide = -1;
   }
 
   bool bSlideShow = m_bSlideShow && !m_bPause && !m_bPlayingVideo;
@@ -509,6 +526,8 @@ void CGUIWindowSlideShow::Process(unsigned int currentTime, CDirtyRegionList &re
     }
   }
 
+  Prefetch(res);
+
   if (m_slides.at(m_iCurrentSlide)->IsVideo() &&
       m_iVideoSlide != m_iCurrentSlide)
   {
@@ -1157,6 +1176,7 @@ void CGUIWindowSlideShow::Shuffle()
   KODI::UTILS::RandomShuffle(m_slides.begin(), m_slides.end());
   m_iCurrentSlide = 0;
   m_iNextSlide = GetNextSlide();
+  m_iPrefetchSlide = -1;
   m_bShuffled = true;
 
   AnnouncePropertyChanged("shuffled", true);
@@ -1274,6 +1294,45 @@ void CGUIWindowSlideShow::GetCheckedSize(float width, float height, int &maxWidt
   maxHeight = CServiceBroker::GetRenderSystem()->GetMaxTextureSize();
 }
 
+void CGUIWindowSlideShow::Prefetch(const RESOLUTION_INFO &res)
+{
+  if (g_advancedSettings.m_slideshowPrefetch <= 0)
+    return;
+
+  if (m_iPrefetchSlide == m_iCurrentSlide && m_iPrefetchDirection == m_iDirection &&
+      m_iPrefetchSlides == m_slides.size())
+    return;
+
+  m_iPrefetchSlide = m_iCurrentSlide;
+  m_iPrefetchDirection = m_iDirection;
+  m_iPrefetchSlides = m_slides.size();
+
+  // pictures ahead in the current direction come first, then some behind for going back
+  const int slides = static_cast<int>(m_slides.size());
+  const int step = m_iDirection >= 0 ? 1 : -1;
+  const int ahead = std::min(g_advancedSettings.m_slideshowPrefetch, slides - 1);
+  const int behind = std::min((g_advancedSettings.m_slideshowPrefetch + 1) / 2, slides - 1 - ahead);
+
+  std::vector<std::string> paths;
+  auto add = [this, &paths, slides](int slide)
+  {
+    // videos would need their thumb to be extracted first
+    const CFileItemPtr &item = m_slides.at((slide % slides + slides) % slides);
+    if (!item->IsVideo() && !item->HasProperty("unplayable"))
+      paths.push_back(item->GetPath());
+  };
+  for (int i = 1; i <= ahead; i++)
+    add(m_iCurrentSlide + i * step);
+  for (int i = 1; i <= behind; i++)
+    add(m_iCurrentSlide - i * step);
+
+  int maxWidth, maxHeight;
+  GetCheckedSize((float)res.iWidth * m_fZoom,
+                 (float)res.iHeight * m_fZoom,
+                 maxWidth, maxHeight);
+  m_pBackgroundLoader->Prefetch(paths, maxWidth, maxHeight);
+}
+
 std::string CGUIWindowSlideShow::GetPicturePath(CFileItem *item)
 {
   bool isVideo = item->IsVideo();
@@ -14,6 +14,7 @@
 #include "threads/Thread.h"
 #include "threads/CriticalSection.h"
 #include "threads/Event.h"
+#include "SlideShowCache.h"
 #include "SlideShowPicture.h"
 #include "utils/SortUtils.h"
 
@@ -30,6 +31,7 @@ public:
 
   void Create(CGUIWindowSlideShow *pCallback);
   void LoadPic(int iPic, int iSlideNumber, const std::string &strFileName, const int maxWidth, const int maxHeight);
+  void Prefetch(const std::vector<std::string> &fileNames, const int maxWidth, const int maxHeight);
   bool IsLoading() { return m_isLoading;};
   int SlideNumber() const { return m_iSlideNumber; }
   int Pic() const { return m_iPic; }
@@ -46,6 +48,7 @@ private:
   bool m_isLoading;
 
   CGUIWindowSlideShow *m_pCallback;
+  std::unique_ptr<CSlideShowCache> m_cache;
 };
 
 class CGUIWindowSlideShow : public CGUIDialog
@@ -112,6 +115,7 @@ private:
   void GetCheckedSize(float width, float height, int &maxWidth, int &maxHeight);
   std::string GetPicturePath(CFileItem *item);
   int  GetNextSlide();
+  void Prefetch(const RESOLUTION_INFO &res);
 
   void AnnouncePlayerPlay(const CFileItemPtr& item);
   void AnnouncePlayerPause(const CFileItemPtr& item);
@@ -144,6 +148,9 @@ private:
   // background loader
   std::unique_ptr<CBackgroundPicLoader> m_pBackgroundLoader;
   int m_iLastFailedNextSlide;
+  int m_iPrefetchSlide = -1;
+  int m_iPrefetchDirection = 0;
+  size_t m_iPrefetchSlides = 0;
   bool m_bLoadNextPic;
   RESOLUTION m_Resolution;
   CPoint m_firstGesturePoint;
@@ -0,0 +1,164 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "PictureDatabase.h"
+#include "FileItem.h"
+#include "dbwrappers/dataset.h"
+#include "filesystem/File.h"
+#include "utils/JSONVariantParser.h"
+#include "utils/JSONVariantWriter.h"
+#include "utils/log.h"
+#include "utils/URIUtils.h"
+#include "utils/Variant.h"
+
+#include <inttypes.h>
+
+CPictureDatabase::CPictureDatabase() = default;
+
+CPictureDatabase::~CPictureDatabase() = default;
+
+bool CPictureDatabase::Open()
+{
+  return CDatabase::Open();
+}
+
+void CPictureDatabase::CreateTables()
+{
+  CLog::Log(LOGINFO, "create picture table");
+  m_pDS->exec("CREATE TABLE picture ("
+              "idPicture integer primary key,"
+              "path text,"
+              "folder text,"
+              "size integer,"
+              "mtime text,"
+              "loaded integer,"
+              "tag text)");
+}
+
+void CPictureDatabase::CreateAnalytics()
+{
+  CLog::Log(LOGINFO, "%s - creating indices", __FUNCTION__);
+  m_pDS->exec("CREATE UNIQUE INDEX idxPicturePath ON picture(path)");
+  m_pDS->exec("CREATE INDEX idxPictureFolder ON picture(folder)");
+}
+
+void CPictureDatabase::UpdateTables(int version)
+{
+}
+
+bool CPictureDatabase::GetPictureInfos(const std::string &folder, std::map<std::string, CEntry> &entries)
+{
+  try
+  {
+    if (NULL == m_pDB.get()) return false;
+    if (NULL == m_pDS.get()) return false;
+
+    std::string sql = PrepareSQL("SELECT path, size, mtime, loaded, tag FROM picture WHERE folder='%s'", folder.c_str());
+    m_pDS->query(sql);
+    while (!m_pDS->eof())
+    {
+      GetEntry(entries[m_pDS->fv(0).get_asString()]);
+      m_pDS->next();
+    }
+    m_pDS->close();
+    return true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s failed on folder '%s'", __FUNCTION__, folder.c_str());
+  }
+  return false;
+}
+
+bool CPictureDatabase::GetPictureInfo(const std::string &path, CEntry &entry)
+{
+  try
+  {
+    if (NULL == m_pDB.get()) return false;
+    if (NULL == m_pDS.get()) return false;
+
+    std::string sql = PrepareSQL("SELECT path, size, mtime, loaded, tag FROM picture WHERE path='%s'", path.c_str());
+    m_pDS->query(sql);
+    if (!m_pDS->eof())
+    {
+      GetEntry(entry);
+      m_pDS->close();
+      return true;
+    }
+    m_pDS->close();
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s failed on path '%s'", __FUNCTION__, path.c_str());
+  }
+  return false;
+}
+
+bool CPictureDatabase::SetPictureInfos(const std::map<std::string, CEntry> &entries)
+{
+  try
+  {
+    if (NULL == m_pDB.get()) return false;
+    if (NULL == m_pDS.get()) return false;
+
+    BeginTransaction();
+    for (const auto &it : entries)
+    {
+      std::string tag;
+      if (it.second.tag.Loaded())
+      {
+        CVariant value;
+        it.second.tag.Serialize(value);
+        CJSONVariantWriter::Write(value, tag, true);
+      }
+
+      m_pDS->exec(PrepareSQL("DELETE FROM picture WHERE path='%s'", it.first.c_str()));
+      m_pDS->exec(PrepareSQL("INSERT INTO picture (idPicture, path, folder, size, mtime, loaded, tag) VALUES(NULL, '%s', '%s', %" PRIi64 ", '%s', %i, '%s')",
+                             it.first.c_str(), URIUtils::GetDirectory(it.first).c_str(), it.second.size,
+                             it.second.mtime.c_str(), it.second.tag.Loaded() ? 1 : 0, tag.c_str()));
+    }
+    return CommitTransaction();
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s failed on %u pictures", __FUNCTION__, static_cast<unsigned int>(entries.size()));
+    RollbackTransaction();
+  }
+  return false;
+}
+
+bool CPictureDatabase::GetFileKey(const CFileItem &item, int64_t &size, std::string &mtime)
+{
+  size = item.m_dwSize;
+  mtime = item.m_dateTime.IsValid() ? item.m_dateTime.GetAsDBDateTime() : "";
+  if (size > 0 && !mtime.empty())
+    return true;
+
+  // items which don't come from a directory listing (e.g. the slideshow) don't always have the details
+  struct __stat64 buffer;
+  if (XFILE::CFile::Stat(item.GetPath(), &buffer) == 0)
+  {
+    size = buffer.st_size;
+    time_t time = buffer.st_mtime;
+    CDateTime dateTime(time);
+    mtime = dateTime.IsValid() ? dateTime.GetAsDBDateTime() : "";
+  }
+  return size > 0 || !mtime.empty();
+}
+
+// Reads the entry from the current row of m_pDS
+void CPictureDatabase::GetEntry(CEntry &entry)
+{
+  entry.size = m_pDS->fv(1).get_asInt64();
+  entry.mtime = m_pDS->fv(2).get_asString();
+  entry.tag.Reset();
+
+  CVariant value;
+  if (m_pDS->fv(3).get_asInt() && CJSONVariantParser::Parse(m_pDS->fv(4).get_asString(), value))
+    entry.tag.Deserialize(value);
+}
@@ -0,0 +1,69 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "PictureInfoTag.h"
+#include "dbwrappers/Database.h"
+
+#include <map>
+#include <string>
+
+class CFileItem;
+
+/*!
+ \brief Index of the EXIF/IPTC metadata of pictures.
+
+ The metadata is keyed by the path of the picture together with its size and
+ modification time, an entry whose key no longer matches the file has to be
+ parsed again. Pictures without any metadata are indexed as well so they
+ aren't parsed over and over.
+ */
+class CPictureDatabase : public CDatabase
+{
+public:
+  struct CEntry
+  {
+    int64_t size = 0;
+    std::string mtime;
+    CPictureInfoTag tag;
+  };
+
+  CPictureDatabase();
+  ~CPictureDatabase() override;
+  bool Open() override;
+
+  /*!
+   \brief Get the entries of all pictures in the given folder.
+   \param folder the folder, with a trailing slash
+   \param entries the entries keyed by path
+   */
+  bool GetPictureInfos(const std::string &folder, std::map<std::string, CEntry> &entries);
+  bool GetPictureInfo(const std::string &path, CEntry &entry);
+
+  /*!
+   \brief Store the given entries keyed by path in a single transaction.
+   */
+  bool SetPictureInfos(const std::map<std::string, CEntry> &entries);
+
+  /*!
+   \brief Get the key identifying the current version of the file of the item.
+   \return false if neither the size nor the modification time are known
+   */
+  static bool GetFileKey(const CFileItem &item, int64_t &size, std::string &mtime);
+
+protected:
+  void CreateTables() override;
+  void CreateAnalytics() override;
+  void UpdateTables(int version) override;
+  int GetSchemaVersion() const override { return 1; }
+  const char *GetBaseDBName() const override { return "Pictures"; }
+
+private:
+  void GetEntry(CEntry &entry);
+};
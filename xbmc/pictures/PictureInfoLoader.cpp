@@ -11,6 +11,13 @@
 #include "ServiceBroker.h"
 #include "settings/Settings.h"
 #include "FileItem.h"
+#include "utils/URIUtils.h"
+
+namespace
+{
+// number of parsed pictures written to the index in a single transaction
+const size_t INDEX_BATCH_SIZE = 50;
+}
 
 CPictureInfoLoader::CPictureInfoLoader()
 {
@@ -34,6 +41,14 @@ void CPictureInfoLoader::OnLoaderStart()
   m_tagReads = 0;
   m_loadTags = CServiceBroker::GetSettings().GetBool(CSettings::SETTING_PICTURES_USETAGS);
 
+  // fetch the indexed metadata of the whole folder at once
+  if (m_loadTags && m_database.Open())
+  {
+    std::string folder = m_pVecItems->GetPath();
+    URIUtils::AddSlashAtEnd(folder);
+    m_database.GetPictureInfos(folder, m_index);
+  }
+
   if (m_pProgressCallback)
     m_pProgressCallback->SetProgressMax(m_pVecItems->GetFileCount());
 }
@@ -78,19 +93,71 @@ bool CPictureInfoLoader::LoadItemLookup(CFileItem* pItem)
     return false;
 
   if (m_loadTags)
-  { // Nothing found, load tag from file
+  {
+    int64_t size;
+    std::string mtime;
+    bool hasKey = CPictureDatabase::GetFileKey(*pItem, size, mtime);
+    if (hasKey && LoadFromDatabase(pItem, size, mtime))
+      return true;
+
+    // Nothing found, load tag from file
     pItem->GetPictureInfoTag()->Load(pItem->GetPath());
     m_tagReads++;
+
+    if (hasKey)
+    {
+      CPictureDatabase::CEntry &entry = m_pending[pItem->GetPath()];
+      entry.size = size;
+      entry.mtime = mtime;
+      entry.tag = *pItem->GetPictureInfoTag();
+      if (m_pending.size() >= INDEX_BATCH_SIZE)
+        FlushDatabase();
+    }
+  }
+
+  return true;
+}
+
+bool CPictureInfoLoader::LoadFromDatabase(CFileItem* pItem, int64_t size, const std::string& mtime)
+{
+  auto it = m_index.find(pItem->GetPath());
+  if (it == m_index.end())
+  {
+    // pictures outside of the listed folder (e.g. flattened listings) are looked up one by one
+    CPictureDatabase::CEntry entry;
+    std::string folder = m_pVecItems->GetPath();
+    URIUtils::AddSlashAtEnd(folder);
+    if (URIUtils::GetDirectory(pItem->GetPath()) == folder ||
+        !m_database.GetPictureInfo(pItem->GetPath(), entry))
+      return false;
+    it = m_index.insert(std::make_pair(pItem->GetPath(), entry)).first;
   }
 
+  // the file changed since it was indexed
+  if (it->second.size != size || it->second.mtime != mtime)
+    return false;
+
+  *pItem->GetPictureInfoTag() = it->second.tag;
+  m_tagReads++;
   return true;
 }
 
+void CPictureInfoLoader::FlushDatabase()
+{
+  if (!m_pending.empty())
+    m_database.SetPictureInfos(m_pending);
+  m_pending.clear();
+}
+
 void CPictureInfoLoader::OnLoaderFinish()
 {
   // cleanup cache loaded from HD
   m_mapFileItems->Clear();
 
+  FlushDatabase();
+  m_index.clear();
+  m_database.Close();
+
   // Save loaded items to HD
   if (!m_bStop && m_tagReads > 0)
     m_pVecItems->Save();
@@ -9,6 +9,9 @@
 #pragma once
 
 #include "BackgroundInfoLoader.h"
+#include "PictureDatabase.h"
+
+#include <map>
 #include <string>
 
 class CPictureInfoLoader : public CBackgroundInfoLoader
@@ -26,8 +29,15 @@ protected:
   void OnLoaderStart() override;
   void OnLoaderFinish() override;
 
+  bool LoadFromDatabase(CFileItem* pItem, int64_t size, const std::string& mtime);
+  void FlushDatabase();
+
   CFileItemList* m_mapFileItems;
   unsigned int m_tagReads;
   bool m_loadTags;
+
+  CPictureDatabase m_database;
+  std::map<std::string, CPictureDatabase::CEntry> m_index;   //!< indexed pictures of the folder
+  std::map<std::string, CPictureDatabase::CEntry> m_pending; //!< parsed pictures yet to be indexed
 };
 
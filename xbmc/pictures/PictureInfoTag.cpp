@@ -244,6 +244,78 @@ void CPictureInfoTag::Serialize(CVariant& value) const
   value["imagetype"] = std::string(m_iptcInfo.ImageType);
 }
 
+void CPictureInfoTag::Deserialize(const CVariant& value)
+{
+  Reset();
+
+  m_exifInfo.ApertureFNumber = value["aperturefnumber"].asFloat();
+  GetStringFromVariant(value["cameramake"], m_exifInfo.CameraMake, sizeof(m_exifInfo.CameraMake));
+  GetStringFromVariant(value["cameramodel"], m_exifInfo.CameraModel, sizeof(m_exifInfo.CameraModel));
+  m_exifInfo.CCDWidth = value["ccdwidth"].asFloat();
+  GetStringFromVariant(value["comments"], m_exifInfo.Comments, sizeof(m_exifInfo.Comments));
+  m_exifInfo.CommentsCharset = EXIF_COMMENT_CHARSET_CONVERTED; // Serialized with the charset converted
+  GetStringFromVariant(value["description"], m_exifInfo.Description, sizeof(m_exifInfo.Description));
+  GetStringFromVariant(value["datetime"], m_exifInfo.DateTime, sizeof(m_exifInfo.DateTime));
+  for (unsigned int i = 0; i < 10 && i < value["datetimeoffsets"].size(); i++)
+    m_exifInfo.DateTimeOffsets[i] = value["datetimeoffsets"][i].asInteger32();
+  m_exifInfo.DigitalZoomRatio = value["digitalzoomratio"].asFloat();
+  m_exifInfo.Distance = value["distance"].asFloat();
+  m_exifInfo.ExposureBias = value["exposurebias"].asFloat();
+  m_exifInfo.ExposureMode = value["exposuremode"].asInteger32();
+  m_exifInfo.ExposureProgram = value["exposureprogram"].asInteger32();
+  m_exifInfo.ExposureTime = value["exposuretime"].asFloat();
+  m_exifInfo.FlashUsed = value["flashused"].asInteger32();
+  m_exifInfo.FocalLength = value["focallength"].asFloat();
+  m_exifInfo.FocalLength35mmEquiv = value["focallength35mmequiv"].asInteger32();
+  m_exifInfo.GpsInfoPresent = value["gpsinfopresent"].asInteger32();
+  GetStringFromVariant(value["gpsinfo"]["alt"], m_exifInfo.GpsAlt, sizeof(m_exifInfo.GpsAlt));
+  GetStringFromVariant(value["gpsinfo"]["lat"], m_exifInfo.GpsLat, sizeof(m_exifInfo.GpsLat));
+  GetStringFromVariant(value["gpsinfo"]["long"], m_exifInfo.GpsLong, sizeof(m_exifInfo.GpsLong));
+  m_exifInfo.Height = value["height"].asInteger32();
+  m_exifInfo.IsColor = value["iscolor"].asInteger32();
+  m_exifInfo.ISOequivalent = value["isoequivalent"].asInteger32();
+  m_exifInfo.LargestExifOffset = value["largestexifoffset"].asUnsignedInteger32();
+  m_exifInfo.LightSource = value["lightsource"].asInteger32();
+  m_exifInfo.MeteringMode = value["meteringmode"].asInteger32();
+  m_exifInfo.numDateTimeTags = value["numdatetimetags"].asInteger32();
+  m_exifInfo.Orientation = value["orientation"].asInteger32();
+  m_exifInfo.Process = value["process"].asInteger32();
+  m_exifInfo.ThumbnailAtEnd = static_cast<char>(value["thumbnailatend"].asInteger32());
+  m_exifInfo.ThumbnailOffset = value["thumbnailoffset"].asUnsignedInteger32();
+  m_exifInfo.ThumbnailSize = value["thumbnailsize"].asUnsignedInteger32();
+  m_exifInfo.ThumbnailSizeOffset = value["thumbnailsizeoffset"].asInteger32();
+  m_exifInfo.Whitebalance = value["whitebalance"].asInteger32();
+  m_exifInfo.Width = value["width"].asInteger32();
+
+  GetStringFromVariant(value["author"], m_iptcInfo.Author, sizeof(m_iptcInfo.Author));
+  GetStringFromVariant(value["byline"], m_iptcInfo.Byline, sizeof(m_iptcInfo.Byline));
+  GetStringFromVariant(value["bylinetitle"], m_iptcInfo.BylineTitle, sizeof(m_iptcInfo.BylineTitle));
+  GetStringFromVariant(value["caption"], m_iptcInfo.Caption, sizeof(m_iptcInfo.Caption));
+  GetStringFromVariant(value["category"], m_iptcInfo.Category, sizeof(m_iptcInfo.Category));
+  GetStringFromVariant(value["city"], m_iptcInfo.City, sizeof(m_iptcInfo.City));
+  GetStringFromVariant(value["urgency"], m_iptcInfo.Urgency, sizeof(m_iptcInfo.Urgency));
+  GetStringFromVariant(value["copyrightnotice"], m_iptcInfo.CopyrightNotice, sizeof(m_iptcInfo.CopyrightNotice));
+  GetStringFromVariant(value["country"], m_iptcInfo.Country, sizeof(m_iptcInfo.Country));
+  GetStringFromVariant(value["countrycode"], m_iptcInfo.CountryCode, sizeof(m_iptcInfo.CountryCode));
+  GetStringFromVariant(value["credit"], m_iptcInfo.Credit, sizeof(m_iptcInfo.Credit));
+  GetStringFromVariant(value["date"], m_iptcInfo.Date, sizeof(m_iptcInfo.Date));
+  GetStringFromVariant(value["headline"], m_iptcInfo.Headline, sizeof(m_iptcInfo.Headline));
+  GetStringFromVariant(value["keywords"], m_iptcInfo.Keywords, sizeof(m_iptcInfo.Keywords));
+  GetStringFromVariant(value["objectname"], m_iptcInfo.ObjectName, sizeof(m_iptcInfo.ObjectName));
+  GetStringFromVariant(value["referenceservice"], m_iptcInfo.ReferenceService, sizeof(m_iptcInfo.ReferenceService));
+  GetStringFromVariant(value["source"], m_iptcInfo.Source, sizeof(m_iptcInfo.Source));
+  GetStringFromVariant(value["specialinstructions"], m_iptcInfo.SpecialInstructions, sizeof(m_iptcInfo.SpecialInstructions));
+  GetStringFromVariant(value["state"], m_iptcInfo.State, sizeof(m_iptcInfo.State));
+  GetStringFromVariant(value["supplementalcategories"], m_iptcInfo.SupplementalCategories, sizeof(m_iptcInfo.SupplementalCategories));
+  GetStringFromVariant(value["transmissionreference"], m_iptcInfo.TransmissionReference, sizeof(m_iptcInfo.TransmissionReference));
+  GetStringFromVariant(value["timecreated"], m_iptcInfo.TimeCreated, sizeof(m_iptcInfo.TimeCreated));
+  GetStringFromVariant(value["sublocation"], m_iptcInfo.SubLocation, sizeof(m_iptcInfo.SubLocation));
+  GetStringFromVariant(value["imagetype"], m_iptcInfo.ImageType, sizeof(m_iptcInfo.ImageType));
+
+  m_isLoaded = true;
+  ConvertDateTime();
+}
+
 void CPictureInfoTag::ToSortable(SortItem& sortable, Field field) const
 {
   if (field == FieldDateTaken && m_dateTimeTaken.IsValid())
@@ -260,6 +332,15 @@ void CPictureInfoTag::GetStringFromArchive(CArchive &ar, char *string, size_t le
   string[length] = 0;
 }
 
+void CPictureInfoTag::GetStringFromVariant(const CVariant &value, char *string, size_t length)
+{
+  std::string temp = value.asString();
+  length = std::min(temp.size(), length - 1);
+  if (!temp.empty())
+    memcpy(string, temp.c_str(), length);
+  string[length] = 0;
+}
+
 const std::string CPictureInfoTag::GetInfo(int info) const
 {
   if (!m_isLoaded && !m_isInfoSetExternally) // If no metadata has been loaded from the picture file or set with SetInfo(), just return
@@ -26,6 +26,10 @@ public:
   void Reset();
   void Archive(CArchive& ar) override;
   void Serialize(CVariant& value) const override;
+  /*!
+   \brief Restore a tag stored with Serialize(), it counts as loaded from the picture file.
+   */
+  void Deserialize(const CVariant& value);
   void ToSortable(SortItem& sortable, Field field) const override;
   const std::string GetInfo(int info) const;
 
@@ -44,6 +48,7 @@ public:
 private:
   static int TranslateString(const std::string &info);
   void GetStringFromArchive(CArchive &ar, char *string, size_t length);
+  static void GetStringFromVariant(const CVariant &value, char *string, size_t length);
 
   ExifInfo_t m_exifInfo;
   IPTCInfo_t m_iptcInfo;
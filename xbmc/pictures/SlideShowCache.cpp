@@ -0,0 +1,242 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "SlideShowCache.h"
+#include "guilib/Texture.h"
+#include "threads/SingleLock.h"
+#include "utils/JobManager.h"
+#include "utils/log.h"
+
+#include <algorithm>
+
+class CSlideShowCache::CLoadJob : public CJob
+{
+public:
+  CLoadJob(const std::string &path, int maxWidth, int maxHeight)
+    : m_path(path),
+      m_maxWidth(maxWidth),
+      m_maxHeight(maxHeight)
+  {
+  }
+
+  const char* GetType() const override { return "slideshowload"; }
+
+  bool DoWork() override
+  {
+    m_texture.reset(CTexture::LoadFromFile(m_path, m_maxWidth, m_maxHeight));
+    return m_texture != nullptr;
+  }
+
+  std::string m_path;
+  int m_maxWidth;
+  int m_maxHeight;
+  std::unique_ptr<CBaseTexture> m_texture;
+};
+
+static size_t TextureSize(const CBaseTexture &texture)
+{
+  return static_cast<size_t>(texture.GetPitch()) * texture.GetRows();
+}
+
+CSlideShowCache::CSlideShowCache(size_t budget, unsigned int threads)
+  : m_budget(budget),
+    m_threads(std::max(threads, 1u))
+{
+}
+
+CSlideShowCache::~CSlideShowCache()
+{
+  {
+    CSingleLock lock(m_critSection);
+    for (const auto &entry : m_entries)
+    {
+      if (entry.second.jobID)
+        CJobManager::GetInstance().CancelJob(entry.second.jobID);
+    }
+  }
+
+  SStats stats = GetStats();
+  CLog::Log(LOGDEBUG, "CSlideShowCache: %u hits (%u waited for the decode), %u misses, %u dropped",
+            stats.hits, stats.waits, stats.misses, stats.dropped);
+}
+
+void CSlideShowCache::Prefetch(const std::vector<std::string> &paths, int maxWidth, int maxHeight)
+{
+  CSingleLock lock(m_critSection);
+
+  for (auto it = m_entries.begin(); it != m_entries.end(); )
+  {
+    auto wanted = std::find(paths.begin(), paths.end(), it->first);
+    if (wanted == paths.end() || it->second.maxWidth != maxWidth || it->second.maxHeight != maxHeight)
+      Drop(it++);
+    else
+    {
+      it->second.priority = wanted - paths.begin();
+      ++it;
+    }
+  }
+
+  for (unsigned int i = 0; i < paths.size(); i++)
+  {
+    if (m_entries.find(paths[i]) != m_entries.end())
+      continue;
+
+    CEntry &entry = m_entries[paths[i]];
+    entry.maxWidth = maxWidth;
+    entry.maxHeight = maxHeight;
+    entry.priority = i;
+  }
+
+  StartJobs();
+}
+
+CBaseTexture* CSlideShowCache::Take(const std::string &path, int maxWidth, int maxHeight)
+{
+  CSingleLock lock(m_critSection);
+
+  auto it = m_entries.find(path);
+  if (it != m_entries.end() && (it->second.maxWidth != maxWidth || it->second.maxHeight != maxHeight))
+  {
+    Drop(it);
+    it = m_entries.end();
+  }
+
+  // a picture which isn't being decoded yet is decoded right here
+  if (it != m_entries.end() && !it->second.jobID && !it->second.texture)
+  {
+    Drop(it);
+    it = m_entries.end();
+  }
+
+  bool waited = false;
+  while (it != m_entries.end() && it->second.jobID)
+  {
+    waited = true;
+    lock.Leave();
+    m_loaded.WaitMSec(100);
+    lock.Enter();
+    it = m_entries.find(path);
+  }
+
+  if (it != m_entries.end() && it->second.texture)
+  {
+    m_stats.hits++;
+    if (waited)
+      m_stats.waits++;
+
+    CBaseTexture *texture = it->second.texture.release();
+    m_used -= TextureSize(*texture);
+    m_entries.erase(it);
+    return texture;
+  }
+
+  m_stats.misses++;
+  lock.Leave();
+
+  return CTexture::LoadFromFile(path, maxWidth, maxHeight);
+}
+
+CSlideShowCache::SStats CSlideShowCache::GetStats() const
+{
+  CSingleLock lock(m_critSection);
+  return m_stats;
+}
+
+void CSlideShowCache::OnJobComplete(unsigned int jobID, bool success, CJob *job)
+{
+  {
+    CSingleLock lock(m_critSection);
+    CLoadJob *loadJob = static_cast<CLoadJob*>(job);
+    auto it = m_entries.find(loadJob->m_path);
+    // the entry might have been dropped (and even be requested again) meanwhile
+    if (it != m_entries.end() && it->second.jobID == jobID)
+    {
+      it->second.jobID = 0;
+      m_running--;
+      if (success)
+      {
+        m_used += TextureSize(*loadJob->m_texture);
+        it->second.texture = std::move(loadJob->m_texture);
+        TrimToBudget();
+      }
+      else
+        m_entries.erase(it);
+
+      StartJobs();
+    }
+  }
+  m_loaded.Set();
+}
+
+// Always called with the lock held on m_critSection
+void CSlideShowCache::Drop(std::map<std::string, CEntry>::iterator it)
+{
+  // a cancelled job might still complete, it won't match any entry then
+  if (it->second.jobID)
+  {
+    CJobManager::GetInstance().CancelJob(it->second.jobID);
+    m_running--;
+  }
+
+  if (it->second.texture)
+  {
+    m_used -= TextureSize(*it->second.texture);
+    m_stats.dropped++;
+  }
+
+  m_entries.erase(it);
+  m_loaded.Set();
+}
+
+// Always called with the lock held on m_critSection
+void CSlideShowCache::StartJobs()
+{
+  while (m_running < m_threads && m_used < m_budget)
+  {
+    auto next = m_entries.end();
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+      if (!it->second.jobID && !it->second.texture &&
+          (next == m_entries.end() || it->second.priority < next->second.priority))
+        next = it;
+    }
+
+    if (next == m_entries.end())
+      break;
+
+    CLoadJob *job = new CLoadJob(next->first, next->second.maxWidth, next->second.maxHeight);
+    next->second.jobID = CJobManager::GetInstance().AddJob(job, this, CJob::PRIORITY_NORMAL);
+    if (!next->second.jobID)
+    {
+      delete job;
+      m_entries.erase(next);
+      break;
+    }
+    m_running++;
+  }
+}
+
+// Always called with the lock held on m_critSection
+void CSlideShowCache::TrimToBudget()
+{
+  while (m_used > m_budget)
+  {
+    auto victim = m_entries.end();
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+      if (it->second.texture &&
+          (victim == m_entries.end() || it->second.priority > victim->second.priority))
+        victim = it;
+    }
+
+    if (victim == m_entries.end())
+      break;
+
+    Drop(victim);
+  }
+}
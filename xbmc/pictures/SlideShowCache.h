@@ -0,0 +1,88 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "utils/Job.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+class CBaseTexture;
+
+/*!
+ \brief Decodes the pictures the slideshow is going to show next.
+
+ The slideshow tells the cache which pictures it wants in order of priority,
+ they are decoded on several threads until the memory budget is used up.
+ Pictures no longer wanted are dropped. Taking a picture out of the cache
+ hands over the decoded texture, if it is still being decoded this waits
+ for the decode to finish instead of starting a second one.
+ */
+class CSlideShowCache : public IJobCallback
+{
+public:
+  struct SStats
+  {
+    unsigned int hits = 0;
+    unsigned int waits = 0;  //!< hits which had to wait for the decode to finish
+    unsigned int misses = 0;
+    unsigned int dropped = 0;  //!< decoded pictures dropped before they were taken
+  };
+
+  /*!
+   \param budget maximum size of the decoded pictures held in bytes
+   \param threads number of pictures decoded at once
+   */
+  CSlideShowCache(size_t budget, unsigned int threads);
+  ~CSlideShowCache() override;
+
+  /*!
+   \brief Set the pictures to hold, ordered by priority.
+   */
+  void Prefetch(const std::vector<std::string> &paths, int maxWidth, int maxHeight);
+
+  /*!
+   \brief Get the decoded picture, decoding it now if it isn't in the cache.
+   \return the texture which is owned by the caller, or nullptr if it couldn't be decoded
+   */
+  CBaseTexture* Take(const std::string &path, int maxWidth, int maxHeight);
+
+  SStats GetStats() const;
+
+  void OnJobComplete(unsigned int jobID, bool success, CJob *job) override;
+
+private:
+  class CLoadJob;
+
+  struct CEntry
+  {
+    int maxWidth;
+    int maxHeight;
+    unsigned int priority;
+    unsigned int jobID = 0;  //!< set while the picture is being decoded
+    std::unique_ptr<CBaseTexture> texture;
+  };
+
+  void Drop(std::map<std::string, CEntry>::iterator it);
+  void StartJobs();
+  void TrimToBudget();
+
+  size_t m_budget;
+  unsigned int m_threads;
+  unsigned int m_running = 0;
+  size_t m_used = 0;
+  std::map<std::string, CEntry> m_entries;
+  SStats m_stats;
+  CEvent m_loaded;
+  mutable CCriticalSection m_critSection;
+};
@@ -83,17 +83,18 @@ void CPosixInterfaceForCLog::PrintDebugString(const std::string &debugString)
 #endif // _DEBUG
 }
 
-void CPosixInterfaceForCLog::GetCurrentLocalTime(int &hour, int &minute, int &second, double &milliseconds)
+void CPosixInterfaceForCLog::GetLocalTime(const std::chrono::system_clock::time_point &time, int &hour, int &minute, int &second, double &milliseconds)
 {
   struct tm localTime;
-  struct timeval tv;
+  time_t seconds = std::chrono::system_clock::to_time_t(time);
 
-  if (gettimeofday(&tv, nullptr) != -1 && localtime_r(&tv.tv_sec, &localTime) != NULL)
+  if (localtime_r(&seconds, &localTime) != NULL)
   {
     hour   = localTime.tm_hour;
     minute = localTime.tm_min;
     second = localTime.tm_sec;
-    milliseconds = static_cast<double>(tv.tv_usec) / 1000;
+    milliseconds = static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(
+                     time.time_since_epoch()).count() % 1000000) / 1000;
   }
   else
   {
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <string>
 
 struct FILEWRAP; // forward declaration, wrapper for FILE
@@ -21,7 +22,7 @@ public:
   void CloseLogFile(void);
   bool WriteStringToLog(const std::string& logString);
   void PrintDebugString(const std::string& debugString);
-  static void GetCurrentLocalTime(int& hour, int& minute, int& second, double& millisecond);
+  static void GetLocalTime(const std::chrono::system_clock::time_point& time, int& hour, int& minute, int& second, double& millisecond);
 private:
   FILEWRAP* m_file;
 };
@@ -13,6 +13,8 @@
 #include <vector>
 
 #include "SmartPlayList.h"
+#include "ServiceBroker.h"
+#include "SmartPlaylistCache.h"
 #include "Util.h"
 #include "dbwrappers/Database.h"
 #include "filesystem/File.h"
@@ -1337,7 +1339,15 @@ bool CSmartPlaylist::Save(const std::string &path) const
     nodeOrder.InsertEndChild(order);
     pRoot->InsertEndChild(nodeOrder);
   }
-  return doc.SaveFile(path);
+
+  if (!doc.SaveFile(path))
+    return false;
+
+  // the playlist may be included by other playlists
+  if (CServiceBroker::IsServiceManagerUp())
+    CServiceBroker::GetSmartPlaylistCache().Clear();
+
+  return true;
 }
 
 bool CSmartPlaylist::Save(CVariant &obj, bool full /* = true */) const
@@ -1432,7 +1442,20 @@ bool CSmartPlaylist::IsMusicType(const std::string &type)
 
 std::string CSmartPlaylist::GetWhereClause(const CDatabase &db, std::set<std::string> &referencedPlaylists) const
 {
-  return m_ruleCombination.GetWhereClause(db, GetType(), referencedPlaylists);
+  // only top level playlists are cached, the clause of an included playlist depends on
+  // the playlists that were already referenced
+  std::string key;
+  if (referencedPlaylists.empty() && CServiceBroker::IsServiceManagerUp() && SaveAsJson(key, false))
+  {
+    std::string whereClause;
+    if (CServiceBroker::GetSmartPlaylistCache().GetWhereClause(key, whereClause, referencedPlaylists))
+      return whereClause;
+  }
+
+  std::string whereClause = m_ruleCombination.GetWhereClause(db, GetType(), referencedPlaylists);
+  if (!key.empty())
+    CServiceBroker::GetSmartPlaylistCache().SetWhereClause(key, whereClause, referencedPlaylists);
+  return whereClause;
 }
 
 void CSmartPlaylist::GetVirtualFolders(std::vector<std::string> &virtualFolders) const
@@ -0,0 +1,196 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "SmartPlaylistCache.h"
+#include "FileItem.h"
+#include "GUIPassword.h"
+#include "ServiceBroker.h"
+#include "XBDateTime.h"
+#include "interfaces/AnnouncementManager.h"
+#include "profiles/ProfilesManager.h"
+#include "settings/MediaSourceSettings.h"
+#include "settings/Settings.h"
+#include "settings/lib/Setting.h"
+#include "threads/SingleLock.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <string.h>
+
+// Maximum number of compiled playlists to keep
+#define MAX_CACHED_WHERE_CLAUSES 200
+// Maximum number of listings to keep and the maximum size of a listing to be cached
+#define MAX_CACHED_LISTINGS 20
+#define MAX_CACHED_LISTING_SIZE 2000
+
+CSmartPlaylistCache::CSmartPlaylistCache()
+{
+  CServiceBroker::GetAnnouncementManager()->AddAnnouncer(this);
+
+  // settings applied by the databases when listing
+  std::set<std::string> settingSet;
+  settingSet.insert(CSettings::SETTING_FILELISTS_IGNORETHEWHENSORTING);
+  settingSet.insert(CSettings::SETTING_MUSICLIBRARY_SHOWCOMPILATIONARTISTS);
+  settingSet.insert(CSettings::SETTING_MUSICLIBRARY_ARTISTSFOLDER);
+  settingSet.insert(CSettings::SETTING_VIDEOLIBRARY_GROUPMOVIESETS);
+  settingSet.insert(CSettings::SETTING_VIDEOLIBRARY_GROUPSINGLEITEMSETS);
+  settingSet.insert(CSettings::SETTING_VIDEOLIBRARY_SHOWEMPTYTVSHOWS);
+  CServiceBroker::GetSettings().RegisterCallback(this, settingSet);
+}
+
+CSmartPlaylistCache::~CSmartPlaylistCache()
+{
+  CServiceBroker::GetSettings().UnregisterCallback(this);
+  CServiceBroker::GetAnnouncementManager()->RemoveAnnouncer(this);
+}
+
+void CSmartPlaylistCache::Announce(ANNOUNCEMENT::AnnouncementFlag flag, const char *sender, const char *message, const CVariant &data)
+{
+  if (flag != ANNOUNCEMENT::VideoLibrary && flag != ANNOUNCEMENT::AudioLibrary)
+    return;
+
+  // nothing has changed yet
+  if (strcmp(message, "OnScanStarted") == 0 || strcmp(message, "OnCleanStarted") == 0)
+    return;
+
+  ClearItems();
+}
+
+bool CSmartPlaylistCache::GetWhereClause(const std::string &key, std::string &whereClause, std::set<std::string> &referencedPlaylists)
+{
+  CSingleLock lock(m_critSection);
+  CheckDate();
+
+  auto it = m_whereClauses.find(key);
+  if (it == m_whereClauses.end())
+    return false;
+
+  whereClause = it->second.where;
+  referencedPlaylists.insert(it->second.referencedPlaylists.begin(), it->second.referencedPlaylists.end());
+  return true;
+}
+
+void CSmartPlaylistCache::SetWhereClause(const std::string &key, const std::string &whereClause, const std::set<std::string> &referencedPlaylists)
+{
+  CSingleLock lock(m_critSection);
+  CheckDate();
+
+  if (m_whereClauses.size() >= MAX_CACHED_WHERE_CLAUSES)
+    m_whereClauses.clear();
+
+  CWhereClause &entry = m_whereClauses[key];
+  entry.where = whereClause;
+  entry.referencedPlaylists = referencedPlaylists;
+}
+
+void CSmartPlaylistCache::OnSettingChanged(std::shared_ptr<const CSetting> setting)
+{
+  if (setting == nullptr)
+    return;
+
+  ClearItems();
+}
+
+bool CSmartPlaylistCache::GetItems(const std::string &key, CFileItemList &items)
+{
+  CSingleLock lock(m_critSection);
+  CheckDate();
+  CheckLockState();
+
+  auto it = m_items.find(key);
+  if (it == m_items.end())
+    return false;
+
+  items.Copy(*it->second.items);
+  it->second.lastAccess = m_accessCounter++;
+  return true;
+}
+
+void CSmartPlaylistCache::SetItems(const std::string &key, const CFileItemList &items)
+{
+  if (items.Size() > MAX_CACHED_LISTING_SIZE)
+    return;
+
+  std::unique_ptr<CFileItemList> copy(new CFileItemList);
+  copy->Copy(items);
+
+  CSingleLock lock(m_critSection);
+  CheckLockState();
+  if (m_items.size() >= MAX_CACHED_LISTINGS && m_items.find(key) == m_items.end())
+  {
+    // drop the least recently used listing
+    auto oldest = std::min_element(m_items.begin(), m_items.end(),
+      [](const std::pair<const std::string, CItems> &lhs, const std::pair<const std::string, CItems> &rhs)
+      {
+        return lhs.second.lastAccess < rhs.second.lastAccess;
+      });
+    m_items.erase(oldest);
+  }
+
+  CItems &entry = m_items[key];
+  entry.items = std::move(copy);
+  entry.lastAccess = m_accessCounter++;
+}
+
+void CSmartPlaylistCache::Clear()
+{
+  CSingleLock lock(m_critSection);
+  m_whereClauses.clear();
+  m_items.clear();
+}
+
+void CSmartPlaylistCache::ClearItems()
+{
+  CSingleLock lock(m_critSection);
+  if (!m_items.empty())
+    CLog::Log(LOGDEBUG, "CSmartPlaylistCache: library or settings changed, dropping %u cached listings",
+              static_cast<unsigned int>(m_items.size()));
+  m_items.clear();
+}
+
+void CSmartPlaylistCache::CheckDate()
+{
+  std::string date = CDateTime::GetCurrentDateTime().GetAsDBDate();
+  if (date != m_date)
+  {
+    m_whereClauses.clear();
+    m_items.clear();
+    m_date = date;
+  }
+}
+
+void CSmartPlaylistCache::CheckLockState()
+{
+  // locked sources are left out of the listings
+  std::string lockState = GetLockState();
+  if (lockState != m_lockState)
+  {
+    m_items.clear();
+    m_lockState = lockState;
+  }
+}
+
+std::string CSmartPlaylistCache::GetLockState()
+{
+  if (g_passwordManager.bMasterUser ||
+      CServiceBroker::GetProfileManager().GetMasterProfile().getLockMode() == LOCK_MODE_EVERYONE)
+    return "unlocked";
+
+  std::string state = "locked:";
+  for (const char *type : { "video", "music" })
+  {
+    const VECSOURCES *sources = CMediaSourceSettings::GetInstance().GetSources(type);
+    if (sources == nullptr)
+      continue;
+
+    for (const auto &source : *sources)
+      state += std::to_string(source.m_iHasLock);
+    state += ";";
+  }
+  return state;
+}
@@ -0,0 +1,89 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "interfaces/IAnnouncer.h"
+#include "settings/lib/ISettingCallback.h"
+#include "threads/CriticalSection.h"
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+
+class CFileItemList;
+
+/*!
+ \brief Cache for compiled smart playlists and their listings.
+
+ Compiling a smart playlist into an SQL WHERE clause involves formatting every rule and
+ loading all playlists referenced by it from disk. As the clause only depends on the rules
+ it is kept until a playlist is saved or the day changes (rules like "in the last 2 weeks"
+ are compiled to a fixed date).
+
+ The listings of smart playlist directories are kept until the video or music library
+ announces a change, the day changes, a setting the listings depend on changes or the
+ master lock state (unlocked sources, master user) changes.
+ */
+class CSmartPlaylistCache : public ANNOUNCEMENT::IAnnouncer, public ISettingCallback
+{
+public:
+  CSmartPlaylistCache();
+  ~CSmartPlaylistCache() override;
+
+  void Announce(ANNOUNCEMENT::AnnouncementFlag flag, const char *sender, const char *message, const CVariant &data) override;
+
+  void OnSettingChanged(std::shared_ptr<const CSetting> setting) override;
+
+  /*! \brief Look up a compiled WHERE clause.
+   \param key the serialized playlist rules and type
+   \param whereClause [out] the compiled clause
+   \param referencedPlaylists [out] the playlists included while compiling
+   \return true if the clause was found.
+   */
+  bool GetWhereClause(const std::string &key, std::string &whereClause, std::set<std::string> &referencedPlaylists);
+  void SetWhereClause(const std::string &key, const std::string &whereClause, const std::set<std::string> &referencedPlaylists);
+
+  /*! \brief Look up the listing of a smart playlist directory.
+   \param key the path and content of the playlist
+   \param items [out] a copy of the cached items
+   \return true if the listing was found.
+   */
+  bool GetItems(const std::string &key, CFileItemList &items);
+  void SetItems(const std::string &key, const CFileItemList &items);
+
+  /*! \brief Drop all compiled playlists and listings, e.g. because a playlist was saved.
+   */
+  void Clear();
+  void ClearItems();
+
+private:
+  struct CWhereClause
+  {
+    std::string where;
+    std::set<std::string> referencedPlaylists;
+  };
+
+  struct CItems
+  {
+    std::unique_ptr<CFileItemList> items;
+    unsigned int lastAccess = 0;
+  };
+
+  void CheckDate();
+  void CheckLockState();
+  static std::string GetLockState();
+
+  std::map<std::string, CWhereClause> m_whereClauses;
+  std::map<std::string, CItems> m_items;
+  std::string m_date;
+  std::string m_lockState;
+  unsigned int m_accessCounter = 0;
+  CCriticalSection m_critSection;
+};
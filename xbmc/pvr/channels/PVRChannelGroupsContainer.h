@@ -190,7 +190,7 @@ namespace PVR
   protected:
     CPVRChannelGroups *m_groupsRadio; /*!< all radio channel groups */
     CPVRChannelGroups *m_groupsTV;    /*!< all TV channel groups */
-    CCriticalSection   m_critSection;
+    CCriticalSection   m_critSection{"CPVRChannelGroupsContainer"};
     bool               m_bUpdateChannelsOnly = false;
     bool               m_bIsUpdating = false;
     CPVRChannelGroupPtr m_lastPlayedGroups[2]; /*!< used to store the last played groups */
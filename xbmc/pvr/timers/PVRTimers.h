@@ -59,7 +59,7 @@ namespace PVR
   protected:
     void InsertTimer(const CPVRTimerInfoTagPtr &newTimer);
 
-    mutable CCriticalSection m_critSection;
+    mutable CCriticalSection m_critSection{"CPVRTimers"};
     unsigned int m_iLastId = 0;
     MapTags m_tags;
   };
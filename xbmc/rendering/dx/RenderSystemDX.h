@@ -56,6 +56,7 @@ public:
   bool SupportsStereo(RENDER_STEREO_MODE mode) const override;
   void Project(float &x, float &y, float &z) override;
   bool SupportsNPOT(bool dxt) const override;
+  bool SupportsDXT() const override { return true; }
 
   // IDeviceNotify overrides
   void OnDXDeviceLost() override;
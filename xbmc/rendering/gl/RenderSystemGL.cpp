@@ -107,6 +107,8 @@ bool CRenderSystemGL::InitRenderSystem()
   else
     m_supportsNPOT = false;
 
+  m_supportsDXT = IsExtSupported("GL_EXT_texture_compression_s3tc");
+
   return true;
 }
 
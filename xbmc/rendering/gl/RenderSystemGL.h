@@ -59,6 +59,7 @@ public:
   void SetStereoMode(RENDER_STEREO_MODE mode, RENDER_STEREO_VIEW view) override;
   bool SupportsStereo(RENDER_STEREO_MODE mode) const override;
   bool SupportsNPOT(bool dxt) const override;
+  bool SupportsDXT() const override { return m_supportsDXT; }
 
   void Project(float &x, float &y, float &z) override;
 
@@ -90,6 +91,7 @@ protected:
   int m_width;
   int m_height;
   bool m_supportsNPOT = true;
+  bool m_supportsDXT = false;
 
   std::string m_RenderExtensions;
 
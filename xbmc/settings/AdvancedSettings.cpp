@@ -24,6 +24,7 @@
 #include "settings/lib/Setting.h"
 #include "settings/Settings.h"
 #include "settings/SettingUtils.h"
+#include "threads/LockProfiler.h"
 #include "utils/LangCodeExpander.h"
 #include "utils/log.h"
 #include "utils/StringUtils.h"
@@ -100,6 +101,8 @@ void CAdvancedSettings::Initialize()
   m_audioHeadRoom = 0;
   m_ac3Gain = 12.0f;
   m_audioApplyDrc = -1.0f;
+  m_audioPreDecodeFiles = 1;
+  m_audioPreDecodeMemory = 32768;
   m_VideoPlayerIgnoreDTSinWAV = false;
 
   //default hold time of 25 ms, this allows a 20 hertz sine to pass undistorted
@@ -165,6 +168,9 @@ void CAdvancedSettings::Initialize()
   m_slideshowPanAmount = 2.5f;
   m_slideshowZoomAmount = 5.0f;
   m_slideshowBlackBarCompensation = 20.0f;
+  m_slideshowPrefetch = 2;
+  m_slideshowCacheSize = 256;
+  m_slideshowCacheThreads = 2;
 
   m_songInfoDuration = 10;
 
@@ -174,6 +180,8 @@ void CAdvancedSettings::Initialize()
   m_handleMounting = g_application.IsStandAlone();
 
   m_fullScreenOnMovieStart = true;
+  m_videoExtractionJobs = 2;
+  m_videoExtractionJobsPerHost = 1;
   m_cachePath = "special://temp/";
 
   m_videoCleanDateTimeRegExp = "(.*[^ _\\,\\.\\(\\)\\[\\]\\-])[ _\\.\\(\\)\\[\\]\\-]+(19[0-9][0-9]|20[0-9][0-9])([ _\\,\\.\\(\\)\\[\\]\\-]|[^0-9]$)?";
@@ -252,6 +260,7 @@ void CAdvancedSettings::Initialize()
   m_fanartRes = 1080;
   m_imageRes = 720;
   m_imageScalingAlgorithm = CPictureScalingAlgorithm::Default;
+  m_useDDSTextures = false;
 
   m_sambaclienttimeout = 30;
   m_sambadoscodepage = "";
@@ -269,6 +278,7 @@ void CAdvancedSettings::Initialize()
   m_bMusicLibraryAllItemsOnBottom = false;
   m_bMusicLibraryCleanOnUpdate = false;
   m_bMusicLibraryArtistSortOnUpdate = false;
+  m_bMusicLibraryUseDirectorySnapshot = false;
   m_iMusicLibraryRecentlyAddedItems = 25;
   m_strMusicLibraryAlbumFormat = "";
   m_prioritiseAPEv2tags = false;
@@ -282,6 +292,7 @@ void CAdvancedSettings::Initialize()
   m_iVideoLibraryRecentlyAddedItems = 25;
   m_bVideoLibraryCleanOnUpdate = false;
   m_bVideoLibraryUseFastHash = true;
+  m_bVideoLibraryUseDirectorySnapshot = true;
   m_bVideoLibraryExportAutoThumbs = false;
   m_bVideoLibraryImportWatchedState = false;
   m_bVideoLibraryImportResumePoint = false;
@@ -368,12 +379,25 @@ void CAdvancedSettings::Initialize()
   m_guiVisualizeDirtyRegions = false;
   m_guiAlgorithmDirtyRegions = 3;
   m_guiSmartRedraw = false;
+  m_guiTextureUploadBudgetKB = 8192;
   m_airTunesPort = 36666;
   m_airPlayPort = 36667;
 
   m_databaseMusic.Reset();
   m_databaseVideo.Reset();
 
+  m_sqliteWALMode = true;
+  m_sqliteCacheSizeKB = 16384;
+  m_sqliteMmapSizeMB = 64;
+  m_sqliteConnectionPoolSize = 4;
+  m_databaseSlowQueryMs = 500;
+
+  m_pythonInterpreterPoolSize = 2;
+  m_pythonInterpreterIdleTime = 60;
+
+  m_startupThreads = 1;
+  m_lockProfiler = false;
+
   m_pictureExtensions = ".png|.jpg|.jpeg|.bmp|.gif|.ico|.tif|.tiff|.tga|.pcx|.cbz|.zip|.rss|.webp|.jp2|.apng";
   m_musicExtensions = ".nsv|.m4a|.flac|.aac|.strm|.pls|.rm|.rma|.mpa|.wav|.wma|.ogg|.mp3|.mp2|.m3u|.gdm|.imf|.m15|.sfx|.uni|.ac3|.dts|.cue|.aif|.aiff|.wpl|.ape|.mac|.mpc|.mp+|.mpp|.shn|.zip|.wv|.dsp|.xsp|.xwav|.waa|.wvs|.wam|.gcm|.idsp|.mpdsp|.mss|.spt|.rsd|.sap|.cmc|.cmr|.dmc|.mpt|.mpd|.rmt|.tmc|.tm8|.tm2|.oga|.url|.pxml|.tta|.rss|.wtv|.mka|.tak|.opus|.dff|.dsf|.m4b";
   m_videoExtensions = ".m4v|.3g2|.3gp|.nsv|.tp|.ts|.ty|.strm|.pls|.rm|.rmvb|.mpd|.m3u|.m3u8|.ifo|.mov|.qt|.divx|.xvid|.bivx|.vob|.nrg|.img|.iso|.udf|.pva|.wmv|.asf|.asx|.ogm|.m2v|.avi|.bin|.dat|.mpg|.mpeg|.mp4|.mkv|.mk3d|.avc|.vp3|.svq3|.nuv|.viv|.dv|.fli|.flv|.001|.wpl|.zip|.vdr|.dvr-ms|.xsp|.mts|.m2t|.m2ts|.evo|.ogv|.sdp|.avs|.rec|.url|.pxml|.vc1|.h264|.rcv|.rss|.mpls|.webm|.bdmv|.wtv|.trp|.f4v";
@@ -517,6 +541,8 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
       GetCustomRegexps(pAudioExcludes, m_audioExcludeFromScanRegExps);
 
     XMLUtils::GetFloat(pElement, "applydrc", m_audioApplyDrc);
+    XMLUtils::GetUInt(pElement, "predecodefiles", m_audioPreDecodeFiles, 0, 8);
+    XMLUtils::GetUInt(pElement, "predecodememory", m_audioPreDecodeMemory, 0, 524288);
     XMLUtils::GetBoolean(pElement, "VideoPlayerignoredtsinwav", m_VideoPlayerIgnoreDTSinWAV);
 
     XMLUtils::GetFloat(pElement, "limiterhold", m_limiterHold, 0.0f, 100.0f);
@@ -540,6 +566,8 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetFloat(pElement, "audiodelayrange", m_videoAudioDelayRange, 10, 600);
     XMLUtils::GetString(pElement, "defaultplayer", m_videoDefaultPlayer);
     XMLUtils::GetBoolean(pElement, "fullscreenonmoviestart", m_fullScreenOnMovieStart);
+    XMLUtils::GetUInt(pElement, "extractionjobs", m_videoExtractionJobs, 1, 16);
+    XMLUtils::GetUInt(pElement, "extractionjobsperhost", m_videoExtractionJobsPerHost, 1, 16);
     // 101 on purpose - can be used to never automark as watched
     XMLUtils::GetFloat(pElement, "playcountminimumpercent", m_videoPlayCountMinimumPercent, 0.0f, 101.0f);
     XMLUtils::GetInt(pElement, "ignoresecondsatstart", m_videoIgnoreSecondsAtStart, 0, 900);
@@ -727,6 +755,7 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetBoolean(pElement, "allitemsonbottom", m_bMusicLibraryAllItemsOnBottom);
     XMLUtils::GetBoolean(pElement, "cleanonupdate", m_bMusicLibraryCleanOnUpdate);
     XMLUtils::GetBoolean(pElement, "artistsortonupdate", m_bMusicLibraryArtistSortOnUpdate);
+    XMLUtils::GetBoolean(pElement, "usedirectorysnapshot", m_bMusicLibraryUseDirectorySnapshot);
     XMLUtils::GetBoolean(pElement, "useartistsortname", m_musicUseArtistSortName);
     XMLUtils::GetString(pElement, "albumformat", m_strMusicLibraryAlbumFormat);
     XMLUtils::GetString(pElement, "itemseparator", m_musicItemSeparator);
@@ -779,6 +808,7 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetInt(pElement, "recentlyaddeditems", m_iVideoLibraryRecentlyAddedItems, 1, INT_MAX);
     XMLUtils::GetBoolean(pElement, "cleanonupdate", m_bVideoLibraryCleanOnUpdate);
     XMLUtils::GetBoolean(pElement, "usefasthash", m_bVideoLibraryUseFastHash);
+    XMLUtils::GetBoolean(pElement, "usedirectorysnapshot", m_bVideoLibraryUseDirectorySnapshot);
     XMLUtils::GetString(pElement, "itemseparator", m_videoItemSeparator);
     XMLUtils::GetBoolean(pElement, "exportautothumbs", m_bVideoLibraryExportAutoThumbs);
     XMLUtils::GetBoolean(pElement, "importwatchedstate", m_bVideoLibraryImportWatchedState);
@@ -804,6 +834,16 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetFloat(pElement, "panamount", m_slideshowPanAmount, 0.0f, 20.0f);
     XMLUtils::GetFloat(pElement, "zoomamount", m_slideshowZoomAmount, 0.0f, 20.0f);
     XMLUtils::GetFloat(pElement, "blackbarcompensation", m_slideshowBlackBarCompensation, 0.0f, 50.0f);
+    XMLUtils::GetInt(pElement, "prefetch", m_slideshowPrefetch, 0, 16);
+    XMLUtils::GetInt(pElement, "cachesize", m_slideshowCacheSize, 16, 4096);
+    XMLUtils::GetInt(pElement, "cachethreads", m_slideshowCacheThreads, 1, 8);
+  }
+
+  pElement = pRootElement->FirstChildElement("python");
+  if (pElement)
+  {
+    XMLUtils::GetInt(pElement, "interpreterpool", m_pythonInterpreterPoolSize, 0, 16);
+    XMLUtils::GetInt(pElement, "interpreteridletime", m_pythonInterpreterIdleTime, 1, 3600);
   }
 
   pElement = pRootElement->FirstChildElement("network");
@@ -883,6 +923,9 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
   XMLUtils::GetInt(pRootElement, "songinfoduration", m_songInfoDuration, 0, INT_MAX);
   XMLUtils::GetInt(pRootElement, "playlistretries", m_playlistRetries, -1, 5000);
   XMLUtils::GetInt(pRootElement, "playlisttimeout", m_playlistTimeout, 0, 5000);
+  XMLUtils::GetInt(pRootElement, "startupthreads", m_startupThreads, 1, 16);
+  if (XMLUtils::GetBoolean(pRootElement, "lockprofiler", m_lockProfiler))
+    CLockProfiler::GetInstance().SetEnabled(m_lockProfiler);
 
   XMLUtils::GetBoolean(pRootElement,"glrectanglehack", m_GLRectangleHack);
   XMLUtils::GetInt(pRootElement,"skiploopfilter", m_iSkipLoopFilter, -16, 48);
@@ -1041,6 +1084,7 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
   XMLUtils::GetUInt(pRootElement, "imageres", m_imageRes, 0, 9999);
   if (XMLUtils::GetString(pRootElement, "imagescalingalgorithm", tmp))
     m_imageScalingAlgorithm = CPictureScalingAlgorithm::FromString(tmp);
+  XMLUtils::GetBoolean(pRootElement, "useddstextures", m_useDDSTextures);
   XMLUtils::GetBoolean(pRootElement, "playlistasfolders", m_playlistAsFolders);
   XMLUtils::GetBoolean(pRootElement, "detectasudf", m_detectAsUdf);
 
@@ -1169,6 +1213,16 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetBoolean(pDatabase, "compression", m_databaseEpg.compression);
   }
 
+  pDatabase = pRootElement->FirstChildElement("sqlite");
+  if (pDatabase)
+  {
+    XMLUtils::GetBoolean(pDatabase, "walmode", m_sqliteWALMode);
+    XMLUtils::GetInt(pDatabase, "cachesize", m_sqliteCacheSizeKB, 1024, 1024 * 1024);
+    XMLUtils::GetInt(pDatabase, "mmapsize", m_sqliteMmapSizeMB, 0, 4096);
+    XMLUtils::GetInt(pDatabase, "connectionpool", m_sqliteConnectionPoolSize, 0, 64);
+    XMLUtils::GetInt(pDatabase, "slowquerytime", m_databaseSlowQueryMs, 0, 3600000);
+  }
+
   pDatabase = pRootElement->FirstChildElement("savestatedatabase");
   if (pDatabase)
   {
@@ -1198,6 +1252,7 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetBoolean(pElement, "visualizedirtyregions", m_guiVisualizeDirtyRegions);
     XMLUtils::GetInt(pElement, "algorithmdirtyregions",     m_guiAlgorithmDirtyRegions);
     XMLUtils::GetBoolean(pElement, "smartredraw", m_guiSmartRedraw);
+    XMLUtils::GetInt(pElement, "textureuploadbudget", m_guiTextureUploadBudgetKB, 0, 1024 * 1024);
   }
 
   std::string seekSteps;
@@ -162,6 +162,8 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     int m_videoIgnoreSecondsAtStart;
     float m_videoIgnorePercentAtEnd;
     float m_audioApplyDrc;
+    unsigned int m_audioPreDecodeFiles;    ///< \brief number of upcoming playlist items PAPlayer opens and decodes ahead
+    unsigned int m_audioPreDecodeMemory;   ///< \brief memory in KB shared by the decode buffers of these items
     bool m_useFfmpegVda;
 
     int   m_videoVDPAUScaling;
@@ -188,6 +190,9 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     float m_slideshowBlackBarCompensation;
     float m_slideshowZoomAmount;
     float m_slideshowPanAmount;
+    int m_slideshowPrefetch; /*!< @brief number of pictures decoded ahead of the current one, 0 disables the cache */
+    int m_slideshowCacheSize; /*!< @brief memory budget of the slideshow cache in MB */
+    int m_slideshowCacheThreads; /*!< @brief number of pictures decoded at once by the slideshow cache */
 
     int m_songInfoDuration;
     int m_logLevel;
@@ -204,6 +209,8 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     bool m_handleMounting;
 
     bool m_fullScreenOnMovieStart;
+    unsigned int m_videoExtractionJobs;         ///< \brief number of video files thumbs and stream details are extracted from at once
+    unsigned int m_videoExtractionJobsPerHost;  ///< \brief limit of the above for the files of one remote host
     std::string m_cachePath;
     std::string m_videoCleanDateTimeRegExp;
     std::vector<std::string> m_videoCleanStringRegExps;
@@ -231,6 +238,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     unsigned int m_fanartRes; ///< \brief the maximal resolution to cache fanart at (assumes 16x9)
     unsigned int m_imageRes;  ///< \brief the maximal resolution to cache images at (assumes 16x9)
     CPictureScalingAlgorithm::Algorithm m_imageScalingAlgorithm;
+    bool m_useDDSTextures; ///< \brief load cached images from compressed .dds versions, created in the background
 
     int m_sambaclienttimeout;
     std::string m_sambadoscodepage;
@@ -250,6 +258,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     bool m_bMusicLibraryAllItemsOnBottom;
     bool m_bMusicLibraryCleanOnUpdate;
     bool m_bMusicLibraryArtistSortOnUpdate;
+    bool m_bMusicLibraryUseDirectorySnapshot;
     std::string m_strMusicLibraryAlbumFormat;
     bool m_prioritiseAPEv2tags;
     std::string m_musicItemSeparator;
@@ -262,6 +271,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     int m_iVideoLibraryRecentlyAddedItems;
     bool m_bVideoLibraryCleanOnUpdate;
     bool m_bVideoLibraryUseFastHash;
+    bool m_bVideoLibraryUseDirectorySnapshot;
     bool m_bVideoLibraryExportAutoThumbs;
     bool m_bVideoLibraryImportWatchedState;
     bool m_bVideoLibraryImportResumePoint;
@@ -331,10 +341,20 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     DatabaseSettings m_databaseTV;    // advanced tv database setup
     DatabaseSettings m_databaseEpg;   /*!< advanced EPG database setup */
     DatabaseSettings m_databaseSavestates; /*!< advanced savestate database setup */
+    bool m_sqliteWALMode; /*!< @brief use write-ahead logging, so that readers don't block on writers */
+    int m_sqliteCacheSizeKB; /*!< @brief page cache size per sqlite connection in KiB */
+    int m_sqliteMmapSizeMB; /*!< @brief maximum size of the memory mapped part of a sqlite database in MiB */
+    int m_sqliteConnectionPoolSize; /*!< @brief idle sqlite connections kept open per database for reuse */
+    int m_databaseSlowQueryMs; /*!< @brief log database statements taking longer than this (ms), 0 to disable */
+    int m_pythonInterpreterPoolSize; /*!< @brief plugin interpreters kept for reuse, 0 to disable */
+    int m_pythonInterpreterIdleTime; /*!< @brief seconds an unused plugin interpreter is kept */
+    int m_startupThreads; /*!< @brief services initialized concurrently at startup, 1 for sequential initialization */
+    bool m_lockProfiler; /*!< @brief record the contention of tagged locks, see CLockProfiler */
 
     bool m_guiVisualizeDirtyRegions;
     int  m_guiAlgorithmDirtyRegions;
     bool m_guiSmartRedraw;
+    int m_guiTextureUploadBudgetKB; /*!< @brief texture data uploaded to the GPU per frame in KiB, 0 for no limit */
     unsigned int m_addonPackageFolderSize;
 
     unsigned int m_cacheMemSize;
@@ -236,6 +236,46 @@ bool CSettingsBase::SetString(const std::string& id, const std::string& value)
   return m_settingsManager->SetString(id, value);
 }
 
+SettingHandleBool CSettingsBase::GetBoolHandle(const std::string& id)
+{
+  return m_settingsManager->GetBoolHandle(id);
+}
+
+bool CSettingsBase::GetBool(const SettingHandleBool& handle) const
+{
+  return m_settingsManager->GetBool(handle);
+}
+
+SettingHandleInt CSettingsBase::GetIntHandle(const std::string& id)
+{
+  return m_settingsManager->GetIntHandle(id);
+}
+
+int CSettingsBase::GetInt(const SettingHandleInt& handle) const
+{
+  return m_settingsManager->GetInt(handle);
+}
+
+SettingHandleNumber CSettingsBase::GetNumberHandle(const std::string& id)
+{
+  return m_settingsManager->GetNumberHandle(id);
+}
+
+double CSettingsBase::GetNumber(const SettingHandleNumber& handle) const
+{
+  return m_settingsManager->GetNumber(handle);
+}
+
+SettingHandleString CSettingsBase::GetStringHandle(const std::string& id)
+{
+  return m_settingsManager->GetStringHandle(id);
+}
+
+std::string CSettingsBase::GetString(const SettingHandleString& handle) const
+{
+  return m_settingsManager->GetString(handle);
+}
+
 std::vector<CVariant> CSettingsBase::GetList(const std::string& id) const
 {
   std::shared_ptr<CSetting> setting = m_settingsManager->GetSetting(id);
@@ -13,6 +13,7 @@
 #include <vector>
 
 #include "settings/lib/ISettingCallback.h"
+#include "settings/lib/SettingHandle.h"
 #include "threads/CriticalSection.h"
 
 class CSetting;
@@ -165,6 +166,67 @@ public:
    */
   std::vector<CVariant> GetList(const std::string& id) const;
 
+  /*!
+   \brief Gets a handle of the boolean setting with the given identifier.
+
+   Reading the value through the handle neither looks up the setting nor
+   takes any lock, so handles should be used for settings read frequently.
+
+   \param id Setting identifier
+   \return Handle of the setting, invalid if there is no boolean setting with the given identifier
+   */
+  SettingHandleBool GetBoolHandle(const std::string& id);
+  /*!
+   \brief Gets a handle of the integer setting with the given identifier.
+
+   \param id Setting identifier
+   \return Handle of the setting, invalid if there is no integer setting with the given identifier
+   */
+  SettingHandleInt GetIntHandle(const std::string& id);
+  /*!
+   \brief Gets a handle of the real number setting with the given identifier.
+
+   \param id Setting identifier
+   \return Handle of the setting, invalid if there is no real number setting with the given identifier
+   */
+  SettingHandleNumber GetNumberHandle(const std::string& id);
+  /*!
+   \brief Gets a handle of the string setting with the given identifier.
+
+   \param id Setting identifier
+   \return Handle of the setting, invalid if there is no string setting with the given identifier
+   */
+  SettingHandleString GetStringHandle(const std::string& id);
+
+  /*!
+   \brief Gets the boolean value of the setting with the given handle.
+
+   \param handle Setting handle
+   \return Boolean value of the setting with the given handle
+   */
+  bool GetBool(const SettingHandleBool& handle) const;
+  /*!
+   \brief Gets the integer value of the setting with the given handle.
+
+   \param handle Setting handle
+   \return Integer value of the setting with the given handle
+   */
+  int GetInt(const SettingHandleInt& handle) const;
+  /*!
+   \brief Gets the real number value of the setting with the given handle.
+
+   \param handle Setting handle
+   \return Real number value of the setting with the given handle
+   */
+  double GetNumber(const SettingHandleNumber& handle) const;
+  /*!
+   \brief Gets the string value of the setting with the given handle.
+
+   \param handle Setting handle
+   \return String value of the setting with the given handle
+   */
+  std::string GetString(const SettingHandleString& handle) const;
+
   /*!
    \brief Sets the boolean value of the setting with the given identifier.
 
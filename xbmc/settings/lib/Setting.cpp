@@ -244,6 +244,30 @@ void CSetting::Copy(const CSetting &setting)
   m_changed = setting.m_changed;
 }
 
+void CSetting::UpdateValueSlot(bool value) const
+{
+  if (m_valueSlot >= 0 && m_settingsManager != nullptr)
+    m_settingsManager->UpdateValueSlot(m_valueSlot, value);
+}
+
+void CSetting::UpdateValueSlot(int value) const
+{
+  if (m_valueSlot >= 0 && m_settingsManager != nullptr)
+    m_settingsManager->UpdateValueSlot(m_valueSlot, value);
+}
+
+void CSetting::UpdateValueSlot(double value) const
+{
+  if (m_valueSlot >= 0 && m_settingsManager != nullptr)
+    m_settingsManager->UpdateValueSlot(m_valueSlot, value);
+}
+
+void CSetting::UpdateValueSlot(const std::string &value) const
+{
+  if (m_valueSlot >= 0 && m_settingsManager != nullptr)
+    m_settingsManager->UpdateValueSlot(m_valueSlot, value);
+}
+
 CSettingReference::CSettingReference(const std::string &id, CSettingsManager *settingsManager /* = nullptr */)
   : CSetting("#" + id, settingsManager)
   , m_referencedId(id)
@@ -582,7 +606,10 @@ bool CSettingBool::Deserialize(const TiXmlNode *node, bool update /* = false */)
   // get the default value
   bool value;
   if (XMLUtils::GetBoolean(node, SETTING_XML_ELM_DEFAULT, value))
+  {
     m_value = m_default = value;
+    UpdateValueSlot(m_value);
+  }
   else if (!update)
   {
     CLog::Log(LOGERROR, "CSettingBool: error reading the default value of \"%s\"", m_id.c_str());
@@ -641,6 +668,7 @@ bool CSettingBool::SetValue(bool value)
   }
 
   m_changed = m_value != m_default;
+  UpdateValueSlot(m_value);
   OnSettingChanged(shared_from_base<CSettingBool>());
   return true;
 }
@@ -651,7 +679,18 @@ void CSettingBool::SetDefault(bool value)
 
   m_default = value;
   if (!m_changed)
+  {
     m_value = m_default;
+    UpdateValueSlot(m_value);
+  }
+}
+
+void CSettingBool::SetValueSlot(int slot)
+{
+  CExclusiveLock lock(m_critical);
+
+  m_valueSlot = slot;
+  UpdateValueSlot(m_value);
 }
 
 void CSettingBool::copy(const CSettingBool &setting)
@@ -731,7 +770,10 @@ bool CSettingInt::Deserialize(const TiXmlNode *node, bool update /* = false */)
   // get the default value
   int value;
   if (XMLUtils::GetInt(node, SETTING_XML_ELM_DEFAULT, value))
+  {
     m_value = m_default = value;
+    UpdateValueSlot(m_value);
+  }
   else if (!update)
   {
     CLog::Log(LOGERROR, "CSettingInt: error reading the default value of \"%s\"", m_id.c_str());
@@ -859,6 +901,7 @@ bool CSettingInt::SetValue(int value)
   }
 
   m_changed = m_value != m_default;
+  UpdateValueSlot(m_value);
   OnSettingChanged(shared_from_base<CSettingInt>());
   return true;
 }
@@ -869,7 +912,18 @@ void CSettingInt::SetDefault(int value)
 
   m_default = value;
   if (!m_changed)
+  {
     m_value = m_default;
+    UpdateValueSlot(m_value);
+  }
+}
+
+void CSettingInt::SetValueSlot(int slot)
+{
+  CExclusiveLock lock(m_critical);
+
+  m_valueSlot = slot;
+  UpdateValueSlot(m_value);
 }
 
 SettingOptionsType CSettingInt::GetOptionsType() const
@@ -1008,7 +1062,10 @@ bool CSettingNumber::Deserialize(const TiXmlNode *node, bool update /* = false *
   // get the default value
   double value;
   if (XMLUtils::GetDouble(node, SETTING_XML_ELM_DEFAULT, value))
+  {
     m_value = m_default = value;
+    UpdateValueSlot(m_value);
+  }
   else if (!update)
   {
     CLog::Log(LOGERROR, "CSettingNumber: error reading the default value of \"%s\"", m_id.c_str());
@@ -1098,6 +1155,7 @@ bool CSettingNumber::SetValue(double value)
   }
 
   m_changed = m_value != m_default;
+  UpdateValueSlot(m_value);
   OnSettingChanged(shared_from_base<CSettingNumber>());
   return true;
 }
@@ -1108,7 +1166,18 @@ void CSettingNumber::SetDefault(double value)
 
   m_default = value;
   if (!m_changed)
+  {
     m_value = m_default;
+    UpdateValueSlot(m_value);
+  }
+}
+
+void CSettingNumber::SetValueSlot(int slot)
+{
+  CExclusiveLock lock(m_critical);
+
+  m_valueSlot = slot;
+  UpdateValueSlot(m_value);
 }
 
 void CSettingNumber::copy(const CSettingNumber &setting)
@@ -1207,7 +1276,10 @@ bool CSettingString::Deserialize(const TiXmlNode *node, bool update /* = false *
   std::string value;
   if (XMLUtils::GetString(node, SETTING_XML_ELM_DEFAULT, value) &&
      (!value.empty() || m_allowEmpty))
+  {
     m_value = m_default = value;
+    UpdateValueSlot(m_value);
+  }
   else if (!update && !m_allowEmpty)
   {
     CLog::Log(LOGERROR, "CSettingString: error reading the default value of \"%s\"", m_id.c_str());
@@ -1263,6 +1335,7 @@ bool CSettingString::SetValue(const std::string &value)
   }
 
   m_changed = m_value != m_default;
+  UpdateValueSlot(m_value);
   OnSettingChanged(shared_from_base<CSettingString>());
   return true;
 }
@@ -1273,7 +1346,18 @@ void CSettingString::SetDefault(const std::string &value)
 
   m_default = value;
   if (!m_changed)
+  {
     m_value = m_default;
+    UpdateValueSlot(m_value);
+  }
+}
+
+void CSettingString::SetValueSlot(int slot)
+{
+  CExclusiveLock lock(m_critical);
+
+  m_valueSlot = slot;
+  UpdateValueSlot(m_value);
 }
 
 SettingOptionsType CSettingString::GetOptionsType() const
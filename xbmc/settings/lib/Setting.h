@@ -76,6 +76,17 @@ public:
 
   void SetCallback(ISettingCallback *callback) { m_callback = callback; }
 
+  /*!
+   \brief Mirrors the value of the setting into the given value slot of the
+   settings manager, see CSettingsManager::GetIntHandle() and the like.
+
+   Only supported by boolean, integer, number and string settings.
+
+   \param slot Index of the value slot or -1 to stop mirroring the value
+   */
+  virtual void SetValueSlot(int slot) { m_valueSlot = slot; }
+  int GetValueSlot() const { return m_valueSlot; }
+
   // overrides of ISetting
   bool IsVisible() const override;
 
@@ -91,6 +102,11 @@ protected:
 
   void Copy(const CSetting &setting);
 
+  void UpdateValueSlot(bool value) const;
+  void UpdateValueSlot(int value) const;
+  void UpdateValueSlot(double value) const;
+  void UpdateValueSlot(const std::string &value) const;
+
   template<class TSetting>
   std::shared_ptr<TSetting> shared_from_base()
   {
@@ -105,6 +121,7 @@ protected:
   SettingDependencies m_dependencies;
   std::set<CSettingUpdate> m_updates;
   bool m_changed = false;
+  int m_valueSlot = -1;
   mutable CSharedSection m_critical;
 };
 
@@ -237,6 +254,7 @@ public:
   bool SetValue(bool value);
   bool GetDefault() const { return m_default; }
   void SetDefault(bool value);
+  void SetValueSlot(int slot) override;
 
 private:
   void copy(const CSettingBool &setting);
@@ -276,6 +294,7 @@ public:
   bool SetValue(int value);
   int GetDefault() const { return m_default; }
   void SetDefault(int value);
+  void SetValueSlot(int slot) override;
 
   int GetMinimum() const { return m_min; }
   void SetMinimum(int minimum) { m_min = minimum; }
@@ -348,6 +367,7 @@ public:
   bool SetValue(double value);
   double GetDefault() const { return m_default; }
   void SetDefault(double value);
+  void SetValueSlot(int slot) override;
 
   double GetMinimum() const { return m_min; }
   void SetMinimum(double minimum) { m_min = minimum; }
@@ -394,6 +414,7 @@ public:
   virtual bool SetValue(const std::string &value);
   virtual const std::string& GetDefault() const { return m_default; }
   virtual void SetDefault(const std::string &value);
+  void SetValueSlot(int slot) override;
 
   virtual bool AllowEmpty() const { return m_allowEmpty; }
   void SetAllowEmpty(bool allowEmpty) { m_allowEmpty = allowEmpty; }
@@ -0,0 +1,55 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <string>
+
+class CSettingBool;
+class CSettingInt;
+class CSettingNumber;
+class CSettingString;
+class CSettingsManager;
+
+/*!
+ \ingroup settings
+ \brief Handle of a setting of the given type for frequent reads of its value.
+
+ A handle is resolved once by CSettingsManager and refers to a slot in which
+ the manager keeps a copy of the current value of the setting. Reading the
+ value through the handle neither looks up the setting by its identifier nor
+ takes any lock. Callbacks of the setting are not affected by handles.
+
+ If no slot is available (or the settings have been cleared) reading the value
+ falls back to looking up the setting by its identifier.
+ */
+template<class TSetting>
+class CSettingHandle
+{
+public:
+  CSettingHandle() = default;
+
+  const std::string& GetId() const { return m_id; }
+  bool IsValid() const { return !m_id.empty(); }
+
+private:
+  friend class CSettingsManager;
+
+  CSettingHandle(const std::string &id, int slot)
+    : m_id(id),
+      m_slot(slot)
+  { }
+
+  std::string m_id;
+  int m_slot = -1;
+};
+
+using SettingHandleBool = CSettingHandle<CSettingBool>;
+using SettingHandleInt = CSettingHandle<CSettingInt>;
+using SettingHandleNumber = CSettingHandle<CSettingNumber>;
+using SettingHandleString = CSettingHandle<CSettingString>;
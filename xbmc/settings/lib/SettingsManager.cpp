@@ -9,6 +9,7 @@
 #include "SettingsManager.h"
 
 #include <algorithm>
+#include <cstring>
 #include <utility>
 
 #include "SettingDefinitions.h"
@@ -16,6 +17,7 @@
 #include "Setting.h"
 #include "utils/log.h"
 #include "utils/StringUtils.h"
+#include "threads/SingleLock.h"
 #include "utils/XBMCTinyXML.h"
 
 const uint32_t CSettingsManager::Version = 2;
@@ -224,6 +226,7 @@ void CSettingsManager::Clear()
   CExclusiveLock lock(m_critical);
   Unload();
 
+  ReleaseValueSlots();
   m_settings.clear();
   m_sections.clear();
 
@@ -682,6 +685,83 @@ bool CSettingsManager::SetString(const std::string &id, const std::string &value
   return std::static_pointer_cast<CSettingString>(setting)->SetValue(value);
 }
 
+SettingHandleBool CSettingsManager::GetBoolHandle(const std::string &id)
+{
+  int slot;
+  if (!AcquireValueSlot(id, SettingType::Boolean, slot))
+    return SettingHandleBool();
+
+  return SettingHandleBool(id, slot);
+}
+
+SettingHandleInt CSettingsManager::GetIntHandle(const std::string &id)
+{
+  int slot;
+  if (!AcquireValueSlot(id, SettingType::Integer, slot))
+    return SettingHandleInt();
+
+  return SettingHandleInt(id, slot);
+}
+
+SettingHandleNumber CSettingsManager::GetNumberHandle(const std::string &id)
+{
+  int slot;
+  if (!AcquireValueSlot(id, SettingType::Number, slot))
+    return SettingHandleNumber();
+
+  return SettingHandleNumber(id, slot);
+}
+
+SettingHandleString CSettingsManager::GetStringHandle(const std::string &id)
+{
+  int slot;
+  if (!AcquireValueSlot(id, SettingType::String, slot))
+    return SettingHandleString();
+
+  return SettingHandleString(id, slot);
+}
+
+bool CSettingsManager::GetBool(const SettingHandleBool &handle) const
+{
+  if (handle.m_slot >= 0 && m_valueSlots[handle.m_slot].valid)
+    return m_valueSlots[handle.m_slot].value.load(std::memory_order_relaxed) != 0;
+
+  return GetBool(handle.m_id);
+}
+
+int CSettingsManager::GetInt(const SettingHandleInt &handle) const
+{
+  if (handle.m_slot >= 0 && m_valueSlots[handle.m_slot].valid)
+    return static_cast<int>(m_valueSlots[handle.m_slot].value.load(std::memory_order_relaxed));
+
+  return GetInt(handle.m_id);
+}
+
+double CSettingsManager::GetNumber(const SettingHandleNumber &handle) const
+{
+  if (handle.m_slot >= 0 && m_valueSlots[handle.m_slot].valid)
+  {
+    int64_t bits = m_valueSlots[handle.m_slot].value.load(std::memory_order_relaxed);
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+
+  return GetNumber(handle.m_id);
+}
+
+std::string CSettingsManager::GetString(const SettingHandleString &handle) const
+{
+  if (handle.m_slot >= 0 && m_valueSlots[handle.m_slot].valid)
+  {
+    auto value = std::atomic_load(&m_valueSlots[handle.m_slot].string);
+    if (value != nullptr)
+      return *value;
+  }
+
+  return GetString(handle.m_id);
+}
+
 std::vector< std::shared_ptr<CSetting> > CSettingsManager::GetList(const std::string &id) const
 {
   CSharedLock lock(m_settingsCritical);
@@ -1333,6 +1413,74 @@ void CSettingsManager::ResolveSettingDependencies(const Setting& setting)
   }
 }
 
+bool CSettingsManager::AcquireValueSlot(const std::string &id, SettingType type, int &slot)
+{
+  SettingPtr setting = GetSetting(id);
+  if (setting == nullptr || setting->GetType() != type)
+    return false;
+
+  // the lock of the setting is taken while holding m_valueSlotsCritical, so
+  // m_settingsCritical must not be held here
+  CSingleLock lock(m_valueSlotsCritical);
+  slot = setting->GetValueSlot();
+  if (slot >= 0)
+    return true;
+
+  if (m_valueSlotCount >= MaxValueSlots)
+  {
+    CLog::Log(LOGDEBUG, "CSettingsManager: no value slot left for setting (%s)", id.c_str());
+    return true;
+  }
+
+  if (m_valueSlots == nullptr)
+    m_valueSlots.reset(new ValueSlot[MaxValueSlots]);
+
+  slot = m_valueSlotCount++;
+  setting->SetValueSlot(slot);
+  m_valueSlots[slot].valid = true;
+  return true;
+}
+
+void CSettingsManager::ReleaseValueSlots()
+{
+  CSingleLock lock(m_valueSlotsCritical);
+  if (m_valueSlots == nullptr)
+    return;
+
+  // handles fall back to looking up their setting from now on
+  for (auto& setting : m_settings)
+  {
+    int slot = setting.second.setting->GetValueSlot();
+    if (slot < 0)
+      continue;
+
+    m_valueSlots[slot].valid = false;
+    setting.second.setting->SetValueSlot(-1);
+  }
+}
+
+void CSettingsManager::UpdateValueSlot(int slot, bool value)
+{
+  m_valueSlots[slot].value.store(value ? 1 : 0, std::memory_order_relaxed);
+}
+
+void CSettingsManager::UpdateValueSlot(int slot, int value)
+{
+  m_valueSlots[slot].value.store(value, std::memory_order_relaxed);
+}
+
+void CSettingsManager::UpdateValueSlot(int slot, double value)
+{
+  int64_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  m_valueSlots[slot].value.store(bits, std::memory_order_relaxed);
+}
+
+void CSettingsManager::UpdateValueSlot(int slot, const std::string &value)
+{
+  std::atomic_store(&m_valueSlots[slot].string, std::make_shared<const std::string>(value));
+}
+
 CSettingsManager::SettingMap::const_iterator CSettingsManager::FindSetting(std::string settingId) const
 {
   StringUtils::ToLower(settingId);
@@ -8,7 +8,9 @@
 
 #pragma once
 
+#include <atomic>
 #include <map>
+#include <memory>
 #include <set>
 #include <vector>
 
@@ -21,6 +23,8 @@
 #include "SettingConditions.h"
 #include "SettingDefinitions.h"
 #include "SettingDependency.h"
+#include "SettingHandle.h"
+#include "threads/CriticalSection.h"
 #include "threads/SharedSection.h"
 
 class CSettingCategory;
@@ -356,6 +360,67 @@ public:
    */
   std::vector< std::shared_ptr<CSetting> > GetList(const std::string &id) const;
 
+  /*!
+   \brief Gets a handle of the boolean setting with the given identifier.
+
+   Reading the value through the handle neither looks up the setting nor
+   takes any lock, so handles should be used for settings read frequently.
+
+   \param id Setting identifier
+   \return Handle of the setting, invalid if there is no boolean setting with the given identifier
+   */
+  SettingHandleBool GetBoolHandle(const std::string &id);
+  /*!
+   \brief Gets a handle of the integer setting with the given identifier.
+
+   \param id Setting identifier
+   \return Handle of the setting, invalid if there is no integer setting with the given identifier
+   */
+  SettingHandleInt GetIntHandle(const std::string &id);
+  /*!
+   \brief Gets a handle of the real number setting with the given identifier.
+
+   \param id Setting identifier
+   \return Handle of the setting, invalid if there is no real number setting with the given identifier
+   */
+  SettingHandleNumber GetNumberHandle(const std::string &id);
+  /*!
+   \brief Gets a handle of the string setting with the given identifier.
+
+   \param id Setting identifier
+   \return Handle of the setting, invalid if there is no string setting with the given identifier
+   */
+  SettingHandleString GetStringHandle(const std::string &id);
+
+  /*!
+   \brief Gets the boolean value of the setting with the given handle.
+
+   \param handle Setting handle
+   \return Boolean value of the setting with the given handle
+   */
+  bool GetBool(const SettingHandleBool &handle) const;
+  /*!
+   \brief Gets the integer value of the setting with the given handle.
+
+   \param handle Setting handle
+   \return Integer value of the setting with the given handle
+   */
+  int GetInt(const SettingHandleInt &handle) const;
+  /*!
+   \brief Gets the real number value of the setting with the given handle.
+
+   \param handle Setting handle
+   \return Real number value of the setting with the given handle
+   */
+  double GetNumber(const SettingHandleNumber &handle) const;
+  /*!
+   \brief Gets the string value of the setting with the given handle.
+
+   \param handle Setting handle
+   \return String value of the setting with the given handle
+   */
+  std::string GetString(const SettingHandleString &handle) const;
+
   /*!
    \brief Sets the boolean value of the setting with the given identifier.
 
@@ -492,6 +557,22 @@ private:
 
   void RegisterSettingOptionsFiller(const std::string &identifier, void *filler, SettingOptionsFillerType type);
 
+  // value slots of setting handles
+  friend class CSetting;
+
+  struct ValueSlot {
+    std::atomic<bool> valid{false};
+    std::atomic<int64_t> value{0}; //!< boolean, integer or the bits of a real number
+    std::shared_ptr<const std::string> string; //!< only accessed with std::atomic_load/store
+  };
+
+  bool AcquireValueSlot(const std::string &id, SettingType type, int &slot);
+  void ReleaseValueSlots();
+  void UpdateValueSlot(int slot, bool value);
+  void UpdateValueSlot(int slot, int value);
+  void UpdateValueSlot(int slot, double value);
+  void UpdateValueSlot(int slot, const std::string &value);
+
   using CallbackSet = std::set<ISettingCallback *>;
   struct Setting {
     std::shared_ptr<CSetting> setting;
@@ -535,6 +616,12 @@ private:
   using SettingOptionsFillerMap = std::map<std::string, SettingOptionsFiller>;
   SettingOptionsFillerMap m_optionsFillers;
 
-  mutable CSharedSection m_critical;
-  mutable CSharedSection m_settingsCritical;
+  // slots are never reused, so that a handle can't refer to a different setting
+  static const int MaxValueSlots = 512;
+  std::unique_ptr<ValueSlot[]> m_valueSlots;
+  int m_valueSlotCount = 0;
+  CCriticalSection m_valueSlotsCritical;
+
+  mutable CSharedSection m_critical{"CSettingsManager"};
+  mutable CSharedSection m_settingsCritical{"CSettingsManager/settings"};
 };
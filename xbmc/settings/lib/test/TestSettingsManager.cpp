@@ -0,0 +1,137 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "settings/lib/ISettingCallback.h"
+#include "settings/lib/Setting.h"
+#include "settings/lib/SettingSection.h"
+#include "settings/lib/SettingsManager.h"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <memory>
+
+namespace
+{
+class TestSettingsManager : public testing::Test
+{
+protected:
+  TestSettingsManager()
+  {
+    auto section = std::make_shared<CSettingSection>("section", &m_manager);
+    auto category = std::make_shared<CSettingCategory>("category", &m_manager);
+    auto group = std::make_shared<CSettingGroup>("group", &m_manager);
+
+    m_manager.AddSetting(std::make_shared<CSettingBool>("bool", 0, false, &m_manager), section, category, group);
+    m_manager.AddSetting(std::make_shared<CSettingInt>("int", 0, 1, &m_manager), section, category, group);
+    m_manager.AddSetting(std::make_shared<CSettingNumber>("number", 0, 1.5, &m_manager), section, category, group);
+    m_manager.AddSetting(std::make_shared<CSettingString>("string", 0, "value", &m_manager), section, category, group);
+    m_manager.SetInitialized();
+    m_manager.SetLoaded();
+  }
+
+  CSettingsManager m_manager;
+};
+
+class CChangedCallback : public ISettingCallback
+{
+public:
+  void OnSettingChanged(std::shared_ptr<const CSetting> setting) override
+  {
+    m_changed++;
+  }
+
+  int m_changed = 0;
+};
+}
+
+TEST_F(TestSettingsManager, Handles)
+{
+  EXPECT_TRUE(m_manager.GetBoolHandle("bool").IsValid());
+  EXPECT_TRUE(m_manager.GetIntHandle("int").IsValid());
+  EXPECT_TRUE(m_manager.GetNumberHandle("number").IsValid());
+  EXPECT_TRUE(m_manager.GetStringHandle("string").IsValid());
+
+  EXPECT_FALSE(m_manager.GetBoolHandle("unknown").IsValid());
+  EXPECT_FALSE(m_manager.GetIntHandle("bool").IsValid());
+  EXPECT_FALSE(m_manager.GetStringHandle("number").IsValid());
+}
+
+TEST_F(TestSettingsManager, HandleValues)
+{
+  auto boolHandle = m_manager.GetBoolHandle("bool");
+  auto intHandle = m_manager.GetIntHandle("int");
+  auto numberHandle = m_manager.GetNumberHandle("number");
+  auto stringHandle = m_manager.GetStringHandle("string");
+
+  EXPECT_FALSE(m_manager.GetBool(boolHandle));
+  EXPECT_EQ(1, m_manager.GetInt(intHandle));
+  EXPECT_DOUBLE_EQ(1.5, m_manager.GetNumber(numberHandle));
+  EXPECT_EQ("value", m_manager.GetString(stringHandle));
+
+  EXPECT_TRUE(m_manager.SetBool("bool", true));
+  EXPECT_TRUE(m_manager.SetInt("int", -5));
+  EXPECT_TRUE(m_manager.SetNumber("number", 2.25));
+  EXPECT_TRUE(m_manager.SetString("string", "other"));
+
+  EXPECT_TRUE(m_manager.GetBool(boolHandle));
+  EXPECT_EQ(-5, m_manager.GetInt(intHandle));
+  EXPECT_DOUBLE_EQ(2.25, m_manager.GetNumber(numberHandle));
+  EXPECT_EQ("other", m_manager.GetString(stringHandle));
+
+  // a second handle of the same setting shares its value
+  EXPECT_EQ(-5, m_manager.GetInt(m_manager.GetIntHandle("int")));
+
+  m_manager.GetSetting("int")->Reset();
+  EXPECT_EQ(1, m_manager.GetInt(intHandle));
+}
+
+TEST_F(TestSettingsManager, HandleCallbacks)
+{
+  CChangedCallback callback;
+  m_manager.RegisterCallback(&callback, { "int" });
+
+  auto handle = m_manager.GetIntHandle("int");
+  EXPECT_TRUE(m_manager.SetInt("int", 2));
+  EXPECT_EQ(1, callback.m_changed);
+  EXPECT_EQ(2, m_manager.GetInt(handle));
+
+  m_manager.UnregisterCallback(&callback);
+}
+
+TEST_F(TestSettingsManager, HandleAfterClear)
+{
+  auto handle = m_manager.GetIntHandle("int");
+  EXPECT_TRUE(m_manager.SetInt("int", 3));
+  EXPECT_EQ(3, m_manager.GetInt(handle));
+
+  // the handle falls back to the lookup by identifier
+  m_manager.Clear();
+  EXPECT_EQ(0, m_manager.GetInt(handle));
+}
+
+TEST_F(TestSettingsManager, HandleLookupSpeed)
+{
+  const int lookups = 1000000;
+  auto handle = m_manager.GetIntHandle("int");
+  int sum = 0;
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < lookups; i++)
+    sum += m_manager.GetInt("int");
+  std::chrono::duration<double> byId = std::chrono::steady_clock::now() - start;
+
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < lookups; i++)
+    sum += m_manager.GetInt(handle);
+  std::chrono::duration<double> byHandle = std::chrono::steady_clock::now() - start;
+
+  EXPECT_EQ(2 * lookups, sum);
+  RecordProperty("lookups_per_second_by_id", static_cast<int>(lookups / byId.count()));
+  RecordProperty("lookups_per_second_by_handle", static_cast<int>(lookups / byHandle.count()));
+}
@@ -0,0 +1,267 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "filesystem/File.h"
+#include "guilib/DDSImage.h"
+#include "guilib/XBTF.h"
+#include "test/TestUtils.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <stdint.h>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace
+{
+void FromRGB565(uint16_t value, int color[3])
+{
+  int r = (value >> 11) & 0x1f;
+  int g = (value >> 5) & 0x3f;
+  int b = value & 0x1f;
+  color[0] = (b << 3) | (b >> 2);
+  color[1] = (g << 2) | (g >> 4);
+  color[2] = (r << 3) | (r >> 2);
+}
+
+// decodes the colors of a DXT1/DXT5 block into 16 BGRA pixels
+void DecodeColorBlock(const unsigned char *src, bool dxt1, unsigned char pixels[16][4])
+{
+  uint16_t color0 = src[0] | (src[1] << 8);
+  uint16_t color1 = src[2] | (src[3] << 8);
+  uint32_t indices = src[4] | (src[5] << 8) | (src[6] << 16) | (static_cast<uint32_t>(src[7]) << 24);
+
+  int palette[4][4];
+  FromRGB565(color0, palette[0]);
+  FromRGB565(color1, palette[1]);
+  for (unsigned int i = 0; i < 4; i++)
+    palette[i][3] = 255;
+  for (unsigned int c = 0; c < 3; c++)
+  {
+    if (!dxt1 || color0 > color1)
+    {
+      palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+      palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+    }
+    else
+    {
+      palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+      palette[3][c] = 0;
+    }
+  }
+  if (dxt1 && color0 <= color1)
+    palette[3][3] = 0;
+
+  for (unsigned int i = 0; i < 16; i++)
+  {
+    for (unsigned int c = 0; c < 4; c++)
+      pixels[i][c] = palette[(indices >> (2 * i)) & 3][c];
+  }
+}
+
+// decodes the alpha values of a DXT5 block into 16 BGRA pixels
+void DecodeAlphaBlock(const unsigned char *src, unsigned char pixels[16][4])
+{
+  int palette[8] = { src[0], src[1] };
+  if (palette[0] > palette[1])
+  {
+    for (int i = 1; i < 7; i++)
+      palette[i + 1] = ((7 - i) * palette[0] + i * palette[1]) / 7;
+  }
+  else
+  {
+    for (int i = 1; i < 5; i++)
+      palette[i + 1] = ((5 - i) * palette[0] + i * palette[1]) / 5;
+    palette[6] = 0;
+    palette[7] = 255;
+  }
+
+  uint64_t indices = 0;
+  for (unsigned int i = 0; i < 6; i++)
+    indices |= static_cast<uint64_t>(src[2 + i]) << (8 * i);
+
+  for (unsigned int i = 0; i < 16; i++)
+    pixels[i][3] = palette[(indices >> (3 * i)) & 7];
+}
+
+// decodes one mipmap level into BGRA pixels
+std::vector<unsigned char> DecodeImage(const unsigned char *src, unsigned int width, unsigned int height, unsigned int format)
+{
+  std::vector<unsigned char> image(width * height * 4);
+  unsigned char block[16][4];
+  for (unsigned int y = 0; y < height; y += 4)
+  {
+    for (unsigned int x = 0; x < width; x += 4)
+    {
+      if (format == XB_FMT_DXT5)
+      {
+        DecodeColorBlock(src + 8, false, block);
+        DecodeAlphaBlock(src, block);
+        src += 16;
+      }
+      else
+      {
+        DecodeColorBlock(src, true, block);
+        src += 8;
+      }
+
+      for (unsigned int j = 0; j < 4 && y + j < height; j++)
+      {
+        for (unsigned int i = 0; i < 4 && x + i < width; i++)
+          std::copy(block[j * 4 + i], block[j * 4 + i] + 4, &image[((y + j) * width + x + i) * 4]);
+      }
+    }
+  }
+  return image;
+}
+
+unsigned int GetLevelSize(unsigned int width, unsigned int height, unsigned int format)
+{
+  return ((width + 3) / 4) * ((height + 3) / 4) * (format == XB_FMT_DXT5 ? 16 : 8);
+}
+
+// a smooth image, which DXT compresses well, with alpha fading out from left to right
+std::vector<unsigned char> CreateGradient(unsigned int width, unsigned int height)
+{
+  std::vector<unsigned char> image(width * height * 4);
+  for (unsigned int y = 0; y < height; y++)
+  {
+    for (unsigned int x = 0; x < width; x++)
+    {
+      unsigned char *pixel = &image[(y * width + x) * 4];
+      pixel[0] = 255 * x / width;
+      pixel[1] = 255 * y / height;
+      pixel[2] = 128;
+      pixel[3] = 255 - 255 * x / width;
+    }
+  }
+  return image;
+}
+
+class TestDDSImage : public testing::Test
+{
+protected:
+  TestDDSImage()
+  {
+    m_tempFile = XBMC_CREATETEMPFILE(".dds");
+    if (m_tempFile)
+    {
+      m_tempFile->Close();
+      m_tempPath = XBMC_TEMPFILEPATH(m_tempFile);
+    }
+  }
+
+  ~TestDDSImage() override
+  {
+    XBMC_DELETETEMPFILE(m_tempFile);
+  }
+
+  // compresses the image, reads it back and checks the layout of the mipmap chain
+  void CreateAndRead(unsigned int width, unsigned int height, const std::vector<unsigned char> &image, bool hasAlpha, unsigned int expectedMipmaps)
+  {
+    ASSERT_NE(nullptr, m_tempFile);
+    ASSERT_TRUE(CDDSImage().Create(m_tempPath, width, height, width * 4, image.data(), hasAlpha));
+    ASSERT_TRUE(m_dds.ReadFile(m_tempPath));
+
+    EXPECT_EQ(width, m_dds.GetWidth());
+    EXPECT_EQ(height, m_dds.GetHeight());
+    EXPECT_EQ(hasAlpha ? XB_FMT_DXT5 : XB_FMT_DXT1, m_dds.GetFormat());
+    ASSERT_EQ(expectedMipmaps, m_dds.GetMipmapCount());
+    EXPECT_EQ(GetLevelSize(width, height, m_dds.GetFormat()), m_dds.GetSize());
+
+    unsigned int dataSize = 0;
+    for (unsigned int level = 0; level < expectedMipmaps; level++)
+      dataSize += GetLevelSize(std::max(width >> level, 1U), std::max(height >> level, 1U), m_dds.GetFormat());
+    EXPECT_EQ(dataSize, m_dds.GetDataSize());
+  }
+
+  XFILE::CFile *m_tempFile;
+  std::string m_tempPath;
+  CDDSImage m_dds;
+};
+}
+
+TEST_F(TestDDSImage, RoundTripDXT1)
+{
+  const unsigned int width = 64;
+  const unsigned int height = 32;
+  std::vector<unsigned char> image = CreateGradient(width, height);
+  CreateAndRead(width, height, image, false, 7);
+  if (HasFatalFailure())
+    return;
+
+  std::vector<unsigned char> decoded = DecodeImage(m_dds.GetData(), width, height, m_dds.GetFormat());
+  int maxError = 0;
+  int totalError = 0;
+  for (unsigned int i = 0; i < width * height; i++)
+  {
+    for (unsigned int c = 0; c < 3; c++)
+    {
+      int error = std::abs(decoded[i * 4 + c] - image[i * 4 + c]);
+      maxError = std::max(maxError, error);
+      totalError += error;
+    }
+    EXPECT_EQ(255, decoded[i * 4 + 3]);
+  }
+  EXPECT_LE(maxError, 16);
+  EXPECT_LE(totalError / static_cast<int>(width * height * 3), 4);
+}
+
+TEST_F(TestDDSImage, RoundTripDXT5)
+{
+  // not a multiple of the block size
+  const unsigned int width = 30;
+  const unsigned int height = 18;
+  std::vector<unsigned char> image = CreateGradient(width, height);
+  CreateAndRead(width, height, image, true, 5);
+  if (HasFatalFailure())
+    return;
+
+  std::vector<unsigned char> decoded = DecodeImage(m_dds.GetData(), width, height, m_dds.GetFormat());
+  int maxError = 0;
+  int maxAlphaError = 0;
+  for (unsigned int i = 0; i < width * height; i++)
+  {
+    for (unsigned int c = 0; c < 3; c++)
+      maxError = std::max(maxError, std::abs(decoded[i * 4 + c] - image[i * 4 + c]));
+    maxAlphaError = std::max(maxAlphaError, std::abs(decoded[i * 4 + 3] - image[i * 4 + 3]));
+  }
+  // the gradient of the smaller image is steeper
+  EXPECT_LE(maxError, 24);
+  EXPECT_LE(maxAlphaError, 4);
+}
+
+TEST_F(TestDDSImage, MipmapLevels)
+{
+  // every level of a single colored image has the same color
+  const unsigned int width = 20;
+  const unsigned int height = 8;
+  const unsigned char color[4] = { 40, 160, 220, 100 };
+  std::vector<unsigned char> image(width * height * 4);
+  for (unsigned int i = 0; i < width * height; i++)
+    std::copy(color, color + 4, &image[i * 4]);
+  CreateAndRead(width, height, image, true, 5);
+  if (HasFatalFailure())
+    return;
+
+  const unsigned char *data = m_dds.GetData();
+  for (unsigned int level = 0; level < m_dds.GetMipmapCount(); level++)
+  {
+    unsigned int levelWidth = std::max(width >> level, 1U);
+    unsigned int levelHeight = std::max(height >> level, 1U);
+    std::vector<unsigned char> decoded = DecodeImage(data, levelWidth, levelHeight, m_dds.GetFormat());
+    for (unsigned int i = 0; i < levelWidth * levelHeight; i++)
+    {
+      for (unsigned int c = 0; c < 4; c++)
+        EXPECT_NEAR(color[c], decoded[i * 4 + c], 8) << "level " << level << " channel " << c;
+    }
+    data += GetLevelSize(levelWidth, levelHeight, m_dds.GetFormat());
+  }
+  EXPECT_EQ(m_dds.GetData() + m_dds.GetDataSize(), data);
+}
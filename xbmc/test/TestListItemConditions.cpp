@@ -0,0 +1,105 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "FileItem.h"
+#include "GUIInfoManager.h"
+#include "interfaces/info/InfoBool.h"
+#include "utils/Variant.h"
+
+#include "gtest/gtest.h"
+
+namespace
+{
+// evaluates to the folder flag of the item and counts its evaluations
+class CFolderInfoBool : public INFO::InfoBool
+{
+public:
+  explicit CFolderInfoBool(unsigned int &refreshCounter)
+    : InfoBool("listitem.isfolder", 0, refreshCounter)
+  {
+    m_listItemDependent = true;
+    m_listItemStatic = true;
+  }
+
+  void Update(const CGUIListItem *item) override
+  {
+    m_updates++;
+    m_value = item && item->m_bIsFolder;
+  }
+
+  int m_updates = 0;
+};
+}
+
+TEST(TestListItemConditions, IsListItemStatic)
+{
+  CGUIInfoManager infoMgr;
+  bool listItemDependent = false;
+
+  EXPECT_TRUE(infoMgr.IsListItemStatic(infoMgr.TranslateSingleString("listitem.isfolder", listItemDependent)));
+  EXPECT_TRUE(infoMgr.IsListItemStatic(infoMgr.TranslateSingleString("listitem.property(foo)", listItemDependent)));
+  EXPECT_TRUE(infoMgr.IsListItemStatic(infoMgr.TranslateSingleString("string.isempty(listitem.label)", listItemDependent)));
+  EXPECT_TRUE(infoMgr.IsListItemStatic(-infoMgr.TranslateSingleString("listitem.isselected", listItemDependent)));
+  EXPECT_TRUE(listItemDependent);
+
+  EXPECT_FALSE(infoMgr.IsListItemStatic(infoMgr.TranslateSingleString("listitem.isplaying", listItemDependent)));
+  EXPECT_FALSE(infoMgr.IsListItemStatic(infoMgr.TranslateSingleString("string.isempty(listitem.title)", listItemDependent)));
+
+  listItemDependent = false;
+  EXPECT_FALSE(infoMgr.IsListItemStatic(infoMgr.TranslateSingleString("player.hasvideo", listItemDependent)));
+  EXPECT_FALSE(infoMgr.IsListItemStatic(infoMgr.TranslateSingleString("true", listItemDependent)));
+  EXPECT_FALSE(listItemDependent);
+}
+
+TEST(TestListItemConditions, GetCached)
+{
+  unsigned int refreshCounter = 0;
+  CFolderInfoBool condition(refreshCounter);
+  CFileItem item;
+
+  EXPECT_FALSE(condition.Get(&item));
+  EXPECT_FALSE(condition.Get(&item));
+  EXPECT_EQ(1, condition.m_updates);
+
+  // direct writes to the folder flag must not return the stale value
+  item.m_bIsFolder = true;
+  EXPECT_TRUE(condition.Get(&item));
+  EXPECT_TRUE(condition.Get(&item));
+  EXPECT_EQ(2, condition.m_updates);
+
+  item.SetArtFallback("thumb", "icon");
+  EXPECT_TRUE(condition.Get(&item));
+  EXPECT_EQ(3, condition.m_updates);
+
+  item.SetProperty("foo", "bar");
+  EXPECT_TRUE(condition.Get(&item));
+  EXPECT_EQ(4, condition.m_updates);
+
+  item.Select(true);
+  EXPECT_TRUE(condition.Get(&item));
+  EXPECT_EQ(5, condition.m_updates);
+
+  item.SetInvalid();
+  EXPECT_TRUE(condition.Get(&item));
+  EXPECT_EQ(6, condition.m_updates);
+}
+
+TEST(TestListItemConditions, GetCachedPerItem)
+{
+  unsigned int refreshCounter = 0;
+  CFolderInfoBool condition(refreshCounter);
+  CFileItem file;
+  CFileItem folder;
+  folder.m_bIsFolder = true;
+
+  EXPECT_FALSE(condition.Get(&file));
+  EXPECT_TRUE(condition.Get(&folder));
+  EXPECT_FALSE(condition.Get(&file));
+  EXPECT_TRUE(condition.Get(&folder));
+  EXPECT_EQ(2, condition.m_updates);
+}
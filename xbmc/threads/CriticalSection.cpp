@@ -0,0 +1,28 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "CriticalSection.h"
+
+void CCriticalSection::profiledLock()
+{
+  int64_t start = CLockProfiler::Now();
+  bool contended = !CountingLockable::try_lock();
+  if (contended)
+    CountingLockable::lock();
+
+  CLockProfiler::AddWait(profile.GetSite(), start, contended);
+  if (count == 1)
+    profile.m_holdStart = contended ? CLockProfiler::Now() : start;
+}
+
+void CCriticalSection::profiledUnlock()
+{
+  if (CLockProfiler::IsEnabled())
+    CLockProfiler::AddHold(profile.GetSite(), profile.m_holdStart);
+  profile.m_holdStart = 0;
+}
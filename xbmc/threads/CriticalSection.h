@@ -10,5 +10,31 @@
 
 #include "platform/RecursiveMutex.h"
 #include "threads/Lockables.h"
+#include "threads/LockProfiler.h"
 
-class CCriticalSection : public XbmcThreads::CountingLockable<XbmcThreads::CRecursiveMutex> {};
+class CCriticalSection : public XbmcThreads::CountingLockable<XbmcThreads::CRecursiveMutex>
+{
+  XbmcThreads::LockProfile profile;
+
+  void profiledLock();
+  void profiledUnlock();
+
+public:
+  inline CCriticalSection() = default;
+
+  /**
+   * Create a critical section that is recorded by CLockProfiler under the given tag.
+   */
+  inline explicit CCriticalSection(const char* tag) : profile(tag) {}
+
+  inline void lock() { if (profile.IsActive()) profiledLock(); else CountingLockable::lock(); }
+  inline bool try_lock()
+  {
+    if (!CountingLockable::try_lock())
+      return false;
+    if (count == 1 && profile.IsActive())
+      profile.m_holdStart = CLockProfiler::Now();
+    return true;
+  }
+  inline void unlock() { if (profile.m_holdStart != 0 && count == 1) profiledUnlock(); CountingLockable::unlock(); }
+};
@@ -0,0 +1,117 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "LockProfiler.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <inttypes.h>
+
+std::atomic<bool> CLockProfiler::s_enabled{false};
+
+namespace
+{
+void StoreMax(std::atomic<uint64_t> &max, uint64_t value)
+{
+  uint64_t current = max.load(std::memory_order_relaxed);
+  while (value > current && !max.compare_exchange_weak(current, value, std::memory_order_relaxed))
+    ;
+}
+}
+
+CLockProfiler& CLockProfiler::GetInstance()
+{
+  static CLockProfiler sLockProfiler;
+  return sLockProfiler;
+}
+
+void CLockProfiler::SetEnabled(bool enabled)
+{
+  if (s_enabled.exchange(enabled) != enabled)
+    CLog::Log(LOGNOTICE, "CLockProfiler: %s", enabled ? "enabled" : "disabled");
+}
+
+void CLockProfiler::Reset()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  for (auto &it : m_sites)
+  {
+    Site &site = *it.second;
+    site.acquisitions = 0;
+    site.contentions = 0;
+    site.waitTime = 0;
+    site.maxWaitTime = 0;
+    site.holdTime = 0;
+    site.maxHoldTime = 0;
+  }
+}
+
+std::vector<CLockProfiler::Statistics> CLockProfiler::GetStatistics(size_t count /* = 0 */) const
+{
+  std::vector<Statistics> statistics;
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (const auto &it : m_sites)
+    {
+      const Site &site = *it.second;
+      statistics.push_back({ site.tag, site.acquisitions, site.contentions,
+                             site.waitTime / 1000.0, site.maxWaitTime / 1000.0,
+                             site.holdTime / 1000.0, site.maxHoldTime / 1000.0 });
+    }
+  }
+
+  std::sort(statistics.begin(), statistics.end(), [](const Statistics &left, const Statistics &right)
+  {
+    return left.waitMs > right.waitMs;
+  });
+  if (count > 0 && statistics.size() > count)
+    statistics.resize(count);
+
+  return statistics;
+}
+
+void CLockProfiler::LogStatistics(size_t count) const
+{
+  std::vector<Statistics> statistics = GetStatistics(count);
+  if (statistics.empty())
+    return;
+
+  CLog::Log(LOGNOTICE, "Lock statistics (acquisitions, contentions, wait ms, max wait ms, hold ms, max hold ms):");
+  for (const auto &lock : statistics)
+    CLog::Log(LOGNOTICE, "  %-32s %10" PRIu64 " %8" PRIu64 " %10.1f %8.1f %10.1f %8.1f", lock.tag.c_str(),
+              lock.acquisitions, lock.contentions, lock.waitMs, lock.maxWaitMs, lock.holdMs, lock.maxHoldMs);
+}
+
+CLockProfiler::Site* CLockProfiler::GetSite(const char *tag)
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  auto &site = m_sites[tag];
+  if (!site)
+    site.reset(new Site(tag));
+
+  return site.get();
+}
+
+void CLockProfiler::AddWait(Site *site, int64_t start, bool contended)
+{
+  site->acquisitions.fetch_add(1, std::memory_order_relaxed);
+  if (!contended)
+    return;
+
+  uint64_t wait = Now() - start;
+  site->contentions.fetch_add(1, std::memory_order_relaxed);
+  site->waitTime.fetch_add(wait, std::memory_order_relaxed);
+  StoreMax(site->maxWaitTime, wait);
+}
+
+void CLockProfiler::AddHold(Site *site, int64_t start)
+{
+  uint64_t hold = Now() - start;
+  site->holdTime.fetch_add(hold, std::memory_order_relaxed);
+  StoreMax(site->maxHoldTime, hold);
+}
@@ -0,0 +1,124 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/*!
+ \brief Records how often and how long tagged locks are waited for and held.
+
+ Only critical and shared sections created with a tag are recorded, all
+ sections with the same tag are counted together. While the profiler is
+ disabled a lock costs a single additional check.
+
+ Hold times include time spent waiting on condition variables and in
+ CSingleExit while the lock is released, and are only recorded for the
+ exclusive owner of a shared section.
+ */
+class CLockProfiler
+{
+public:
+  struct Site
+  {
+    explicit Site(const std::string &name) : tag(name) {}
+
+    const std::string tag;
+    std::atomic<uint64_t> acquisitions{0};
+    std::atomic<uint64_t> contentions{0};
+    std::atomic<uint64_t> waitTime{0}; //!< in microseconds
+    std::atomic<uint64_t> maxWaitTime{0};
+    std::atomic<uint64_t> holdTime{0};
+    std::atomic<uint64_t> maxHoldTime{0};
+  };
+
+  struct Statistics
+  {
+    std::string tag;
+    uint64_t acquisitions;
+    uint64_t contentions;
+    double waitMs;
+    double maxWaitMs;
+    double holdMs;
+    double maxHoldMs;
+  };
+
+  static CLockProfiler& GetInstance();
+
+  static bool IsEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+  void SetEnabled(bool enabled);
+  void Reset();
+
+  /*! \brief Get the statistics of the locks waited for the longest
+   \param count maximum number of locks, 0 for all
+   */
+  std::vector<Statistics> GetStatistics(size_t count = 0) const;
+  void LogStatistics(size_t count) const;
+
+  /*! \brief Get the site of the given tag, sites are never removed.
+   */
+  Site* GetSite(const char *tag);
+
+  static int64_t Now()
+  {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+  static void AddWait(Site *site, int64_t start, bool contended);
+  static void AddHold(Site *site, int64_t start);
+
+private:
+  CLockProfiler() = default;
+  CLockProfiler(const CLockProfiler&) = delete;
+  CLockProfiler& operator=(const CLockProfiler&) = delete;
+
+  static std::atomic<bool> s_enabled;
+
+  // not a CCriticalSection, which would be profiled itself
+  mutable std::mutex m_mutex;
+  std::map<std::string, std::unique_ptr<Site>> m_sites;
+};
+
+namespace XbmcThreads
+{
+  /**
+   * The profiling state kept by each lock.
+   */
+  class LockProfile
+  {
+  public:
+    LockProfile() = default;
+    explicit LockProfile(const char *tag) : m_tag(tag) {}
+
+    inline bool IsActive() const { return m_tag != nullptr && CLockProfiler::IsEnabled(); }
+
+    inline CLockProfiler::Site* GetSite()
+    {
+      CLockProfiler::Site *site = m_site.load(std::memory_order_acquire);
+      if (site == nullptr)
+      {
+        site = CLockProfiler::GetInstance().GetSite(m_tag);
+        m_site.store(site, std::memory_order_release);
+      }
+      return site;
+    }
+
+    int64_t m_holdStart = 0; //!< only accessed by the owner of the lock
+
+  private:
+    const char *m_tag = nullptr;
+    std::atomic<CLockProfiler::Site*> m_site{nullptr};
+  };
+}
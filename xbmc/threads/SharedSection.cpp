@@ -0,0 +1,42 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "SharedSection.h"
+
+void CSharedSection::profiledLock()
+{
+  int64_t start = CLockProfiler::Now();
+  bool contended = !try_lock();
+  if (contended)
+    lockExclusive();
+  else
+    exclusiveCount--; // counted again by lock()
+
+  CLockProfiler::AddWait(profile.GetSite(), start, contended);
+  if (exclusiveCount == 0)
+    profile.m_holdStart = contended ? CLockProfiler::Now() : start;
+}
+
+void CSharedSection::profiledLockShared()
+{
+  int64_t start = CLockProfiler::Now();
+  bool contended = !sec.try_lock();
+  if (contended)
+    sec.lock();
+  sharedCount++;
+  sec.unlock();
+
+  CLockProfiler::AddWait(profile.GetSite(), start, contended);
+}
+
+void CSharedSection::profiledUnlock()
+{
+  if (CLockProfiler::IsEnabled())
+    CLockProfiler::AddHold(profile.GetSite(), profile.m_holdStart);
+  profile.m_holdStart = 0;
+}
@@ -23,14 +23,27 @@ class CSharedSection
 
   unsigned int sharedCount = 0;
 
+  XbmcThreads::LockProfile profile;
+  unsigned int exclusiveCount = 0; //!< only accessed by the exclusive owner
+
+  inline void lockExclusive() { CSingleLock l(sec); while (sharedCount) cond.wait(l); sec.lock(); }
+  void profiledLock();
+  void profiledLockShared();
+  void profiledUnlock();
+
 public:
   inline CSharedSection() : cond(actualCv,XbmcThreads::InversePredicate<unsigned int&>(sharedCount)) {}
 
-  inline void lock() { CSingleLock l(sec); while (sharedCount) cond.wait(l); sec.lock(); }
-  inline bool try_lock() { return (sec.try_lock() ? ((sharedCount == 0) ? true : (sec.unlock(), false)) : false); }
-  inline void unlock() { sec.unlock(); }
+  /**
+   * Create a shared section that is recorded by CLockProfiler under the given tag.
+   */
+  inline explicit CSharedSection(const char* tag) : cond(actualCv,XbmcThreads::InversePredicate<unsigned int&>(sharedCount)), profile(tag) {}
+
+  inline void lock() { if (profile.IsActive()) profiledLock(); else lockExclusive(); exclusiveCount++; }
+  inline bool try_lock() { return (sec.try_lock() ? ((sharedCount == 0) ? (exclusiveCount++, true) : (sec.unlock(), false)) : false); }
+  inline void unlock() { if (--exclusiveCount == 0 && profile.m_holdStart != 0) profiledUnlock(); sec.unlock(); }
 
-  inline void lock_shared() { CSingleLock l(sec); sharedCount++; }
+  inline void lock_shared() { if (profile.IsActive()) profiledLockShared(); else { CSingleLock l(sec); sharedCount++; } }
   inline bool try_lock_shared() { return (sec.try_lock() ? sharedCount++, sec.unlock(), true : false); }
   inline void unlock_shared() { CSingleLock l(sec); sharedCount--; if (!sharedCount) { cond.notifyAll(); } }
 };
@@ -0,0 +1,116 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "threads/LockProfiler.h"
+#include "threads/SharedSection.h"
+#include "threads/SingleLock.h"
+#include "threads/test/TestHelpers.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace
+{
+CLockProfiler::Statistics GetStatistics(const std::string &tag)
+{
+  auto statistics = CLockProfiler::GetInstance().GetStatistics();
+  auto it = std::find_if(statistics.begin(), statistics.end(), [&tag](const CLockProfiler::Statistics &lock)
+  {
+    return lock.tag == tag;
+  });
+  if (it == statistics.end())
+    return { tag, 0, 0, 0.0, 0.0, 0.0, 0.0 };
+
+  return *it;
+}
+
+class TestLockProfiler : public testing::Test
+{
+protected:
+  TestLockProfiler() { CLockProfiler::GetInstance().SetEnabled(true); }
+  ~TestLockProfiler() override
+  {
+    CLockProfiler::GetInstance().SetEnabled(false);
+    CLockProfiler::GetInstance().Reset();
+  }
+};
+}
+
+TEST_F(TestLockProfiler, Disabled)
+{
+  CLockProfiler::GetInstance().SetEnabled(false);
+  CCriticalSection sec("TestLockProfiler.Disabled");
+  {
+    CSingleLock lock(sec);
+  }
+
+  EXPECT_EQ(0u, GetStatistics("TestLockProfiler.Disabled").acquisitions);
+}
+
+TEST_F(TestLockProfiler, CriticalSection)
+{
+  CCriticalSection sec("TestLockProfiler.CriticalSection");
+  {
+    CSingleLock lock(sec);
+    CSingleLock recursive(sec);
+  }
+
+  auto statistics = GetStatistics("TestLockProfiler.CriticalSection");
+  EXPECT_EQ(2u, statistics.acquisitions);
+  EXPECT_EQ(0u, statistics.contentions);
+
+  std::thread other;
+  {
+    CSingleLock lock(sec);
+    other = std::thread([&sec]() { CSingleLock lock(sec); });
+    SleepMillis(50);
+  }
+  other.join();
+
+  statistics = GetStatistics("TestLockProfiler.CriticalSection");
+  EXPECT_EQ(4u, statistics.acquisitions);
+  EXPECT_EQ(1u, statistics.contentions);
+  EXPECT_GE(statistics.maxWaitMs, 25.0);
+  EXPECT_GE(statistics.maxHoldMs, 25.0);
+}
+
+TEST_F(TestLockProfiler, SharedSection)
+{
+  CSharedSection sec("TestLockProfiler.SharedSection");
+  std::thread other;
+  {
+    CSharedLock lock(sec);
+    other = std::thread([&sec]() { CExclusiveLock lock(sec); });
+    SleepMillis(50);
+  }
+  other.join();
+
+  auto statistics = GetStatistics("TestLockProfiler.SharedSection");
+  EXPECT_EQ(2u, statistics.acquisitions);
+  EXPECT_EQ(1u, statistics.contentions);
+  EXPECT_GE(statistics.maxWaitMs, 25.0);
+
+  // shared locks can still be taken afterwards
+  CSharedLock first(sec);
+  CSharedLock second(sec);
+  EXPECT_EQ(4u, GetStatistics("TestLockProfiler.SharedSection").acquisitions);
+}
+
+TEST_F(TestLockProfiler, SameTag)
+{
+  CCriticalSection first("TestLockProfiler.SameTag");
+  CCriticalSection second("TestLockProfiler.SameTag");
+  {
+    CSingleLock lock(first);
+  }
+  {
+    CSingleLock lock(second);
+  }
+
+  EXPECT_EQ(2u, GetStatistics("TestLockProfiler.SameTag").acquisitions);
+}
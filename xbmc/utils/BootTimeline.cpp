@@ -0,0 +1,118 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "BootTimeline.h"
+#include "filesystem/File.h"
+#include "threads/SingleLock.h"
+#include "utils/JSONVariantWriter.h"
+#include "utils/log.h"
+#include "utils/TimeUtils.h"
+#include "utils/Variant.h"
+
+#include <algorithm>
+
+CBootTimeline& CBootTimeline::GetInstance()
+{
+  static CBootTimeline sBootTimeline;
+  return sBootTimeline;
+}
+
+CBootTimeline::CBootTimeline()
+  : m_start(CurrentHostCounter())
+{
+}
+
+CBootTimeline::CScope::CScope(const std::string &name)
+  : m_name(name),
+    m_start(CurrentHostCounter())
+{
+}
+
+CBootTimeline::CScope::~CScope()
+{
+  CBootTimeline::GetInstance().AddSpan(m_name, m_start, CurrentHostCounter());
+}
+
+void CBootTimeline::AddSpan(const std::string &name, int64_t start, int64_t end)
+{
+  CSingleLock lock(m_critSection);
+  if (m_finished)
+    return;
+
+  m_events.push_back({name, start, end, GetThreadIndex()});
+}
+
+void CBootTimeline::AddMilestone(const std::string &name)
+{
+  int64_t now = CurrentHostCounter();
+  AddSpan(name, now, now);
+}
+
+void CBootTimeline::Finish()
+{
+  std::vector<CEntry> events;
+  {
+    CSingleLock lock(m_critSection);
+    if (m_finished)
+      return;
+    m_finished = true;
+    events.swap(m_events);
+  }
+
+  std::stable_sort(events.begin(), events.end(), [](const CEntry &left, const CEntry &right)
+  {
+    return left.start < right.start;
+  });
+
+  CVariant traceEvents(CVariant::VariantTypeArray);
+  CLog::Log(LOGNOTICE, "Boot timeline (start ms, duration ms, thread):");
+  for (const auto &event : events)
+  {
+    int64_t start = ToMicroseconds(event.start - m_start);
+    int64_t duration = ToMicroseconds(event.end - event.start);
+    if (event.end == event.start)
+      CLog::Log(LOGNOTICE, "  %8.1f           [%u] %s", start / 1000.0, event.thread, event.name.c_str());
+    else
+      CLog::Log(LOGNOTICE, "  %8.1f %8.1f  [%u] %s", start / 1000.0, duration / 1000.0, event.thread, event.name.c_str());
+
+    CVariant traceEvent;
+    traceEvent["name"] = event.name;
+    traceEvent["ph"] = event.end == event.start ? "i" : "X";
+    traceEvent["ts"] = start;
+    if (event.end != event.start)
+      traceEvent["dur"] = duration;
+    traceEvent["pid"] = 1;
+    traceEvent["tid"] = event.thread;
+    traceEvents.push_back(traceEvent);
+  }
+
+  CVariant trace;
+  trace["traceEvents"] = traceEvents;
+  std::string json;
+  XFILE::CFile file;
+  if (!CJSONVariantWriter::Write(trace, json, false) ||
+      !file.OpenForWrite("special://logpath/boottimeline.json", true) ||
+      file.Write(json.c_str(), json.size()) != static_cast<ssize_t>(json.size()))
+    CLog::Log(LOGWARNING, "CBootTimeline: unable to write boottimeline.json");
+}
+
+unsigned int CBootTimeline::GetThreadIndex()
+{
+  auto it = m_threads.find(std::this_thread::get_id());
+  if (it != m_threads.end())
+    return it->second;
+
+  unsigned int index = m_threads.size();
+  m_threads.insert(std::make_pair(std::this_thread::get_id(), index));
+  return index;
+}
+
+int64_t CBootTimeline::ToMicroseconds(int64_t ticks) const
+{
+  return ticks * 1000000 / CurrentHostFrequency();
+}
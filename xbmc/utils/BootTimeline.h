@@ -0,0 +1,74 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+
+#include <atomic>
+#include <map>
+#include <stdint.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*!
+ \brief Records what happens while the application starts up until the first frame is rendered.
+
+ Spans (e.g. the initialization of a service) and milestones are recorded with the thread they
+ happened on. Once startup is finished the timeline is written to the log and to
+ special://logpath/boottimeline.json, which can be loaded into chrome://tracing.
+ */
+class CBootTimeline
+{
+public:
+  static CBootTimeline& GetInstance();
+
+  /*! \brief Record the time spent in the current scope.
+   */
+  class CScope
+  {
+  public:
+    explicit CScope(const std::string &name);
+    ~CScope();
+
+  private:
+    std::string m_name;
+    int64_t m_start;
+  };
+
+  void AddSpan(const std::string &name, int64_t start, int64_t end);
+  void AddMilestone(const std::string &name);
+
+  /*! \brief Finish recording and write the timeline, subsequent calls are ignored.
+   */
+  void Finish();
+  bool IsFinished() const { return m_finished; }
+
+private:
+  CBootTimeline();
+  CBootTimeline(const CBootTimeline&) = delete;
+  CBootTimeline& operator=(const CBootTimeline&) = delete;
+
+  struct CEntry
+  {
+    std::string name;
+    int64_t start;
+    int64_t end; //!< equal to start for milestones
+    unsigned int thread;
+  };
+
+  unsigned int GetThreadIndex();
+  int64_t ToMicroseconds(int64_t ticks) const;
+
+  int64_t m_start;
+  std::atomic<bool> m_finished{false};
+  std::vector<CEntry> m_events;
+  std::map<std::thread::id, unsigned int> m_threads;
+  CCriticalSection m_critSection;
+};
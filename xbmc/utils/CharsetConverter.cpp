@@ -78,6 +78,21 @@
 
 #define NO_ICONV ((iconv_t)-1)
 
+// UTF-8 from and to Unicode strings is converted by CUtf8Utils, iconv is left for the
+// legacy charsets. UTF-8-MAC composes decomposed characters, so only plain US-ASCII
+// can skip iconv on Darwin.
+#if defined(TARGET_DARWIN)
+static inline bool CanDecodeUtf8Directly(const std::string& utf8String)
+{
+  return CUtf8Utils::IsAscii(utf8String);
+}
+#else
+static inline bool CanDecodeUtf8Directly(const std::string& /*utf8String*/)
+{
+  return true;
+}
+#endif
+
 enum SpecialCharset
 {
   NotSpecialCharset = 0,
@@ -646,6 +661,9 @@ void CCharsetConverter::reinitCharsetsFromSettings(void)
 
 bool CCharsetConverter::utf8ToUtf32(const std::string& utf8StringSrc, std::u32string& utf32StringDst, bool failOnBadChar /*= true*/)
 {
+  if (CanDecodeUtf8Directly(utf8StringSrc))
+    return CUtf8Utils::Utf8ToUtf32(utf8StringSrc, utf32StringDst, failOnBadChar);
+
   return CInnerConverter::stdConvert(Utf8ToUtf32, utf8StringSrc, utf32StringDst, failOnBadChar);
 }
 
@@ -661,17 +679,17 @@ bool CCharsetConverter::utf8ToUtf32Visual(const std::string& utf8StringSrc, std:
   if (bVisualBiDiFlip)
   {
     std::u32string converted;
-    if (!CInnerConverter::stdConvert(Utf8ToUtf32, utf8StringSrc, converted, failOnBadChar))
+    if (!utf8ToUtf32(utf8StringSrc, converted, failOnBadChar))
       return false;
 
     return CInnerConverter::logicalToVisualBiDi(converted, utf32StringDst, forceLTRReadingOrder ? FRIBIDI_TYPE_LTR : FRIBIDI_TYPE_PDF, failOnBadChar);
   }
-  return CInnerConverter::stdConvert(Utf8ToUtf32, utf8StringSrc, utf32StringDst, failOnBadChar);
+  return utf8ToUtf32(utf8StringSrc, utf32StringDst, failOnBadChar);
 }
 
 bool CCharsetConverter::utf32ToUtf8(const std::u32string& utf32StringSrc, std::string& utf8StringDst, bool failOnBadChar /*= true*/)
 {
-  return CInnerConverter::stdConvert(Utf32ToUtf8, utf32StringSrc, utf8StringDst, failOnBadChar);
+  return CUtf8Utils::Utf32ToUtf8(utf32StringSrc, utf8StringDst, failOnBadChar);
 }
 
 std::string CCharsetConverter::utf32ToUtf8(const std::u32string& utf32StringSrc, bool failOnBadChar /*= false*/)
@@ -715,15 +733,18 @@ bool CCharsetConverter::utf8ToW(const std::string& utf8StringSrc, std::wstring&
   {
     wStringDst.clear();
     std::u32string utf32str;
-    if (!CInnerConverter::stdConvert(Utf8ToUtf32, utf8StringSrc, utf32str, failOnBadChar))
+    if (!utf8ToUtf32(utf8StringSrc, utf32str, failOnBadChar))
       return false;
 
     std::u32string utf32flipped;
     const bool bidiResult = CInnerConverter::logicalToVisualBiDi(utf32str, utf32flipped, forceLTRReadingOrder ? FRIBIDI_TYPE_LTR : FRIBIDI_TYPE_PDF, failOnBadChar);
 
-    return CInnerConverter::stdConvert(Utf32ToW, utf32flipped, wStringDst, failOnBadChar) && bidiResult;
+    return utf32ToW(utf32flipped, wStringDst, failOnBadChar) && bidiResult;
   }
 
+  if (CanDecodeUtf8Directly(utf8StringSrc))
+    return CUtf8Utils::Utf8ToW(utf8StringSrc, wStringDst, failOnBadChar);
+
   return CInnerConverter::stdConvert(Utf8toW, utf8StringSrc, wStringDst, failOnBadChar);
 }
 
@@ -811,7 +832,7 @@ bool CCharsetConverter::unknownToUTF8(const std::string& stringSrc, std::string&
 
 bool CCharsetConverter::wToUTF8(const std::wstring& wStringSrc, std::string& utf8StringDst, bool failOnBadChar /*= false*/)
 {
-  return CInnerConverter::stdConvert(WtoUtf8, wStringSrc, utf8StringDst, failOnBadChar);
+  return CUtf8Utils::WToUtf8(wStringSrc, utf8StringDst, failOnBadChar);
 }
 
 bool CCharsetConverter::wToASCII(const std::wstring& wStringSrc, std::string& asciiStringDst, bool failOnBadChar)
@@ -9,6 +9,7 @@
 #include "JobManager.h"
 #include <algorithm>
 #include <functional>
+#include <iterator>
 #include <stdexcept>
 #include "threads/SingleLock.h"
 #include "utils/log.h"
@@ -130,12 +131,24 @@ bool CJobQueue::AddJob(CJob *job)
 void CJobQueue::QueueNextJob()
 {
   CSingleLock lock(m_section);
-  if (m_jobQueue.size() && m_processing.size() < m_jobsAtOnce)
+  if (m_jobQueue.empty() || m_processing.size() >= m_jobsAtOnce)
+    return;
+
+  std::vector<const CJob*> processing;
+  for (const auto &job : m_processing)
+    processing.push_back(job.m_job);
+
+  // the next job is at the back, skip the ones that may not be started yet
+  for (Queue::reverse_iterator i = m_jobQueue.rbegin(); i != m_jobQueue.rend(); ++i)
   {
-    CJobPointer &job = m_jobQueue.back();
+    if (!CanStartJob(i->m_job, processing))
+      continue;
+
+    CJobPointer job = *i;
     job.m_id = CJobManager::GetInstance().AddJob(job.m_job, this, m_priority);
     m_processing.push_back(job);
-    m_jobQueue.pop_back();
+    m_jobQueue.erase(std::next(i).base());
+    return;
   }
 }
 
@@ -247,6 +260,23 @@ void CJobManager::CancelJob(unsigned int jobID)
     it->m_callback = NULL; // job is in progress, so only thing to do is to remove callback
 }
 
+bool CJobManager::CancelQueuedJob(unsigned int jobID)
+{
+  CSingleLock lock(m_section);
+
+  for (unsigned int priority = CJob::PRIORITY_LOW_PAUSABLE; priority <= CJob::PRIORITY_DEDICATED; ++priority)
+  {
+    JobQueue::iterator i = find(m_jobQueue[priority].begin(), m_jobQueue[priority].end(), jobID);
+    if (i != m_jobQueue[priority].end())
+    {
+      delete i->m_job;
+      m_jobQueue[priority].erase(i);
+      return true;
+    }
+  }
+  return false;
+}
+
 void CJobManager::StartWorkers(CJob::PRIORITY priority)
 {
   CSingleLock lock(m_section);
@@ -163,6 +163,17 @@ protected:
    */
   bool QueueEmpty() const;
 
+  /*!
+   \brief Check whether a queued job may be started now
+   Subclasses may override this to limit which jobs run alongside each other. A job
+   that may not be started stays queued, and later jobs that may be started are
+   started instead. The queue is locked while this is called.
+   \param job the queued job
+   \param processing the jobs that are currently processing
+   \return true if the job may be started, false otherwise. Defaults to true.
+   */
+  virtual bool CanStartJob(const CJob *job, const std::vector<const CJob*> &processing) const { return true; }
+
 private:
   void QueueNextJob();
 
@@ -251,11 +262,12 @@ public:
 
   /*!
    \brief Add a function f to this job manager for asynchronously execution.
+   \return a unique identifier for this job, to be used with CancelJob()
    */
   template<typename F>
-  void Submit(F&& f, IJobCallback *callback, CJob::PRIORITY priority = CJob::PRIORITY_LOW)
+  unsigned int Submit(F&& f, IJobCallback *callback, CJob::PRIORITY priority = CJob::PRIORITY_LOW)
   {
-    AddJob(new CLambdaJob<F>(std::forward<F>(f)), callback, priority);
+    return AddJob(new CLambdaJob<F>(std::forward<F>(f)), callback, priority);
   }
 
   /*!
@@ -265,6 +277,15 @@ public:
    */
   void CancelJob(unsigned int jobID);
 
+  /*!
+   \brief Cancel a job with the given id if it hasn't been started yet.
+   Unlike CancelJob() a job that is processing is left alone, its callback is still performed.
+   \param jobID the id of the job to cancel, retrieved previously from AddJob()
+   \return true if the job was removed from the queue, false if it is processing or done.
+   \sa AddJob(), CancelJob()
+   */
+  bool CancelQueuedJob(unsigned int jobID);
+
   /*!
    \brief Cancel all remaining jobs, preparing for shutdown
    Should be called prior to destroying any objects that may be being used as callbacks
@@ -0,0 +1,174 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "TaskGraph.h"
+#include "threads/SingleLock.h"
+#include "utils/JobManager.h"
+#include "utils/log.h"
+
+#include <algorithm>
+
+CTaskGraph::CTaskGraph(const std::string &name, TaskRunner runner /* = nullptr */)
+  : m_name(name),
+    m_runner(runner)
+{
+}
+
+bool CTaskGraph::Add(const std::string &name, const std::vector<std::string> &dependencies, Task task, bool callingThread /* = false */)
+{
+  auto findNode = [this](const std::string &nodeName)
+  {
+    return std::find_if(m_nodes.begin(), m_nodes.end(), [&nodeName](const CNode &node)
+    {
+      return node.name == nodeName;
+    });
+  };
+
+  if (findNode(name) != m_nodes.end())
+  {
+    CLog::Log(LOGERROR, "CTaskGraph: task %s added twice", name.c_str());
+    return false;
+  }
+
+  std::vector<size_t> indexes;
+  for (const auto &dependency : dependencies)
+  {
+    auto it = findNode(dependency);
+    if (it == m_nodes.end())
+    {
+      CLog::Log(LOGERROR, "CTaskGraph: task %s depends on unknown task %s", name.c_str(), dependency.c_str());
+      return false;
+    }
+    indexes.push_back(it - m_nodes.begin());
+  }
+
+  // as dependencies have to be added first there can't be any cycles
+  for (size_t index : indexes)
+    m_nodes[index].dependents.push_back(m_nodes.size());
+
+  CNode node;
+  node.name = name;
+  node.task = task;
+  node.callingThread = callingThread;
+  m_nodes.push_back(node);
+  return true;
+}
+
+bool CTaskGraph::Run(unsigned int threads)
+{
+  CSingleLock lock(m_critSection);
+  m_finished.clear();
+  m_running = 0;
+  m_failed = false;
+  for (auto &node : m_nodes)
+  {
+    node.started = false;
+    node.pending = 0;
+  }
+  for (const auto &node : m_nodes)
+  {
+    for (size_t dependent : node.dependents)
+      m_nodes[dependent].pending++;
+  }
+
+  // the calling thread counts as one of the threads
+  const size_t jobs = std::max(threads, 1u) - 1;
+
+  while (true)
+  {
+    size_t next = m_nodes.size();
+    if (!m_failed)
+    {
+      for (size_t i = 0; i < m_nodes.size(); i++)
+      {
+        CNode &node = m_nodes[i];
+        if (node.started || node.pending > 0)
+          continue;
+
+        // run sequentially in the order the tasks were added, otherwise tasks of the
+        // calling thread go first as the workers can't run them
+        if (jobs == 0 || node.callingThread)
+        {
+          next = i;
+          break;
+        }
+
+        if (m_running < jobs)
+        {
+          node.started = true;
+          m_running++;
+          CJobManager::GetInstance().Submit([this, i]()
+          {
+            bool success = RunNode(i);
+            CSingleLock lock(m_critSection);
+            OnNodeDone(i, success);
+          }, CJob::PRIORITY_DEDICATED);
+        }
+        else if (next == m_nodes.size())
+          next = i;
+      }
+    }
+
+    // run a task here rather than waiting idle
+    if (next < m_nodes.size())
+    {
+      m_nodes[next].started = true;
+      m_running++;
+
+      lock.Leave();
+      bool success = RunNode(next);
+      lock.Enter();
+
+      OnNodeDone(next, success);
+      continue;
+    }
+
+    if (m_running == 0)
+      break;
+
+    lock.Leave();
+    m_changed.Wait();
+    lock.Enter();
+  }
+
+  return !m_failed;
+}
+
+std::vector<std::string> CTaskGraph::GetFinished() const
+{
+  CSingleLock lock(m_critSection);
+  return m_finished;
+}
+
+bool CTaskGraph::RunNode(size_t index)
+{
+  const CNode &node = m_nodes[index];
+  if (m_runner)
+    return m_runner(m_name + "/" + node.name, node.task);
+  return node.task();
+}
+
+// Always called with the lock held on m_critSection
+void CTaskGraph::OnNodeDone(size_t index, bool success)
+{
+  CNode &node = m_nodes[index];
+  m_running--;
+  if (success)
+  {
+    m_finished.push_back(node.name);
+    for (size_t dependent : node.dependents)
+      m_nodes[dependent].pending--;
+  }
+  else
+  {
+    CLog::Log(LOGERROR, "CTaskGraph: task %s/%s failed", m_name.c_str(), node.name.c_str());
+    m_failed = true;
+  }
+
+  m_changed.Set();
+}
@@ -0,0 +1,88 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+/*!
+ \brief Runs tasks concurrently as far as their dependencies allow.
+
+ Every task names the tasks it depends on and is started once all of them have finished.
+ Tasks which have to run on the thread calling Run() (e.g. because they touch the windowing
+ system) are marked as such, all others are run by dedicated jobs of the CJobManager or by
+ the calling thread while it would be waiting otherwise.
+ */
+class CTaskGraph
+{
+public:
+  typedef std::function<bool()> Task;
+
+  /*!
+   \brief Runs a task, e.g. to record the time spent in it.
+   \param name the name of the graph and the task, separated by a slash
+   \param task the task to run
+   \return the result of the task
+   */
+  typedef std::function<bool(const std::string &name, const Task &task)> TaskRunner;
+
+  /*!
+   \param name prefixed to the names of the tasks passed to the task runner and logged
+   \param runner optional wrapper every task is run by
+   */
+  explicit CTaskGraph(const std::string &name, TaskRunner runner = nullptr);
+
+  /*! \brief Add a task.
+   \param name unique name of the task
+   \param dependencies names of the tasks which have to be finished first, they have to be
+                       added before
+   \param task the work, returning false stops the graph
+   \param callingThread whether the task has to be run by the thread calling Run()
+   \return false if the name is taken or a dependency is unknown.
+   */
+  bool Add(const std::string &name, const std::vector<std::string> &dependencies, Task task, bool callingThread = false);
+
+  /*! \brief Run all tasks.
+   \param threads maximum number of tasks run at the same time, 1 runs all tasks in the order
+                  they were added on the calling thread
+   \return false if a task failed, tasks not started by then are skipped.
+   */
+  bool Run(unsigned int threads);
+
+  /*! \brief The names of the tasks in the order they were finished by the last Run().
+   */
+  std::vector<std::string> GetFinished() const;
+
+private:
+  struct CNode
+  {
+    std::string name;
+    Task task;
+    bool callingThread;
+    std::vector<size_t> dependents;
+    size_t pending = 0; //!< number of unfinished dependencies
+    bool started = false;
+  };
+
+  bool RunNode(size_t index);
+  void OnNodeDone(size_t index, bool success);
+
+  std::string m_name;
+  TaskRunner m_runner;
+  std::vector<CNode> m_nodes;
+  std::vector<std::string> m_finished;
+  size_t m_running = 0;
+  bool m_failed = false;
+  CEvent m_changed;
+  mutable CCriticalSection m_critSection;
+};
@@ -8,6 +8,13 @@
 
 #include "Utf8Utils.h"
 
+#include <cstdint>
+
+#if defined(HAVE_SSE2) && defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(HAS_NEON) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
 
 CUtf8Utils::utf8CheckResult CUtf8Utils::checkStrForUtf8(const std::string& str)
 {
@@ -146,3 +153,275 @@ inline size_t CUtf8Utils::SizeOfUtf8Char(const char* const str)
 
   return 0; // invalid UTF-8 char sequence
 }
+
+namespace
+{
+
+// Copies the leading US-ASCII characters of src to dst widened to CHAR,
+// advances src and returns the new end of dst
+template<typename CHAR>
+CHAR* WidenAscii(const unsigned char*& src, const unsigned char* const end, CHAR* dst)
+{
+#if defined(HAVE_SSE2) && defined(__SSE2__)
+  const __m128i zero = _mm_setzero_si128();
+  while (end - src >= 16)
+  {
+    const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    if (_mm_movemask_epi8(chars) != 0)
+      break;
+
+    const __m128i low = _mm_unpacklo_epi8(chars, zero);
+    const __m128i high = _mm_unpackhi_epi8(chars, zero);
+    __m128i* out = reinterpret_cast<__m128i*>(dst);
+    if (sizeof(CHAR) == 2)
+    {
+      _mm_storeu_si128(out, low);
+      _mm_storeu_si128(out + 1, high);
+    }
+    else
+    {
+      _mm_storeu_si128(out, _mm_unpacklo_epi16(low, zero));
+      _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(low, zero));
+      _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(high, zero));
+      _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(high, zero));
+    }
+    src += 16;
+    dst += 16;
+  }
+#elif defined(HAS_NEON) && defined(__ARM_NEON)
+  while (end - src >= 16)
+  {
+    const uint8x16_t chars = vld1q_u8(src);
+    const uint64x2_t high_bits = vreinterpretq_u64_u8(vandq_u8(chars, vdupq_n_u8(0x80)));
+    if (vgetq_lane_u64(high_bits, 0) | vgetq_lane_u64(high_bits, 1))
+      break;
+
+    const uint16x8_t low = vmovl_u8(vget_low_u8(chars));
+    const uint16x8_t high = vmovl_u8(vget_high_u8(chars));
+    if (sizeof(CHAR) == 2)
+    {
+      uint16_t* out = reinterpret_cast<uint16_t*>(dst);
+      vst1q_u16(out, low);
+      vst1q_u16(out + 8, high);
+    }
+    else
+    {
+      uint32_t* out = reinterpret_cast<uint32_t*>(dst);
+      vst1q_u32(out, vmovl_u16(vget_low_u16(low)));
+      vst1q_u32(out + 4, vmovl_u16(vget_high_u16(low)));
+      vst1q_u32(out + 8, vmovl_u16(vget_low_u16(high)));
+      vst1q_u32(out + 12, vmovl_u16(vget_high_u16(high)));
+    }
+    src += 16;
+    dst += 16;
+  }
+#endif
+
+  while (src < end && *src < 0x80)
+    *dst++ = static_cast<CHAR>(*src++);
+
+  return dst;
+}
+
+inline bool IsContinuation(unsigned char chr)
+{
+  return (chr & 0xC0) == 0x80;
+}
+
+// Decodes the multi-byte sequence at src, returns its length or 0 if it isn't valid.
+// The ranges are those of http://www.unicode.org/versions/Unicode6.2.0/ch03.pdf#G27506
+size_t DecodeSequence(const unsigned char* src, size_t avail, char32_t& codepoint)
+{
+  const unsigned char chr = src[0];
+
+  if (chr >= 0xC2 && chr <= 0xDF)
+  {
+    if (avail < 2 || !IsContinuation(src[1]))
+      return 0;
+    codepoint = ((chr & 0x1F) << 6) | (src[1] & 0x3F);
+    return 2;
+  }
+
+  if (chr >= 0xE0 && chr <= 0xEF)
+  {
+    if (avail < 3 || !IsContinuation(src[1]) || !IsContinuation(src[2]) ||
+        (chr == 0xE0 && src[1] < 0xA0) ||  // overlong
+        (chr == 0xED && src[1] > 0x9F))    // surrogates U+D800 - U+DFFF
+      return 0;
+    codepoint = ((chr & 0x0F) << 12) | ((src[1] & 0x3F) << 6) | (src[2] & 0x3F);
+    return 3;
+  }
+
+  if (chr >= 0xF0 && chr <= 0xF4)
+  {
+    if (avail < 4 || !IsContinuation(src[1]) || !IsContinuation(src[2]) || !IsContinuation(src[3]) ||
+        (chr == 0xF0 && src[1] < 0x90) ||  // overlong
+        (chr == 0xF4 && src[1] > 0x8F))    // above U+10FFFF
+      return 0;
+    codepoint = ((chr & 0x07) << 18) | ((src[1] & 0x3F) << 12) | ((src[2] & 0x3F) << 6) | (src[3] & 0x3F);
+    return 4;
+  }
+
+  return 0;
+}
+
+template<class OUTPUT>
+bool DecodeUtf8(const std::string& utf8StringSrc, OUTPUT& stringDst, bool failOnBadChar)
+{
+  typedef typename OUTPUT::value_type CHAR;
+  static_assert(sizeof(CHAR) == 2 || sizeof(CHAR) == 4, "only UTF-16 and UTF-32 output is supported");
+
+  // no sequence produces more code units than it has bytes
+  stringDst.resize(utf8StringSrc.size());
+  if (utf8StringSrc.empty())
+    return true;
+
+  const unsigned char* src = reinterpret_cast<const unsigned char*>(utf8StringSrc.data());
+  const unsigned char* const end = src + utf8StringSrc.size();
+  CHAR* const start = &stringDst[0];
+  CHAR* dst = start;
+
+  while (src < end)
+  {
+    dst = WidenAscii(src, end, dst);
+    if (src == end)
+      break;
+
+    char32_t codepoint;
+    const size_t length = DecodeSequence(src, end - src, codepoint);
+    if (length == 0)
+    {
+      if (failOnBadChar)
+      {
+        stringDst.clear();
+        return false;
+      }
+      src++;
+      continue;
+    }
+
+    if (sizeof(CHAR) == 2 && codepoint > 0xFFFF)
+    {
+      codepoint -= 0x10000;
+      *dst++ = static_cast<CHAR>(0xD800 | (codepoint >> 10));
+      *dst++ = static_cast<CHAR>(0xDC00 | (codepoint & 0x3FF));
+    }
+    else
+      *dst++ = static_cast<CHAR>(codepoint);
+    src += length;
+  }
+
+  stringDst.resize(dst - start);
+  return true;
+}
+
+template<class INPUT>
+bool EncodeUtf8(const INPUT& stringSrc, std::string& utf8StringDst, bool failOnBadChar)
+{
+  typedef typename INPUT::value_type CHAR;
+  static_assert(sizeof(CHAR) == 2 || sizeof(CHAR) == 4, "only UTF-16 and UTF-32 input is supported");
+
+  utf8StringDst.clear();
+  utf8StringDst.reserve(stringSrc.size());
+
+  const size_t size = stringSrc.size();
+  for (size_t i = 0; i < size; i++)
+  {
+    char32_t codepoint = static_cast<char32_t>(stringSrc[i]);
+    if (codepoint < 0x80)
+    {
+      utf8StringDst.push_back(static_cast<char>(codepoint));
+      continue;
+    }
+
+    if (sizeof(CHAR) == 2 && codepoint >= 0xD800 && codepoint <= 0xDBFF && i + 1 < size &&
+        stringSrc[i + 1] >= 0xDC00 && stringSrc[i + 1] <= 0xDFFF)
+    {
+      codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (stringSrc[i + 1] - 0xDC00);
+      i++;
+    }
+    else if ((codepoint >= 0xD800 && codepoint <= 0xDFFF) || codepoint > 0x10FFFF)
+    {
+      if (failOnBadChar)
+      {
+        utf8StringDst.clear();
+        return false;
+      }
+      continue;
+    }
+
+    if (codepoint < 0x800)
+    {
+      utf8StringDst.push_back(static_cast<char>(0xC0 | (codepoint >> 6)));
+    }
+    else if (codepoint < 0x10000)
+    {
+      utf8StringDst.push_back(static_cast<char>(0xE0 | (codepoint >> 12)));
+      utf8StringDst.push_back(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F)));
+    }
+    else
+    {
+      utf8StringDst.push_back(static_cast<char>(0xF0 | (codepoint >> 18)));
+      utf8StringDst.push_back(static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F)));
+      utf8StringDst.push_back(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F)));
+    }
+    utf8StringDst.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+  }
+
+  return true;
+}
+
+} // unnamed namespace
+
+bool CUtf8Utils::IsAscii(const std::string& str)
+{
+  const unsigned char* src = reinterpret_cast<const unsigned char*>(str.data());
+  const unsigned char* const end = src + str.size();
+
+#if defined(HAVE_SSE2) && defined(__SSE2__)
+  for (; end - src >= 16; src += 16)
+  {
+    if (_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src))) != 0)
+      return false;
+  }
+#elif defined(HAS_NEON) && defined(__ARM_NEON)
+  for (; end - src >= 16; src += 16)
+  {
+    const uint64x2_t high_bits = vreinterpretq_u64_u8(vandq_u8(vld1q_u8(src), vdupq_n_u8(0x80)));
+    if (vgetq_lane_u64(high_bits, 0) | vgetq_lane_u64(high_bits, 1))
+      return false;
+  }
+#endif
+
+  for (; src < end; src++)
+  {
+    if (*src >= 0x80)
+      return false;
+  }
+  return true;
+}
+
+bool CUtf8Utils::Utf8ToUtf32(const std::string& utf8StringSrc, std::u32string& stringDst, bool failOnBadChar /*= true*/)
+{
+  return DecodeUtf8(utf8StringSrc, stringDst, failOnBadChar);
+}
+
+bool CUtf8Utils::Utf8ToUtf16(const std::string& utf8StringSrc, std::u16string& stringDst, bool failOnBadChar /*= true*/)
+{
+  return DecodeUtf8(utf8StringSrc, stringDst, failOnBadChar);
+}
+
+bool CUtf8Utils::Utf8ToW(const std::string& utf8StringSrc, std::wstring& stringDst, bool failOnBadChar /*= true*/)
+{
+  return DecodeUtf8(utf8StringSrc, stringDst, failOnBadChar);
+}
+
+bool CUtf8Utils::Utf32ToUtf8(const std::u32string& stringSrc, std::string& utf8StringDst, bool failOnBadChar /*= false*/)
+{
+  return EncodeUtf8(stringSrc, utf8StringDst, failOnBadChar);
+}
+
+bool CUtf8Utils::WToUtf8(const std::wstring& stringSrc, std::string& utf8StringDst, bool failOnBadChar /*= false*/)
+{
+  return EncodeUtf8(stringSrc, utf8StringDst, failOnBadChar);
+}
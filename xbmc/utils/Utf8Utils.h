@@ -37,6 +37,38 @@ public:
   static size_t RFindValidUtf8Char(const std::string& str, const size_t startPos);
 
   static size_t SizeOfUtf8Char(const std::string& str, const size_t charStart = 0);
+
+  /**
+   * Check whether given string has only US-ASCII characters, faster than checkStrForUtf8()
+   * @param str string to check
+   * @return true if all characters are US-ASCII, true for empty string
+   */
+  static bool IsAscii(const std::string& str);
+
+  /**
+   * Convert UTF-8 string to UTF-32, UTF-16 or wchar_t string without iconv
+   * Neither locks nor conversion state are involved, so it can be used from any thread.
+   * @param utf8StringSrc source UTF-8 string
+   * @param stringDst output string, empty on any error
+   * @param failOnBadChar if set to true conversion fails on invalid sequence,
+   *                      otherwise invalid bytes are skipped
+   * @return true on successful conversion, false on any error
+   */
+  static bool Utf8ToUtf32(const std::string& utf8StringSrc, std::u32string& stringDst, bool failOnBadChar = true);
+  static bool Utf8ToUtf16(const std::string& utf8StringSrc, std::u16string& stringDst, bool failOnBadChar = true);
+  static bool Utf8ToW(const std::string& utf8StringSrc, std::wstring& stringDst, bool failOnBadChar = true);
+
+  /**
+   * Convert UTF-32 or wchar_t string to UTF-8 string without iconv
+   * @param stringSrc source string
+   * @param utf8StringDst output UTF-8 string, empty on any error
+   * @param failOnBadChar if set to true conversion fails on invalid character,
+   *                      otherwise invalid characters are skipped
+   * @return true on successful conversion, false on any error
+   */
+  static bool Utf32ToUtf8(const std::u32string& stringSrc, std::string& utf8StringDst, bool failOnBadChar = false);
+  static bool WToUtf8(const std::wstring& stringSrc, std::string& utf8StringDst, bool failOnBadChar = false);
+
 private:
   static size_t SizeOfUtf8Char(const char* const str);
 };
@@ -10,10 +10,18 @@
 #include "CompileInfo.h"
 #include "settings/AdvancedSettings.h"
 #include "threads/CriticalSection.h"
+#include "threads/Event.h"
 #include "threads/SingleLock.h"
 #include "threads/Thread.h"
 #include "utils/StringUtils.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+
 #if defined(TARGET_POSIX)
 #include "platform/posix/utils/PosixInterfaceForCLog.h"
 typedef class CPosixInterfaceForCLog PlatformInterfaceForCLog;
@@ -32,6 +40,90 @@ static const char* const logLevelNames[] =
 
 namespace
 {
+struct CLogEntry
+{
+  uint64_t sequence = 0;
+  std::chrono::system_clock::time_point time;
+  int logLevel = LOGNONE;
+  std::string line;
+};
+
+/*!
+ Lines logged by a single thread, waiting for the writer thread. Only the owning thread
+ pushes and only the writer pops, so no lock is needed. Lines are dropped when the
+ buffer is full rather than blocking the logging thread.
+ */
+class CLogBuffer
+{
+public:
+  static const size_t SIZE = 512;
+
+  explicit CLogBuffer(uint64_t threadId) : m_threadId(threadId) {}
+
+  bool Push(CLogEntry&& entry)
+  {
+    const size_t tail = m_tail.load(std::memory_order_relaxed);
+    const size_t next = (tail + 1) % SIZE;
+    if (next == m_head.load(std::memory_order_acquire))
+    {
+      m_dropped++;
+      return false;
+    }
+    m_entries[tail] = std::move(entry);
+    m_tail.store(next, std::memory_order_release);
+    return true;
+  }
+
+  void Pop(std::vector<CLogEntry>& entries)
+  {
+    size_t head = m_head.load(std::memory_order_relaxed);
+    const size_t tail = m_tail.load(std::memory_order_acquire);
+    for (; head != tail; head = (head + 1) % SIZE)
+      entries.push_back(std::move(m_entries[head]));
+    m_head.store(head, std::memory_order_release);
+  }
+
+  bool IsEmpty() const
+  {
+    return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+  }
+
+  uint64_t GetThreadId() const { return m_threadId; }
+  unsigned int TakeDropped() { return m_dropped.exchange(0); }
+
+  //! the owning thread has exited, the buffer can go once it is empty
+  std::atomic<bool> m_closed{false};
+
+private:
+  const uint64_t m_threadId;
+  std::array<CLogEntry, SIZE> m_entries;
+  std::atomic<size_t> m_head{0};
+  std::atomic<size_t> m_tail{0};
+  std::atomic<unsigned int> m_dropped{0};
+};
+
+class CLogBufferOwner
+{
+public:
+  ~CLogBufferOwner()
+  {
+    if (m_buffer)
+      m_buffer->m_closed = true;
+  }
+  std::shared_ptr<CLogBuffer> m_buffer;
+};
+
+thread_local CLogBufferOwner tlsLogBuffer;
+
+class CLogWriter : public CThread
+{
+public:
+  CLogWriter() : CThread("LogWriter") {}
+
+protected:
+  void Process() override;
+};
+
 class CLogGlobals
 {
 public:
@@ -43,50 +135,230 @@ public:
   int         m_logLevel = LOG_LEVEL_DEBUG;
   int         m_extraLogLevels = 0;
   CCriticalSection critSec;
+
+  std::atomic<uint64_t> m_sequence{0};
+  std::atomic<unsigned int> m_droppedLines{0};
+  std::vector<std::shared_ptr<CLogBuffer>> m_buffers;
+  CCriticalSection m_buffersSection;
+  std::unique_ptr<CLogWriter> m_writer;
+  std::atomic<bool> m_writerSleeping{false};
+  CEvent m_writerEvent;
+  //! held while writing a batch, keeps lines in order when the writer and a logging thread flush at once
+  CCriticalSection m_flushSection;
+  std::atomic<bool> m_fileOpen{false};
 };
 
 static CLogGlobals g_logState;
+
+CLogBuffer& GetThreadBuffer()
+{
+  if (!tlsLogBuffer.m_buffer)
+  {
+    tlsLogBuffer.m_buffer = std::make_shared<CLogBuffer>((uint64_t)CThread::GetCurrentThreadId());
+    CSingleLock lock(g_logState.m_buffersSection);
+    g_logState.m_buffers.push_back(tlsLogBuffer.m_buffer);
+  }
+  return *tlsLogBuffer.m_buffer;
 }
 
-CLog::CLog() = default;
+void FormatLogString(int logLevel, const std::chrono::system_clock::time_point& time,
+                     uint64_t threadId, const std::string& logString, std::string& output)
+{
+  static const char* prefixFormat = "%02d:%02d:%02d.%03d T:%" PRIu64" %7s: ";
 
-CLog::~CLog() = default;
+  std::string strData(logString);
+  /* fixup newline alignment, number of spaces should equal prefix length */
+  StringUtils::Replace(strData, "\n", "\n                                            ");
 
-void CLog::Close()
-{
-  CSingleLock waitLock(g_logState.critSec);
-  g_logState.m_platform.CloseLogFile();
-  g_logState.m_repeatLine.clear();
+  int hour, minute, second;
+  double millisecond;
+  PlatformInterfaceForCLog::GetLocalTime(time, hour, minute, second, millisecond);
+
+  if (!output.empty())
+    output += '\n';
+  output += StringUtils::Format(prefixFormat,
+                                hour,
+                                minute,
+                                second,
+                                static_cast<int>(millisecond),
+                                threadId,
+                                levelNames[logLevel]);
+  output += strData;
 }
 
-void CLog::LogString(int logLevel, std::string&& logString)
+/*!
+ Write the lines queued by all threads in the order they were logged.
+ \return true if any line was written.
+ */
+bool FlushBuffers()
 {
+  struct CDropped
+  {
+    uint64_t threadId;
+    unsigned int count;
+  };
+
+  CSingleLock flushLock(g_logState.m_flushSection);
+
+  std::vector<std::pair<uint64_t, std::vector<CLogEntry>>> batches;
+  std::vector<CDropped> dropped;
+  {
+    CSingleLock lock(g_logState.m_buffersSection);
+    for (auto it = g_logState.m_buffers.begin(); it != g_logState.m_buffers.end(); )
+    {
+      CLogBuffer& buffer = **it;
+      // check before popping, lines pushed before closing are popped below
+      const bool closed = buffer.m_closed;
+
+      std::vector<CLogEntry> entries;
+      buffer.Pop(entries);
+      if (!entries.empty())
+        batches.emplace_back(buffer.GetThreadId(), std::move(entries));
+
+      const unsigned int count = buffer.TakeDropped();
+      if (count)
+        dropped.push_back({buffer.GetThreadId(), count});
+
+      if (closed)
+        it = g_logState.m_buffers.erase(it);
+      else
+        ++it;
+    }
+  }
+
+  if (batches.empty() && dropped.empty())
+    return false;
+
+  struct CLine
+  {
+    const CLogEntry* entry;
+    uint64_t threadId;
+  };
+  std::vector<CLine> lines;
+  for (const auto& batch : batches)
+  {
+    for (const auto& entry : batch.second)
+      lines.push_back({&entry, batch.first});
+  }
+  std::sort(lines.begin(), lines.end(), [](const CLine& lhs, const CLine& rhs)
+  {
+    return lhs.entry->sequence < rhs.entry->sequence;
+  });
+
+  // the whole batch is written at once
+  std::string output;
+
   CSingleLock waitLock(g_logState.critSec);
-  std::string strData(logString);
-  StringUtils::TrimRight(strData);
-  if (!strData.empty())
+  for (const auto& line : lines)
   {
-    if (g_logState.m_repeatLogLevel == logLevel && g_logState.m_repeatLine == strData)
+    const CLogEntry& entry = *line.entry;
+    std::string strData(entry.line);
+    StringUtils::TrimRight(strData);
+    if (strData.empty())
+      continue;
+
+    if (g_logState.m_repeatLogLevel == entry.logLevel && g_logState.m_repeatLine == strData)
     {
       g_logState.m_repeatCount++;
-      return;
+      continue;
     }
     else if (g_logState.m_repeatCount)
     {
       std::string strData2 = StringUtils::Format("Previous line repeats %d times.",
                                                 g_logState.m_repeatCount);
-      PrintDebugString(strData2);
-      WriteLogString(g_logState.m_repeatLogLevel, strData2);
+      CLog::PrintDebugString(strData2);
+      FormatLogString(g_logState.m_repeatLogLevel, entry.time, line.threadId, strData2, output);
       g_logState.m_repeatCount = 0;
     }
 
     g_logState.m_repeatLine = strData;
-    g_logState.m_repeatLogLevel = logLevel;
+    g_logState.m_repeatLogLevel = entry.logLevel;
+
+    CLog::PrintDebugString(strData);
+
+    FormatLogString(entry.logLevel, entry.time, line.threadId, strData, output);
+  }
+
+  for (const auto& drop : dropped)
+  {
+    g_logState.m_droppedLines += drop.count;
+    FormatLogString(LOGWARNING, std::chrono::system_clock::now(), drop.threadId,
+                    StringUtils::Format("Dropped %u lines, logging faster than they can be written", drop.count),
+                    output);
+  }
+
+  if (!output.empty())
+    g_logState.m_platform.WriteStringToLog(output);
+
+  return true;
+}
+
+void CLogWriter::Process()
+{
+  while (!m_bStop)
+  {
+    if (FlushBuffers())
+      continue;
+
+    // announce that we are about to sleep and check once more, so that lines
+    // logged in between either get picked up here or wake us up
+    g_logState.m_writerSleeping = true;
+    if (!FlushBuffers())
+      AbortableWait(g_logState.m_writerEvent, 1000);
+    g_logState.m_writerSleeping = false;
+  }
+}
+}
+
+CLog::CLog() = default;
+
+CLog::~CLog() = default;
+
+void CLog::Close()
+{
+  std::unique_ptr<CLogWriter> writer;
+  {
+    CSingleLock waitLock(g_logState.critSec);
+    writer = std::move(g_logState.m_writer);
+  }
+  if (writer)
+    writer->StopThread(true);
 
-    PrintDebugString(strData);
+  // write whatever was logged up to now, including the writer shutting down
+  FlushBuffers();
 
-    WriteLogString(logLevel, strData);
+  CSingleLock waitLock(g_logState.critSec);
+  g_logState.m_fileOpen = false;
+  g_logState.m_platform.CloseLogFile();
+  g_logState.m_repeatLine.clear();
+}
+
+void CLog::LogString(int logLevel, std::string&& logString)
+{
+  CLogEntry entry;
+  entry.sequence = g_logState.m_sequence++;
+  entry.time = std::chrono::system_clock::now();
+  entry.logLevel = logLevel;
+  entry.line = std::move(logString);
+
+  // the lines explaining a crash must not be left in the queue, write them
+  // together with everything logged before them before returning
+  if ((logLevel & LOGMASK) >= LOGSEVERE && g_logState.m_fileOpen)
+  {
+    CLogBuffer& buffer = GetThreadBuffer();
+    if (!buffer.Push(std::move(entry)))
+    {
+      FlushBuffers();
+      buffer.Push(std::move(entry));
+    }
+    FlushBuffers();
+    return;
   }
+
+  GetThreadBuffer().Push(std::move(entry));
+
+  if (g_logState.m_writerSleeping.exchange(false))
+    g_logState.m_writerEvent.Set();
 }
 
 void CLog::LogString(int logLevel, int component, std::string&& logString)
@@ -104,7 +376,16 @@ bool CLog::Init(const std::string& path)
 
   std::string appName = CCompileInfo::GetAppName();
   StringUtils::ToLower(appName);
-  return g_logState.m_platform.OpenLogFile(path + appName + ".log", path + appName + ".old.log");
+  if (!g_logState.m_platform.OpenLogFile(path + appName + ".log", path + appName + ".old.log"))
+    return false;
+  g_logState.m_fileOpen = true;
+
+  if (!g_logState.m_writer)
+  {
+    g_logState.m_writer.reset(new CLogWriter());
+    g_logState.m_writer->Create();
+  }
+  return true;
 }
 
 void CLog::MemDump(char *pData, int length)
@@ -150,6 +431,11 @@ void CLog::SetLogLevel(int level)
     CLog::Log(LOGERROR, "%s: Invalid log level requested: %d", __FUNCTION__, level);
 }
 
+unsigned int CLog::GetDroppedLines()
+{
+  return g_logState.m_droppedLines;
+}
+
 int CLog::GetLogLevel()
 {
   return g_logState.m_logLevel;
@@ -183,26 +469,3 @@ void CLog::PrintDebugString(const std::string& line)
   g_logState.m_platform.PrintDebugString(line);
 #endif // defined(_DEBUG) || defined(PROFILE)
 }
-
-bool CLog::WriteLogString(int logLevel, const std::string& logString)
-{
-  static const char* prefixFormat = "%02d:%02d:%02d.%03d T:%" PRIu64" %7s: ";
-
-  std::string strData(logString);
-  /* fixup newline alignment, number of spaces should equal prefix length */
-  StringUtils::Replace(strData, "\n", "\n                                            ");
-
-  int hour, minute, second;
-  double millisecond;
-  g_logState.m_platform.GetCurrentLocalTime(hour, minute, second, millisecond);
-
-  strData = StringUtils::Format(prefixFormat,
-                                  hour,
-                                  minute,
-                                  second,
-                                  static_cast<int>(millisecond),
-                                  (uint64_t)CThread::GetCurrentThreadId(),
-                                  levelNames[logLevel]) + strData;
-
-  return g_logState.m_platform.WriteStringToLog(strData);
-}
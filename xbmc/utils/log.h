@@ -97,9 +97,15 @@ public:
   static int  GetLogLevel();
   static void SetExtraLogLevels(int level);
   static bool IsLogLevelLogged(int loglevel);
+  /*! \brief Number of lines dropped since startup as a thread logged faster than they could be written.
+   */
+  static unsigned int GetDroppedLines();
 
 protected:
+  /*! \brief Queue a line for the log writer thread.
+   The time is captured here, formatting and writing the line is left to the writer thread.
+   LOGSEVERE and LOGFATAL lines are written, along with the queued lines, before returning.
+   */
   static void LogString(int logLevel, std::string&& logString);
   static void LogString(int logLevel, int component, std::string&& logString);
-  static bool WriteLogString(int logLevel, const std::string& logString);
 };
@@ -170,3 +170,69 @@ TEST_F(TestJobManager, IsProcessing)
 
   job->FinishAndStopBlocking();
 }
+
+namespace
+{
+std::atomic<int> groupJobs[2];
+std::atomic<int> maxGroupJobs(0);
+std::atomic<int> runningJobs(0);
+std::atomic<int> maxRunningJobs(0);
+
+void UpdateMax(std::atomic<int> &max, int value)
+{
+  int current = max;
+  while (value > current && !max.compare_exchange_weak(current, value));
+}
+
+class GroupJob : public CJob
+{
+public:
+  explicit GroupJob(int group) : m_group(group) {}
+
+  bool DoWork() override
+  {
+    UpdateMax(maxGroupJobs, ++groupJobs[m_group]);
+    UpdateMax(maxRunningJobs, ++runningJobs);
+    Sleep(100);
+    --runningJobs;
+    --groupJobs[m_group];
+    return true;
+  }
+
+  int m_group;
+};
+
+// runs two jobs at once, but only one job of each group
+class GroupJobQueue : public CJobQueue
+{
+public:
+  GroupJobQueue() : CJobQueue(false, 2) {}
+
+protected:
+  bool CanStartJob(const CJob *job, const std::vector<const CJob*> &processing) const override
+  {
+    for (const auto &it : processing)
+    {
+      if (static_cast<const GroupJob*>(it)->m_group == static_cast<const GroupJob*>(job)->m_group)
+        return false;
+    }
+    return true;
+  }
+};
+}
+
+TEST_F(TestJobManager, JobQueueCanStartJob)
+{
+  GroupJobQueue queue;
+  queue.AddJob(new GroupJob(0));
+  queue.AddJob(new GroupJob(0));
+  // starts alongside the first job, although the second one is queued before it
+  queue.AddJob(new GroupJob(1));
+
+  for (int i = 0; i < 50 && queue.IsProcessing(); i++)
+    Sleep(20);
+
+  EXPECT_FALSE(queue.IsProcessing());
+  EXPECT_EQ(1, maxGroupJobs);
+  EXPECT_EQ(2, maxRunningJobs);
+}
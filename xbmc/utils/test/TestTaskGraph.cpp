@@ -0,0 +1,123 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "threads/Thread.h"
+#include "utils/TaskGraph.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <atomic>
+
+#ifdef TARGET_POSIX
+#include "platform/linux/XTimeUtils.h"
+#endif
+
+namespace
+{
+size_t Position(const std::vector<std::string> &finished, const std::string &name)
+{
+  return std::find(finished.begin(), finished.end(), name) - finished.begin();
+}
+}
+
+TEST(TestTaskGraph, Add)
+{
+  CTaskGraph graph("test");
+  auto task = []() { return true; };
+
+  EXPECT_TRUE(graph.Add("a", {}, task));
+  EXPECT_TRUE(graph.Add("b", {"a"}, task));
+  EXPECT_FALSE(graph.Add("a", {}, task));
+  EXPECT_FALSE(graph.Add("c", {"d"}, task));
+}
+
+TEST(TestTaskGraph, Sequential)
+{
+  CTaskGraph graph("test");
+  std::vector<std::string> order;
+  auto task = [&order](const std::string &name)
+  {
+    return [&order, name]() { order.push_back(name); return true; };
+  };
+  graph.Add("a", {}, task("a"));
+  graph.Add("b", {}, task("b"), true);
+  graph.Add("c", {}, task("c"));
+  graph.Add("d", {"a"}, task("d"), true);
+  graph.Add("e", {}, task("e"), true);
+  graph.Add("f", {"c"}, task("f"));
+
+  // tasks of the calling thread don't overtake the others
+  EXPECT_TRUE(graph.Run(1));
+  std::vector<std::string> expected = {"a", "b", "c", "d", "e", "f"};
+  EXPECT_EQ(expected, order);
+  EXPECT_EQ(expected, graph.GetFinished());
+}
+
+TEST(TestTaskGraph, Parallel)
+{
+  CTaskGraph graph("test");
+  std::atomic<int> running(0);
+  std::atomic<int> maxRunning(0);
+  auto task = [&running, &maxRunning]()
+  {
+    int now = ++running;
+    int max = maxRunning;
+    while (now > max && !maxRunning.compare_exchange_weak(max, now))
+      ;
+    Sleep(50);
+    running--;
+    return true;
+  };
+
+  graph.Add("a", {}, task);
+  graph.Add("b", {}, task);
+  graph.Add("c", {}, task);
+  graph.Add("d", {"a", "b"}, task);
+  graph.Add("e", {"d", "c"}, task);
+
+  EXPECT_TRUE(graph.Run(4));
+  std::vector<std::string> finished = graph.GetFinished();
+  ASSERT_EQ(5u, finished.size());
+  EXPECT_LT(Position(finished, "a"), Position(finished, "d"));
+  EXPECT_LT(Position(finished, "b"), Position(finished, "d"));
+  EXPECT_LT(Position(finished, "d"), Position(finished, "e"));
+  EXPECT_LT(Position(finished, "c"), Position(finished, "e"));
+  EXPECT_LE(maxRunning, 4);
+  EXPECT_GT(maxRunning, 1);
+}
+
+TEST(TestTaskGraph, CallingThread)
+{
+  CTaskGraph graph("test");
+  ThreadIdentifier caller = CThread::GetCurrentThreadId();
+  bool onCaller = false;
+
+  graph.Add("a", {}, []() { Sleep(20); return true; });
+  graph.Add("b", {"a"}, [&onCaller, caller]()
+  {
+    onCaller = CThread::GetCurrentThreadId() == caller;
+    return true;
+  }, true);
+
+  EXPECT_TRUE(graph.Run(4));
+  EXPECT_TRUE(onCaller);
+}
+
+TEST(TestTaskGraph, Failure)
+{
+  CTaskGraph graph("test");
+  std::atomic<bool> dependentRun(false);
+
+  graph.Add("a", {}, []() { return false; });
+  graph.Add("b", {"a"}, [&dependentRun]() { dependentRun = true; return true; });
+
+  EXPECT_FALSE(graph.Run(2));
+  EXPECT_FALSE(dependentRun);
+  EXPECT_TRUE(graph.GetFinished().empty());
+}
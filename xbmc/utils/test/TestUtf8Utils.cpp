@@ -0,0 +1,112 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "utils/CharsetConverter.h"
+#include "utils/Utf8Utils.h"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+
+TEST(TestUtf8Utils, IsAscii)
+{
+  EXPECT_TRUE(CUtf8Utils::IsAscii(""));
+  EXPECT_TRUE(CUtf8Utils::IsAscii("plain US-ASCII text which is longer than sixteen characters"));
+  EXPECT_FALSE(CUtf8Utils::IsAscii("plain US-ASCII text until here: \xC3\xA9"));
+  EXPECT_FALSE(CUtf8Utils::IsAscii("\xC3\xA9"));
+}
+
+TEST(TestUtf8Utils, Utf8ToUtf32)
+{
+  std::u32string utf32;
+  EXPECT_TRUE(CUtf8Utils::Utf8ToUtf32("", utf32));
+  EXPECT_TRUE(utf32.empty());
+
+  EXPECT_TRUE(CUtf8Utils::Utf8ToUtf32("Long enough to take the vector path: caf\xC3\xA9 \xE2\x82\xAC \xF0\x9F\x98\x80", utf32));
+  EXPECT_EQ(U"Long enough to take the vector path: caf\u00E9 \u20AC \U0001F600", utf32);
+}
+
+TEST(TestUtf8Utils, Utf8ToUtf16)
+{
+  std::u16string utf16;
+  EXPECT_TRUE(CUtf8Utils::Utf8ToUtf16("caf\xC3\xA9 \xF0\x9F\x98\x80", utf16));
+  EXPECT_EQ(u"caf\u00E9 \U0001F600", utf16);
+}
+
+TEST(TestUtf8Utils, Utf8ToUtf32Invalid)
+{
+  // truncated, overlong, surrogate and out of range sequences
+  const std::string invalid[] = { "a\xE2\x82", "a\xC0\xAF", "a\xE0\x80\xAF", "a\xED\xA0\x80", "a\xF4\x90\x80\x80", "a\xFF" };
+  for (const auto& str : invalid)
+  {
+    std::u32string utf32;
+    EXPECT_FALSE(CUtf8Utils::Utf8ToUtf32(str, utf32, true));
+    EXPECT_TRUE(utf32.empty());
+  }
+
+  // invalid bytes are skipped the same way iconv does
+  std::u32string utf32;
+  EXPECT_TRUE(CUtf8Utils::Utf8ToUtf32("a\xE2\x82z\xFF\xC3\xA9", utf32, false));
+  EXPECT_EQ(U"az\u00E9", utf32);
+}
+
+TEST(TestUtf8Utils, Utf32ToUtf8)
+{
+  std::string utf8;
+  EXPECT_TRUE(CUtf8Utils::Utf32ToUtf8(U"caf\u00E9 \u20AC \U0001F600", utf8));
+  EXPECT_EQ("caf\xC3\xA9 \xE2\x82\xAC \xF0\x9F\x98\x80", utf8);
+
+  std::u32string invalid = U"a";
+  invalid.push_back(0xD800);
+  invalid.push_back(0x110000);
+  invalid.push_back(U'b');
+  EXPECT_TRUE(CUtf8Utils::Utf32ToUtf8(invalid, utf8, false));
+  EXPECT_EQ("ab", utf8);
+  EXPECT_FALSE(CUtf8Utils::Utf32ToUtf8(invalid, utf8, true));
+  EXPECT_TRUE(utf8.empty());
+}
+
+TEST(TestUtf8Utils, WToUtf8)
+{
+  std::wstring wstr;
+  EXPECT_TRUE(CUtf8Utils::Utf8ToW("caf\xC3\xA9 \xF0\x9F\x98\x80", wstr));
+  std::string utf8;
+  EXPECT_TRUE(CUtf8Utils::WToUtf8(wstr, utf8));
+  EXPECT_EQ("caf\xC3\xA9 \xF0\x9F\x98\x80", utf8);
+}
+
+TEST(TestUtf8Utils, Throughput)
+{
+  // typical labels, mostly US-ASCII with some accented characters and symbols
+  std::string text;
+  for (int i = 0; i < 10000; i++)
+    text += (i % 10) ? "Some label text " : "Caf\xC3\xA9 \xE2\x82\xAC ";
+
+  const int rounds = 20;
+  std::u32string direct;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < rounds; i++)
+    CUtf8Utils::Utf8ToUtf32(text, direct);
+  auto directTime = std::chrono::steady_clock::now() - start;
+
+  std::u32string viaIconv;
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < rounds; i++)
+    CCharsetConverter::utf8To("UTF-32LE", text, viaIconv);
+  auto iconvTime = std::chrono::steady_clock::now() - start;
+
+#ifndef WORDS_BIGENDIAN
+  EXPECT_EQ(viaIconv, direct);
+#endif
+
+  const double megabytes = static_cast<double>(text.size()) * rounds / 1000000;
+  RecordProperty("utf8_to_utf32_mb_per_second",
+                 static_cast<int>(megabytes / std::chrono::duration<double>(directTime).count()));
+  RecordProperty("iconv_mb_per_second",
+                 static_cast<int>(megabytes / std::chrono::duration<double>(iconvTime).count()));
+}
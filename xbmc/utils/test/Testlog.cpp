@@ -18,6 +18,10 @@
 
 #include "gtest/gtest.h"
 
+#include <chrono>
+#include <thread>
+#include <vector>
+
 class Testlog : public testing::Test
 {
 protected:
@@ -139,3 +143,58 @@ TEST_F(Testlog, SetLogLevel)
   CLog::Close();
   EXPECT_TRUE(XFILE::CFile::Delete(logfile));
 }
+
+TEST_F(Testlog, Threads)
+{
+  std::string appName = CCompileInfo::GetAppName();
+  StringUtils::ToLower(appName);
+  std::string logfile = CSpecialProtocol::TranslatePath("special://temp/") + appName + ".log";
+
+  const int linesPerThread = 2000;
+  for (int threadCount : {1, 2, 4, 8})
+  {
+    EXPECT_TRUE(CLog::Init(CSpecialProtocol::TranslatePath("special://temp/").c_str()));
+    unsigned int dropped = CLog::GetDroppedLines();
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < threadCount; i++)
+    {
+      threads.emplace_back([i, linesPerThread]()
+      {
+        for (int line = 0; line < linesPerThread; line++)
+          CLog::Log(LOGDEBUG, "threaded log message %d/%d", i, line);
+      });
+    }
+    for (auto& thread : threads)
+      thread.join();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    CLog::Close();
+    dropped = CLog::GetDroppedLines() - dropped;
+
+    std::string logstring;
+    char buf[4096];
+    unsigned int bytesread;
+    XFILE::CFile file;
+    EXPECT_TRUE(file.Open(logfile));
+    while ((bytesread = file.Read(buf, sizeof(buf) - 1)) > 0)
+    {
+      buf[bytesread] = '\0';
+      logstring.append(buf);
+    }
+    file.Close();
+
+    // every line is either written or accounted for as dropped
+    int written = 0;
+    for (size_t pos = logstring.find("threaded log message"); pos != std::string::npos;
+         pos = logstring.find("threaded log message", pos + 1))
+      written++;
+    EXPECT_EQ(threadCount * linesPerThread, written + static_cast<int>(dropped));
+
+    RecordProperty("calls_per_second_" + std::to_string(threadCount) + "_threads",
+                   static_cast<int>(threadCount * linesPerThread / elapsed.count()));
+  }
+
+  EXPECT_TRUE(XFILE::CFile::Delete(logfile));
+}
@@ -68,6 +68,12 @@ using namespace ADDON;
 using namespace KODI::MESSAGING;
 using namespace KODI::GUILIB;
 
+namespace
+{
+// link tables whose navigation nodes are served from the link_count table
+const char *LinkCountTables[] = { "genre", "country", "studio", "tag" };
+}
+
 //********************************************************************************************************************************
 CVideoDatabase::CVideoDatabase(void) = default;
 
@@ -192,6 +198,9 @@ void CVideoDatabase::CreateTables()
 
   CLog::Log(LOGINFO, "create uniqueid table");
   m_pDS->exec("CREATE TABLE uniqueid (uniqueid_id INTEGER PRIMARY KEY, media_id INTEGER, media_type TEXT, value TEXT, type TEXT)");
+
+  CLog::Log(LOGINFO, "create link_count table");
+  m_pDS->exec("CREATE TABLE link_count (link_type TEXT, media_type TEXT, link_id INTEGER, item_count INTEGER, watched_count INTEGER)");
 }
 
 void CVideoDatabase::CreateLinkIndex(const char *table)
@@ -323,9 +332,6 @@ void CVideoDatabase::CreateAnalytics()
   m_pDS->exec("CREATE TRIGGER delete_person AFTER DELETE ON actor FOR EACH ROW BEGIN "
               "DELETE FROM art WHERE media_id=old.actor_id AND media_type IN ('actor','artist','writer','director'); "
               "END");
-  m_pDS->exec("CREATE TRIGGER delete_tag AFTER DELETE ON tag_link FOR EACH ROW BEGIN "
-              "DELETE FROM tag WHERE tag_id=old.tag_id AND tag_id NOT IN (SELECT DISTINCT tag_id FROM tag_link); "
-              "END");
   m_pDS->exec("CREATE TRIGGER delete_file AFTER DELETE ON files FOR EACH ROW BEGIN "
               "DELETE FROM bookmark WHERE idFile=old.idFile; "
               "DELETE FROM settings WHERE idFile=old.idFile; "
@@ -333,7 +339,110 @@ void CVideoDatabase::CreateAnalytics()
               "DELETE FROM streamdetails WHERE idFile=old.idFile; "
               "END");
 
+  CreateLinkCountTriggers();
+
   CreateViews();
+
+  RebuildLinkCounts();
+}
+
+std::string CVideoDatabase::GetLinkCountFilter(const char *mediaType, const std::string &mediaCondition)
+{
+  std::string links;
+  for (const char *table : LinkCountTables)
+  {
+    if (!links.empty())
+      links += " OR ";
+    links += PrepareSQL("(link_count.link_type='%s' AND link_count.link_id IN "
+                        "(SELECT %s_id FROM %s_link WHERE %s_link.media_type='%s' AND %s_link.%s))",
+                        table, table, table, table, mediaType, table, mediaCondition.c_str());
+  }
+  return PrepareSQL("(link_count.media_type='%s' AND (%s))", mediaType, links.c_str());
+}
+
+void CVideoDatabase::CreateLinkCountTriggers()
+{
+  CLog::Log(LOGINFO, "%s - creating link count triggers", __FUNCTION__);
+  m_pDS->exec("CREATE UNIQUE INDEX ix_link_count ON link_count (link_type(20), media_type(20), link_id)");
+
+  for (const char *table : LinkCountTables)
+  {
+    // number of watched movies or music videos the link refers to (0 or 1)
+    std::string watched = "(SELECT COUNT(1) FROM movie JOIN files ON files.idFile=movie.idFile "
+                            "WHERE %s.media_type='movie' AND movie.idMovie=%s.media_id AND files.playCount IS NOT NULL) + "
+                          "(SELECT COUNT(1) FROM musicvideo JOIN files ON files.idFile=musicvideo.idFile "
+                            "WHERE %s.media_type='musicvideo' AND musicvideo.idMVideo=%s.media_id AND files.playCount IS NOT NULL)";
+    std::string watchedNew = StringUtils::Format(watched.c_str(), "new", "new", "new", "new");
+    std::string watchedOld = StringUtils::Format(watched.c_str(), "old", "old", "old", "old");
+
+    m_pDS->exec(PrepareSQL("CREATE TRIGGER insert_%s_link AFTER INSERT ON %s_link FOR EACH ROW BEGIN "
+                           "INSERT INTO link_count (link_type, media_type, link_id, item_count, watched_count) "
+                             "SELECT '%s', new.media_type, new.%s_id, 0, 0 FROM %s WHERE %s.%s_id=new.%s_id AND NOT EXISTS "
+                             "(SELECT 1 FROM link_count WHERE link_type='%s' AND media_type=new.media_type AND link_id=new.%s_id); "
+                           "UPDATE link_count SET item_count=item_count+1, watched_count=watched_count+%s "
+                             "WHERE link_type='%s' AND media_type=new.media_type AND link_id=new.%s_id; "
+                           "END",
+                           table, table,
+                           table, table, table, table, table, table,
+                           table, table,
+                           watchedNew.c_str(), table, table));
+
+    // there can only be one trigger per table and event on older MySQL versions,
+    // so the deletion of orphaned tags is done here as well
+    std::string extra;
+    if (StringUtils::EqualsNoCase(table, "tag"))
+      extra = "DELETE FROM tag WHERE tag_id=old.tag_id AND tag_id NOT IN (SELECT DISTINCT tag_id FROM tag_link); ";
+
+    m_pDS->exec(PrepareSQL("CREATE TRIGGER delete_%s_link AFTER DELETE ON %s_link FOR EACH ROW BEGIN "
+                           "UPDATE link_count SET item_count=item_count-1, watched_count=watched_count-(%s) "
+                             "WHERE link_type='%s' AND media_type=old.media_type AND link_id=old.%s_id; "
+                           "DELETE FROM link_count WHERE link_type='%s' AND media_type=old.media_type AND link_id=old.%s_id AND item_count<=0; "
+                           "%s"
+                           "END",
+                           table, table,
+                           watchedOld.c_str(), table, table,
+                           table, table,
+                           extra.c_str()));
+  }
+
+  // the links of a deleted movie or music video are removed after the item itself,
+  // so its watched state has to be accounted for before it is gone
+  m_pDS->exec("CREATE TRIGGER delete_movie_link_count BEFORE DELETE ON movie FOR EACH ROW BEGIN "
+              "UPDATE link_count SET watched_count=watched_count-1 WHERE " +
+              GetLinkCountFilter("movie", "media_id=old.idMovie") + " AND "
+              "EXISTS (SELECT 1 FROM files WHERE files.idFile=old.idFile AND files.playCount IS NOT NULL); "
+              "END");
+  m_pDS->exec("CREATE TRIGGER delete_musicvideo_link_count BEFORE DELETE ON musicvideo FOR EACH ROW BEGIN "
+              "UPDATE link_count SET watched_count=watched_count-1 WHERE " +
+              GetLinkCountFilter("musicvideo", "media_id=old.idMVideo") + " AND "
+              "EXISTS (SELECT 1 FROM files WHERE files.idFile=old.idFile AND files.playCount IS NOT NULL); "
+              "END");
+
+  m_pDS->exec("CREATE TRIGGER update_file_link_count AFTER UPDATE ON files FOR EACH ROW BEGIN "
+              "UPDATE link_count SET watched_count=watched_count+(new.playCount IS NOT NULL)-(old.playCount IS NOT NULL) "
+              "WHERE (new.playCount IS NULL)<>(old.playCount IS NULL) AND (" +
+              GetLinkCountFilter("movie", "media_id IN (SELECT idMovie FROM movie WHERE movie.idFile=new.idFile)") + " OR " +
+              GetLinkCountFilter("musicvideo", "media_id IN (SELECT idMVideo FROM musicvideo WHERE musicvideo.idFile=new.idFile)") + "); "
+              "END");
+}
+
+void CVideoDatabase::RebuildLinkCounts()
+{
+  CLog::Log(LOGINFO, "%s - rebuilding link counts", __FUNCTION__);
+  m_pDS->exec("DELETE FROM link_count");
+  for (const char *table : LinkCountTables)
+  {
+    m_pDS->exec(PrepareSQL("INSERT INTO link_count (link_type, media_type, link_id, item_count, watched_count) "
+                           "SELECT '%s', %s_link.media_type, %s_link.%s_id, COUNT(1), COUNT(files.playCount) FROM %s_link "
+                           "LEFT JOIN movie ON %s_link.media_type='movie' AND movie.idMovie=%s_link.media_id "
+                           "LEFT JOIN musicvideo ON %s_link.media_type='musicvideo' AND musicvideo.idMVideo=%s_link.media_id "
+                           "LEFT JOIN files ON files.idFile=COALESCE(movie.idFile, musicvideo.idFile) "
+                           "GROUP BY %s_link.media_type, %s_link.%s_id",
+                           table, table, table, table, table,
+                           table, table,
+                           table, table,
+                           table, table, table));
+  }
 }
 
 void CVideoDatabase::CreateViews()
@@ -5348,11 +5457,15 @@ void CVideoDatabase::UpdateTables(int iVersion)
 
   if (iVersion < 112)
     m_pDS->exec("ALTER TABLE settings ADD CenterMixLevel integer");
+
+  // filled in CreateAnalytics()
+  if (iVersion < 113)
+    m_pDS->exec("CREATE TABLE link_count (link_type TEXT, media_type TEXT, link_id INTEGER, item_count INTEGER, watched_count INTEGER)");
 }
 
 int CVideoDatabase::GetSchemaVersion() const
 {
-  return 112;
+  return 113;
 }
 
 bool CVideoDatabase::LookupByFolders(const std::string &path, bool shows)
@@ -5729,9 +5842,22 @@ bool CVideoDatabase::GetNavCommon(const std::string& strBaseDir, CFileItemList&
     if (NULL == m_pDB.get()) return false;
     if (NULL == m_pDS.get()) return false;
 
+    bool locked = m_profileManager.GetMasterProfile().getLockMode() != LOCK_MODE_EVERYONE && !g_passwordManager.bMasterUser;
+    if (!locked && filter.where.empty() && filter.join.empty() && filter.limit.empty())
+    {
+      // without any conditions on the items the whole library is grouped, which is
+      // exactly what the link_count table holds
+      CVideoDbUrl videoUrl;
+      Filter optionFilter;
+      SortDescription sorting;
+      if (videoUrl.FromString(strBaseDir) && GetFilter(videoUrl, optionFilter, sorting) &&
+          optionFilter.where.empty() && optionFilter.join.empty())
+        return GetNavFromLinkCounts(videoUrl, items, type, idContent, countOnly);
+    }
+
     std::string strSQL;
     Filter extFilter = filter;
-    if (m_profileManager.GetMasterProfile().getLockMode() != LOCK_MODE_EVERYONE && !g_passwordManager.bMasterUser)
+    if (locked)
     {
       std::string view, view_id, media_type, extraField, extraJoin;
       if (idContent == VIDEODB_CONTENT_MOVIES)
@@ -5833,7 +5959,7 @@ bool CVideoDatabase::GetNavCommon(const std::string& strBaseDir, CFileItemList&
       return true;
     }
 
-    if (m_profileManager.GetMasterProfile().getLockMode() != LOCK_MODE_EVERYONE && !g_passwordManager.bMasterUser)
+    if (locked)
     {
       std::map<int, std::pair<std::string,int> > mapItems;
       while (!m_pDS->eof())
@@ -5913,6 +6039,59 @@ bool CVideoDatabase::GetNavCommon(const std::string& strBaseDir, CFileItemList&
   return false;
 }
 
+bool CVideoDatabase::GetNavFromLinkCounts(const CVideoDbUrl &videoUrl, CFileItemList& items, const char *type, int idContent, bool countOnly)
+{
+  std::string mediaType;
+  if (idContent == VIDEODB_CONTENT_MOVIES)
+    mediaType = MediaTypeMovie;
+  else if (idContent == VIDEODB_CONTENT_TVSHOWS)
+    mediaType = MediaTypeTvShow;
+  else if (idContent == VIDEODB_CONTENT_MUSICVIDEOS)
+    mediaType = MediaTypeMusicVideo;
+  else
+    return false;
+
+  if (countOnly)
+  {
+    std::string strSQL = PrepareSQL("SELECT COUNT(1) FROM link_count WHERE link_type='%s' AND media_type='%s'", type, mediaType.c_str());
+    CFileItemPtr pItem(new CFileItem());
+    pItem->SetProperty("total", static_cast<int>(strtol(GetSingleValue(strSQL).c_str(), NULL, 10)));
+    items.Add(pItem);
+    return true;
+  }
+
+  std::string strSQL = PrepareSQL("SELECT %s.%s_id, %s.name, link_count.item_count, link_count.watched_count FROM link_count "
+                                  "JOIN %s ON %s.%s_id = link_count.link_id "
+                                  "WHERE link_count.link_type='%s' AND link_count.media_type='%s'",
+                                  type, type, type,
+                                  type, type, type,
+                                  type, mediaType.c_str());
+  int iRowsFound = RunQuery(strSQL);
+  if (iRowsFound <= 0)
+    return iRowsFound == 0;
+
+  while (!m_pDS->eof())
+  {
+    CFileItemPtr pItem(new CFileItem(m_pDS->fv(1).get_asString()));
+    pItem->GetVideoInfoTag()->m_iDbId = m_pDS->fv(0).get_asInt();
+    pItem->GetVideoInfoTag()->m_type = type;
+
+    CVideoDbUrl itemUrl = videoUrl;
+    std::string path = StringUtils::Format("%i/", m_pDS->fv(0).get_asInt());
+    itemUrl.AppendPath(path);
+    pItem->SetPath(itemUrl.ToString());
+
+    pItem->m_bIsFolder = true;
+    pItem->SetLabelPreformatted(true);
+    if (idContent == VIDEODB_CONTENT_MOVIES || idContent == VIDEODB_CONTENT_MUSICVIDEOS)
+      pItem->GetVideoInfoTag()->SetPlayCount((m_pDS->fv(3).get_asInt() == m_pDS->fv(2).get_asInt()) ? 1 : 0);
+    items.Add(pItem);
+    m_pDS->next();
+  }
+  m_pDS->close();
+  return true;
+}
+
 bool CVideoDatabase::GetTagsNav(const std::string& strBaseDir, CFileItemList& items, int idContent /* = -1 */, const Filter &filter /* = Filter() */, bool countOnly /* = false */)
 {
   return GetNavCommon(strBaseDir, items, "tag", idContent, filter, countOnly);
@@ -8811,6 +8990,9 @@ void CVideoDatabase::CleanDatabase(CGUIDialogProgressBarHandle* handle, const st
     sql = "DELETE FROM sets WHERE NOT EXISTS (SELECT 1 FROM movie WHERE movie.idSet = sets.idSet)";
     m_pDS->exec(sql);
 
+    CLog::Log(LOGDEBUG, LOGDATABASE, "%s: Rebuilding link counts", __FUNCTION__);
+    RebuildLinkCounts();
+
     CommitTransaction();
 
     if (handle)
@@ -929,6 +929,11 @@ protected:
   CVideoInfoTag GetDetailsForMusicVideo(const dbiplus::sql_record* const record, int getDetails = VideoDbDetailsNone);
   bool GetPeopleNav(const std::string& strBaseDir, CFileItemList& items, const char *type, int idContent = -1, const Filter &filter = Filter(), bool countOnly = false);
   bool GetNavCommon(const std::string& strBaseDir, CFileItemList& items, const char *type, int idContent=-1, const Filter &filter = Filter(), bool countOnly = false);
+
+  /*! \brief Get the genre, country, studio or tag nodes of the whole library from the link_count table.
+   \sa GetNavCommon
+   */
+  bool GetNavFromLinkCounts(const CVideoDbUrl &videoUrl, CFileItemList& items, const char *type, int idContent, bool countOnly);
   void GetCast(int media_id, const std::string &media_type, std::vector<SActorInfo> &cast);
   void GetTags(int media_id, const std::string &media_type, std::vector<std::string> &tags);
   void GetRatings(int media_id, const std::string &media_type, RatingMap &ratings);
@@ -945,6 +950,22 @@ private:
   void CreateLinkIndex(const char *table);
   void CreateForeignLinkIndex(const char *table, const char *foreignkey);
 
+  /*! \brief Create the triggers keeping the link_count table up to date.
+   link_count holds the number of (watched) items per genre, country, studio and tag
+   and media type, so the respective navigation nodes don't have to group the whole library.
+   */
+  void CreateLinkCountTriggers();
+
+  /*! \brief Refill the link_count table from the link tables.
+   */
+  void RebuildLinkCounts();
+
+  /*! \brief Build a condition matching the link_count rows of the links of the given items.
+   \param mediaType the media type of the items
+   \param mediaCondition condition on media_id of the link tables selecting the items
+   */
+  std::string GetLinkCountFilter(const char *mediaType, const std::string &mediaCondition);
+
   /*! \brief (Re)Create the generic database views for movies, tvshows,
      episodes and music videos
    */
@@ -60,6 +60,7 @@ namespace VIDEO
 {
 
   CVideoInfoScanner::CVideoInfoScanner()
+    : m_snapshot("special://database/VideoDirectorySnapshot.xml")
   {
     m_bStop = false;
     m_scanAll = false;
@@ -101,6 +102,20 @@ namespace VIDEO
 
       m_database.Open();
 
+      if (g_advancedSettings.m_bVideoLibraryUseDirectorySnapshot)
+      {
+        m_snapshot.Load();
+
+        // stat all the paths we're about to scan in one go
+        std::vector<std::string> paths;
+        for (const auto &path : m_pathsToScan)
+        {
+          if (!URIUtils::IsPlugin(path))
+            paths.push_back(path);
+        }
+        m_snapshot.PrefetchModificationTimes(paths);
+      }
+
       m_bCanInterrupt = true;
 
       CLog::Log(LOGNOTICE, "VideoInfoScanner: Starting scan ..");
@@ -139,6 +154,9 @@ namespace VIDEO
           bCancelled = true;
       }
 
+      if (g_advancedSettings.m_bVideoLibraryUseDirectorySnapshot)
+        m_snapshot.Save();
+
       if (!bCancelled)
       {
         if (m_bClean)
@@ -268,6 +286,8 @@ namespace VIDEO
     }
 
     std::string hash, dbHash;
+    int64_t mtime = 0;
+    bool listed = false;
     if (content == CONTENT_MOVIES ||content == CONTENT_MUSICVIDEOS)
     {
       if (m_handle)
@@ -276,19 +296,33 @@ namespace VIDEO
         m_handle->SetTitle(StringUtils::Format(g_localizeStrings.Get(str).c_str(), info->Name().c_str()));
       }
 
+      bool useSnapshot = g_advancedSettings.m_bVideoLibraryUseDirectorySnapshot && !URIUtils::IsPlugin(strDirectory);
+      if (useSnapshot)
+        mtime = m_snapshot.GetModificationTime(strDirectory);
+
       std::string fastHash;
       if (g_advancedSettings.m_bVideoLibraryUseFastHash && !URIUtils::IsPlugin(strDirectory))
         fastHash = GetFastHash(strDirectory, regexps);
 
-      if (m_database.GetPathHash(strDirectory, dbHash) && !fastHash.empty() && StringUtils::EqualsNoCase(fastHash, dbHash))
+      XFILE::CDirectorySnapshot::CEntry snapshot;
+      bool haveDbHash = m_database.GetPathHash(strDirectory, dbHash);
+      if (haveDbHash && !fastHash.empty() && StringUtils::EqualsNoCase(fastHash, dbHash))
       { // fast hashes match - no need to process anything
         hash = fastHash;
       }
+      else if (haveDbHash && useSnapshot && m_snapshot.GetUnchanged(strDirectory, mtime, snapshot) &&
+               StringUtils::EqualsNoCase(snapshot.fingerprint, GetSnapshotFingerprint(dbHash, regexps)))
+      { // folder unchanged since it was last listed - only recurse into its subfolders
+        hash = dbHash;
+        for (const auto &subdir : snapshot.subdirs)
+          items.Add(CFileItemPtr(new CFileItem(subdir, true)));
+      }
       else
       { // need to fetch the folder
         CDirectory::GetDirectory(strDirectory, items, CServiceBroker::GetFileExtensionProvider().GetVideoExtensions(),
                                  DIR_FLAG_DEFAULTS);
         items.Stack();
+        listed = true;
 
         // check whether to re-use previously computed fast hash
         if (!CanFastHash(items, regexps) || fastHash.empty())
@@ -299,8 +333,10 @@ namespace VIDEO
 
       if (StringUtils::EqualsNoCase(hash, dbHash))
       { // hash matches - skipping
-        CLog::Log(LOGDEBUG, "VideoInfoScanner: Skipping dir '%s' due to no change%s", CURL::GetRedacted(strDirectory).c_str(), !fastHash.empty() ? " (fasthash)" : "");
+        CLog::Log(LOGDEBUG, "VideoInfoScanner: Skipping dir '%s' due to no change%s", CURL::GetRedacted(strDirectory).c_str(), !fastHash.empty() ? " (fasthash)" : (!listed ? " (snapshot)" : ""));
         bSkip = true;
+        if (listed && useSnapshot)
+          UpdateSnapshot(strDirectory, mtime, hash, regexps, items);
       }
       else if (hash.empty())
       { // directory empty or non-existent - add to clean list and skip
@@ -352,6 +388,8 @@ namespace VIDEO
         if (!m_bStop && (content == CONTENT_MOVIES || content == CONTENT_MUSICVIDEOS))
         {
           m_database.SetPathHash(strDirectory, hash);
+          if (mtime)
+            UpdateSnapshot(strDirectory, mtime, hash, regexps, items);
           if (m_bClean)
             m_pathsToClean.insert(m_database.GetPathId(strDirectory));
           CLog::Log(LOGDEBUG, "VideoInfoScanner: Finished adding information from dir %s", CURL::GetRedacted(strDirectory).c_str());
@@ -367,11 +405,24 @@ namespace VIDEO
     else if (!StringUtils::EqualsNoCase(hash, dbHash) && (content == CONTENT_MOVIES || content == CONTENT_MUSICVIDEOS))
     { // update the hash either way - we may have changed the hash to a fast version
       m_database.SetPathHash(strDirectory, hash);
+      if (listed && mtime)
+        UpdateSnapshot(strDirectory, mtime, hash, regexps, items);
     }
 
     if (m_handle)
       OnDirectoryScanned(strDirectory);
 
+    if (g_advancedSettings.m_bVideoLibraryUseDirectorySnapshot && settings.recurse > 0 && content != CONTENT_TVSHOWS)
+    { // stat the subfolders we're about to recurse into in one go
+      std::vector<std::string> subdirs;
+      for (const auto &item : items)
+      {
+        if (item->m_bIsFolder && !item->IsParentFolder() && !item->IsPlayList() && !item->IsPlugin())
+          subdirs.push_back(item->GetPath());
+      }
+      m_snapshot.PrefetchModificationTimes(subdirs);
+    }
+
     for (int i = 0; i < items.Size(); ++i)
     {
       CFileItemPtr pItem = items[i];
@@ -1863,50 +1914,57 @@ namespace VIDEO
     if (excludes.size())
       digest.Update(StringUtils::Join(excludes, "|"));
 
-    struct __stat64 buffer;
-    if (XFILE::CFile::Stat(directory, &buffer) == 0)
+    // may have been stat'ed already along with the rest of its level
+    int64_t time = m_snapshot.GetModificationTime(directory);
+    if (time)
     {
-      int64_t time = buffer.st_mtime;
-      if (!time)
-        time = buffer.st_ctime;
-      if (time)
-      {
-        digest.Update((unsigned char *)&time, sizeof(time));
-        return digest.Finalize();
-      }
+      digest.Update((unsigned char *)&time, sizeof(time));
+      return digest.Finalize();
     }
     return "";
   }
 
   std::string CVideoInfoScanner::GetRecursiveFastHash(const std::string &directory,
-      const std::vector<std::string> &excludes) const
+      const std::vector<std::string> &excludes)
   {
-    CFileItemList items;
-    items.Add(CFileItemPtr(new CFileItem(directory, true)));
-    CUtil::GetRecursiveDirsListing(directory, items, DIR_FLAG_NO_FILE_DIRS | DIR_FLAG_NO_FILE_INFO);
-
-    CDigest digest{CDigest::Type::MD5};
-
-    if (excludes.size())
-      digest.Update(StringUtils::Join(excludes, "|"));
-
     int64_t time = 0;
-    for (int i=0; i < items.Size(); ++i)
+    if (g_advancedSettings.m_bVideoLibraryUseDirectorySnapshot)
     {
-      int64_t stat_time = 0;
-      struct __stat64 buffer;
-      if (XFILE::CFile::Stat(items[i]->GetPath(), &buffer) == 0)
+      std::vector<std::pair<std::string, int64_t>> dirs;
+      if (!m_snapshot.GetRecursiveModificationTimes(directory, dirs))
+        return "";
+
+      for (const auto &dir : dirs)
+        time += dir.second;
+    }
+    else
+    {
+      CFileItemList items;
+      items.Add(CFileItemPtr(new CFileItem(directory, true)));
+      CUtil::GetRecursiveDirsListing(directory, items, DIR_FLAG_NO_FILE_DIRS | DIR_FLAG_NO_FILE_INFO);
+
+      for (int i=0; i < items.Size(); ++i)
       {
-        //! @todo some filesystems may return the mtime/ctime inline, in which case this is
-        //! unnecessarily expensive. Consider supporting Stat() in our directory cache?
-        stat_time = buffer.st_mtime ? buffer.st_mtime : buffer.st_ctime;
-        time += stat_time;
-      }
+        int64_t stat_time = 0;
+        struct __stat64 buffer;
+        if (XFILE::CFile::Stat(items[i]->GetPath(), &buffer) == 0)
+        {
+          //! @todo some filesystems may return the mtime/ctime inline, in which case this is
+          //! unnecessarily expensive. Consider supporting Stat() in our directory cache?
+          stat_time = buffer.st_mtime ? buffer.st_mtime : buffer.st_ctime;
+          time += stat_time;
+        }
 
-      if (!stat_time)
-        return "";
+        if (!stat_time)
+          return "";
+      }
     }
 
+    CDigest digest{CDigest::Type::MD5};
+
+    if (excludes.size())
+      digest.Update(StringUtils::Join(excludes, "|"));
+
     if (time)
     {
       digest.Update((unsigned char *)&time, sizeof(time));
@@ -1915,6 +1973,31 @@ namespace VIDEO
     return "";
   }
 
+  void CVideoInfoScanner::UpdateSnapshot(const std::string &directory, int64_t mtime, const std::string &hash,
+                                         const std::vector<std::string> &excludes, const CFileItemList &items)
+  {
+    XFILE::CDirectorySnapshot::CEntry entry;
+    entry.mtime = mtime;
+    entry.fingerprint = GetSnapshotFingerprint(hash, excludes);
+    for (const auto &item : items)
+    {
+      if (item->m_bIsFolder && !item->IsParentFolder() && !item->IsPlayList())
+        entry.subdirs.push_back(item->GetPath());
+    }
+    m_snapshot.Set(directory, std::move(entry));
+  }
+
+  std::string CVideoInfoScanner::GetSnapshotFingerprint(const std::string &hash,
+      const std::vector<std::string> &excludes)
+  {
+    if (excludes.empty())
+      return hash;
+
+    CDigest digest{CDigest::Type::MD5};
+    digest.Update(StringUtils::Join(excludes, "|"));
+    return hash + "|" + digest.Finalize();
+  }
+
   void CVideoInfoScanner::GetSeasonThumbs(const CVideoInfoTag &show,
       std::map<int, std::map<std::string, std::string>> &seasonArt, const std::vector<std::string> &artTypes, bool useLocal)
   {
@@ -15,6 +15,7 @@
 #include "InfoScanner.h"
 #include "VideoDatabase.h"
 #include "addons/Scraper.h"
+#include "filesystem/DirectorySnapshot.h"
 
 class CRegExp;
 class CFileItem;
@@ -194,11 +195,34 @@ namespace VIDEO
      and if neither are available, an empty hash is returned.
      In case exclude from scan expressions are present, the string array will be appended
      to the md5 hash to ensure we're doing a re-scan whenever the user modifies those.
+     When the directory snapshot is enabled, only folders whose modified time changed since
+     the last scan are listed to find their subfolders.
      \param directory folder to hash (recursively)
      \param excludes string array of exclude expressions
      \return the md5 hash of the folder
      */
-    std::string GetRecursiveFastHash(const std::string &directory, const std::vector<std::string> &excludes) const;
+    std::string GetRecursiveFastHash(const std::string &directory, const std::vector<std::string> &excludes);
+
+    /*! \brief Record a listed folder in the directory snapshot
+     Stores the folder's modified time at the start of its scan, its hash and its subfolders,
+     so that the next scan can skip listing the folder while its modified time is unchanged.
+     \param directory the folder
+     \param mtime modified time of the folder before it was listed
+     \param hash the hash stored for the folder in the database
+     \param excludes string array of exclude expressions the folder was listed with
+     \param items the folder listing
+     */
+    void UpdateSnapshot(const std::string &directory, int64_t mtime, const std::string &hash,
+                        const std::vector<std::string> &excludes, const CFileItemList &items);
+
+    /*! \brief Fingerprint of a folder recorded in the directory snapshot
+     Combines the folder's hash with the exclude expressions, so that changing those
+     forces the folder to be listed again.
+     \param hash the hash stored for the folder in the database
+     \param excludes string array of exclude expressions
+     \return the fingerprint
+     */
+    static std::string GetSnapshotFingerprint(const std::string &hash, const std::vector<std::string> &excludes);
 
     /*! \brief Decide whether a folder listing could use the "fast" hash
      Fast hashing can be done whenever the folder contains no scannable subfolders, as the
@@ -230,6 +254,7 @@ namespace VIDEO
     bool m_scanAll;
     std::string m_strStartDir;
     CVideoDatabase m_database;
+    XFILE::CDirectorySnapshot m_snapshot;
     std::set<std::string> m_pathsToCount;
     std::set<int> m_pathsToClean;
   };
@@ -26,11 +26,13 @@
 #include "settings/Settings.h"
 #include "cores/VideoSettings.h"
 #include "TextureCache.h"
+#include "TextureDatabase.h"
 #include "URL.h"
 #include "utils/log.h"
 #include "utils/EmbeddedArt.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
+#include "XBDateTime.h"
 #include "video/tags/VideoInfoTagLoaderFactory.h"
 #include "video/VideoDatabase.h"
 #include "video/VideoInfoTag.h"
@@ -38,6 +40,23 @@
 using namespace XFILE;
 using namespace VIDEO;
 
+namespace
+{
+// texture database path type of the thumbs that couldn't be extracted, holds the hash of the
+// video file and the time of the failure
+const std::string FAILED_EXTRACTION = "failedextraction";
+
+// failed extractions are retried after this many days, even if the video file is unchanged
+const int FAILED_EXTRACTION_RETRY_DAYS = 30;
+
+std::string GetRemoteHost(const std::string &path)
+{
+  if (!URIUtils::IsRemote(path))
+    return "";
+  return CURL(path).GetHostName();
+}
+}
+
 CThumbExtractor::CThumbExtractor(const CFileItem& item,
                                  const std::string& listpath,
                                  bool thumb,
@@ -104,9 +123,32 @@ bool CThumbExtractor::DoWork()
     // construct the thumb cache file
     CTextureDetails details;
     details.file = CTextureCache::GetCacheFile(m_target) + ".jpg";
+    bool hadStreamDetails = m_item.HasVideoInfoTag() && m_item.GetVideoInfoTag()->HasStreamDetails();
     result = CDVDFileInfo::ExtractThumb(m_item, details, m_fillStreamDetails ? &m_item.GetVideoInfoTag()->m_streamDetails : nullptr, m_pos);
-    if(result)
+    if (!result)
     {
+      // remember the failure so the unchanged file isn't opened again, not even after a restart.
+      // a file that couldn't be stat'ed has no usable hash, so it's retried next time.
+      std::string hash = CTextureCacheJob::GetImageHash(m_item.GetPath());
+      CTextureDatabase db;
+      if (!hash.empty() && hash != "BADHASH" && db.Open())
+      {
+        db.SetTextureForPath(m_target, FAILED_EXTRACTION, hash + "|" + CDateTime::GetUTCDateTime().GetAsDBDateTime());
+        db.Close();
+      }
+
+      // the stream details were read when the file was opened, store them anyway
+      result = m_fillStreamDetails && !hadStreamDetails && m_item.GetVideoInfoTag()->HasStreamDetails();
+    }
+    else
+    {
+      CTextureDatabase db;
+      if (db.Open())
+      {
+        db.ClearTextureForPath(m_target, FAILED_EXTRACTION);
+        db.Close();
+      }
+
       CTextureCache::GetInstance().AddCachedTexture(m_target, details);
       m_item.SetProperty("HasAutoThumb", true);
       m_item.SetProperty("AutoThumbImage", m_target);
@@ -172,7 +214,7 @@ bool CThumbExtractor::DoWork()
 }
 
 CVideoThumbLoader::CVideoThumbLoader() :
-  CThumbLoader(), CJobQueue(true, 1, CJob::PRIORITY_LOW_PAUSABLE)
+  CThumbLoader(), CJobQueue(true, g_advancedSettings.m_videoExtractionJobs, CJob::PRIORITY_LOW_PAUSABLE)
 {
   m_videoDatabase = new CVideoDatabase();
 }
@@ -376,6 +418,9 @@ bool CVideoThumbLoader::LoadItemLookup(CFileItem* pItem)
     if (StringUtils::StartsWith(url, "image://video@") && !CTextureCache::GetInstance().HasCachedImage(url))
       pItem->SetArt("thumb", "");
 
+    // the file failed to open last time, don't retry for the stream details either
+    bool knownFailure = false;
+
     if (!pItem->HasArt("thumb"))
     {
       // create unique thumb for auto generated thumbs
@@ -404,15 +449,21 @@ bool CVideoThumbLoader::LoadItemLookup(CFileItem* pItem)
           SetupRarOptions(item,path);
 
         CThumbExtractor* extract = new CThumbExtractor(item, path, true, thumbURL);
-        AddJob(extract);
+        if (ShouldExtractThumb(thumbURL, extract->m_item.GetPath()))
+        {
+          AddJob(extract);
 
-        m_videoDatabase->Close();
-        return true;
+          m_videoDatabase->Close();
+          return true;
+        }
+        delete extract;
+        knownFailure = true;
       }
     }
 
     // flag extraction
-    if (CServiceBroker::GetSettings().GetBool(CSettings::SETTING_MYVIDEOS_EXTRACTFLAGS) &&
+    if (!knownFailure &&
+        CServiceBroker::GetSettings().GetBool(CSettings::SETTING_MYVIDEOS_EXTRACTFLAGS) &&
        (!pItem->HasVideoInfoTag()                     ||
         !pItem->GetVideoInfoTag()->HasStreamDetails() ) )
     {
@@ -626,6 +677,37 @@ void CVideoThumbLoader::OnJobComplete(unsigned int jobID, bool success, CJob* jo
   CJobQueue::OnJobComplete(jobID, success, job);
 }
 
+bool CVideoThumbLoader::CanStartJob(const CJob *job, const std::vector<const CJob*> &processing) const
+{
+  const std::string host = GetRemoteHost(static_cast<const CThumbExtractor*>(job)->m_item.GetPath());
+  if (host.empty())
+    return true;
+
+  unsigned int hostJobs = 0;
+  for (const auto &it : processing)
+  {
+    if (GetRemoteHost(static_cast<const CThumbExtractor*>(it)->m_item.GetPath()) == host)
+      hostJobs++;
+  }
+  return hostJobs < g_advancedSettings.m_videoExtractionJobsPerHost;
+}
+
+bool CVideoThumbLoader::ShouldExtractThumb(const std::string &thumbURL, const std::string &path) const
+{
+  std::string failure = m_textureDatabase->GetTextureForPath(thumbURL, FAILED_EXTRACTION);
+  if (failure.empty())
+    return true;
+
+  size_t separator = failure.find('|');
+  if (separator == std::string::npos || failure.substr(0, separator) != CTextureCacheJob::GetImageHash(path))
+    return true;
+
+  CDateTime failed;
+  failed.SetFromDBDateTime(failure.substr(separator + 1));
+  return !failed.IsValid() ||
+         failed + CDateTimeSpan(FAILED_EXTRACTION_RETRY_DAYS, 0, 0, 0) < CDateTime::GetUTCDateTime();
+}
+
 void CVideoThumbLoader::DetectAndAddMissingItemData(CFileItem &item)
 {
   if (item.m_bIsFolder) return;
@@ -131,4 +131,17 @@ protected:
    \return void
    */
   void DetectAndAddMissingItemData(CFileItem &item);
+
+  /*! \brief Limits the number of files of one remote host that are read at once
+   \sa CJobQueue::CanStartJob
+   */
+  bool CanStartJob(const CJob *job, const std::vector<const CJob*> &processing) const override;
+
+  /*! \brief Check whether the thumb of a video file has to be extracted
+   Extractions that failed are retried once the file has changed or the failure has expired.
+   \param thumbURL the url of the thumb to extract
+   \param path the path of the video file
+   \return true if the thumb should be extracted, false otherwise
+   */
+  bool ShouldExtractThumb(const std::string &thumbURL, const std::string &path) const;
 };
@@ -25,7 +25,9 @@
 
 using namespace KODI::MESSAGING;
 
-CGraphicContext::CGraphicContext(void) = default;
+CGraphicContext::CGraphicContext(void) : CCriticalSection("CGraphicContext")
+{
+}
 CGraphicContext::~CGraphicContext(void) = default;
 
 void CGraphicContext::SetOrigin(float x, float y)
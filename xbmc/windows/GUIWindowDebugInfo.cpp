@@ -86,6 +86,13 @@ void CGUIWindowDebugInfo::Process(unsigned int currentTime, CDirtyRegionList &di
   if (!m_layout)
     return;
 
+  // percentiles don't change much from frame to frame
+  if (currentTime - m_frameStatisticsTime >= 1000)
+  {
+    m_frameStatistics = CGUIFrameStatistics::GetInstance().GetSnapshot();
+    m_frameStatisticsTime = currentTime;
+  }
+
   std::string info;
   if (LOG_LEVEL_DEBUG_FREEMEM <= g_advancedSettings.m_logLevel)
   {
@@ -112,6 +119,11 @@ void CGUIWindowDebugInfo::Process(unsigned int currentTime, CDirtyRegionList &di
                                 stat.ullAvailPhys/1024, stat.ullTotalPhys/1024, CServiceBroker::GetGUI()->GetInfoManager().GetInfoProviders().GetSystemInfoProvider().GetFPS(),
                                 strCores.c_str(), ucAppName.c_str(), dCPU, profiling.c_str());
 #endif
+    info += StringUtils::Format("\nGUI: %.1f/%.1f/%.1f ms (p50/p95/p99) - dirty %.0f%% - uploads %u (%.0f KB max, %u deferred) - font misses %u",
+                                m_frameStatistics.frameMs.p50, m_frameStatistics.frameMs.p95, m_frameStatistics.frameMs.p99,
+                                m_frameStatistics.dirtyArea.p50, m_frameStatistics.textureUploads,
+                                m_frameStatistics.textureUploadKB.max, m_frameStatistics.deferredTextureUploads,
+                                m_frameStatistics.fontCacheMisses);
   }
 
   // render the skin debug info
@@ -132,6 +144,13 @@ void CGUIWindowDebugInfo::Process(unsigned int currentTime, CDirtyRegionList &di
       else
         windowName = window->GetProperty("xmlfile").asString();
       info += "Window: " + windowName + "\n";
+      for (const auto &stats : m_frameStatistics.windows)
+      {
+        if (stats.id == window->GetID())
+          info += StringUtils::Format("Process: %.1f/%.1f ms - Render: %.1f/%.1f ms (p50/p95)\n",
+                                      stats.processMs.p50, stats.processMs.p95,
+                                      stats.renderMs.p50, stats.renderMs.p95);
+      }
       // transform the mouse coordinates to this window's coordinates
       CServiceBroker::GetWinSystem()->GetGfxContext().SetScalingResolution(window->GetCoordsRes(), true);
       point.x *= CServiceBroker::GetWinSystem()->GetGfxContext().GetGUIScaleX();
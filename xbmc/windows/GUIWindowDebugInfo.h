@@ -9,6 +9,7 @@
 #pragma once
 
 #include "guilib/GUIDialog.h"
+#include "guilib/GUIFrameStatistics.h"
 #ifdef TARGET_POSIX
 #include "platform/linux/LinuxResourceCounter.h"
 #endif
@@ -28,6 +29,8 @@ protected:
   void UpdateVisibility() override;
 private:
   CGUITextLayout *m_layout;
+  CGUIFrameStatistics::Snapshot m_frameStatistics;
+  unsigned int m_frameStatisticsTime = 0;
 #ifdef TARGET_POSIX
   CLinuxResourceCounter m_resourceCounter;
 #endif